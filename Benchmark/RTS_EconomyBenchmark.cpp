@@ -0,0 +1,361 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "RTS_EconomyBenchmark.h"
+#include "RTS_Actor.h"
+#include "RTS_ActorPool.h"
+#include "RTS_DataAsset.h"
+#include "RTS_ModuleScheduler.h"
+#include "GathererModule/GathererModule.h"
+#include "GathererModule/GatherMethod/GatherMethod_001.h"
+#include "GathererModule/GatherMethod/GatherMethod_002.h"
+#include "GathererModule/DepositMethod/InstantDeposit.h"
+#include "GathererModule/DepositMethod/NormalDeposit.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Kismet/KismetSystemLibrary.h"
+
+static FAutoConsoleCommandWithWorldAndArgs GRTSEconomyBenchmarkCommand(
+	TEXT("RTS.Economy.Benchmark"),
+	TEXT("Runs the headless gather/deposit benchmark and writes Saved/Benchmarks/EconomyBenchmark_<time>.csv. ")
+	TEXT("Usage: RTS.Economy.Benchmark Resource=<DataAssetPath> Worker=<DataAssetPath> [Gather=001|002] [Deposit=Instant|Normal] ")
+	TEXT("[Counts=100,1000,5000,10000] [WorkersPerResource=4] [Warmup=5] [Seconds=60] [Quit]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		URTS_EconomyBenchmark* Benchmark = URTS_EconomyBenchmark::Get(World);
+		if (!Benchmark)
+		{
+			return;
+		}
+
+		FRTSEconomyBenchmarkSettings Settings;
+		for (const FString& Arg : Args)
+		{
+			FString Key, Value;
+			if (!Arg.Split(TEXT("="), &Key, &Value))
+			{
+				Settings.bQuitWhenDone |= Arg.Equals(TEXT("Quit"), ESearchCase::IgnoreCase);
+				continue;
+			}
+
+			if (Key.Equals(TEXT("Resource"), ESearchCase::IgnoreCase))
+			{
+				Settings.ResourceDataAsset = LoadObject<URTS_DataAsset>(nullptr, *Value);
+			}
+			else if (Key.Equals(TEXT("Worker"), ESearchCase::IgnoreCase))
+			{
+				Settings.WorkerDataAsset = LoadObject<URTS_DataAsset>(nullptr, *Value);
+			}
+			else if (Key.Equals(TEXT("Gather"), ESearchCase::IgnoreCase))
+			{
+				Settings.GatherMethodClass = Value == TEXT("002") ? UGatherMethod_002::StaticClass() : UGatherMethod_001::StaticClass();
+			}
+			else if (Key.Equals(TEXT("Deposit"), ESearchCase::IgnoreCase))
+			{
+				Settings.DepositMethodClass = Value.Equals(TEXT("Normal"), ESearchCase::IgnoreCase) ? UNormalDeposit::StaticClass() : UInstantDeposit::StaticClass();
+			}
+			else if (Key.Equals(TEXT("Counts"), ESearchCase::IgnoreCase))
+			{
+				TArray<FString> Counts;
+				Value.ParseIntoArray(Counts, TEXT(","));
+				Settings.WorkerCounts.Reset();
+				for (const FString& Count : Counts)
+				{
+					Settings.WorkerCounts.Add(FMath::Max(1, FCString::Atoi(*Count)));
+				}
+			}
+			else if (Key.Equals(TEXT("WorkersPerResource"), ESearchCase::IgnoreCase))
+			{
+				Settings.WorkersPerResource = FMath::Max(1, FCString::Atoi(*Value));
+			}
+			else if (Key.Equals(TEXT("Warmup"), ESearchCase::IgnoreCase))
+			{
+				Settings.WarmupSeconds = FMath::Max(0.f, FCString::Atof(*Value));
+			}
+			else if (Key.Equals(TEXT("Seconds"), ESearchCase::IgnoreCase))
+			{
+				Settings.SampleSeconds = FMath::Max(1.f, FCString::Atof(*Value));
+			}
+		}
+
+		Benchmark->StartBenchmark(Settings);
+	}));
+
+URTS_EconomyBenchmark* URTS_EconomyBenchmark::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<URTS_EconomyBenchmark>() : nullptr;
+}
+
+void URTS_EconomyBenchmark::Deinitialize()
+{
+	Workers.Empty();
+	Resources.Empty();
+	Phase = EPhase::Idle;
+
+	Super::Deinitialize();
+}
+
+TStatId URTS_EconomyBenchmark::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URTS_EconomyBenchmark, STATGROUP_Tickables);
+}
+
+bool URTS_EconomyBenchmark::StartBenchmark(const FRTSEconomyBenchmarkSettings& InSettings)
+{
+	if (IsRunning())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("URTS_EconomyBenchmark::StartBenchmark - A run is already in progress"));
+		return false;
+	}
+	if (!InSettings.ResourceDataAsset || !InSettings.WorkerDataAsset || InSettings.WorkerCounts.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("URTS_EconomyBenchmark::StartBenchmark - Resource and worker data assets and at least one worker count are required"));
+		return false;
+	}
+
+	Settings = InSettings;
+	Results.Reset();
+	PassIndex = 0;
+	BeginPass();
+	return true;
+}
+
+void URTS_EconomyBenchmark::BeginPass()
+{
+	const int32 WorkerCount = Settings.WorkerCounts[PassIndex];
+	const int32 ResourceCount = FMath::Max(1, WorkerCount / Settings.WorkersPerResource);
+
+	UE_LOG(LogTemp, Log, TEXT("URTS_EconomyBenchmark - Pass %d/%d: %d workers, %d resources"), PassIndex + 1, Settings.WorkerCounts.Num(), WorkerCount, ResourceCount);
+	SpawnPopulation(WorkerCount, ResourceCount);
+
+	Phase = EPhase::Warmup;
+	PhaseStartTime = GetWorld()->GetTimeSeconds();
+}
+
+void URTS_EconomyBenchmark::SpawnPopulation(int32 WorkerCount, int32 ResourceCount)
+{
+	URTS_ActorPool* Pool = URTS_ActorPool::Get(this);
+	if (!Pool)
+	{
+		return;
+	}
+
+	// Resources on a coarse grid, each with its workers on a ring around it
+	constexpr float ResourceSpacing = 1500.f;
+	constexpr float WorkerRingRadius = 400.f;
+	const int32 RowLength = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(ResourceCount))));
+	const FVector GridOrigin(-0.5f * RowLength * ResourceSpacing, -0.5f * RowLength * ResourceSpacing, 0.f);
+
+	Resources.Reserve(ResourceCount);
+	for (int32 Index = 0; Index < ResourceCount; ++Index)
+	{
+		const FVector Location = GridOrigin + FVector((Index % RowLength) * ResourceSpacing, (Index / RowLength) * ResourceSpacing, 0.f);
+		if (ARTS_Actor* Resource = Pool->AcquireActor(nullptr, Settings.ResourceDataAsset, FTransform(Location)))
+		{
+			Resources.Add(Resource);
+		}
+	}
+
+	if (Resources.Num() == 0)
+	{
+		return;
+	}
+
+	Workers.Reserve(WorkerCount);
+	for (int32 Index = 0; Index < WorkerCount; ++Index)
+	{
+		ARTS_Actor* Resource = Resources[Index % Resources.Num()];
+		const float Angle = 2.f * PI * (Index / Resources.Num()) / FMath::Max(1, Settings.WorkersPerResource);
+		const FVector Location = Resource->GetActorLocation() + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * WorkerRingRadius + FVector(0.f, 0.f, 100.f);
+
+		ARTS_Actor* Worker = Pool->AcquireActor(nullptr, Settings.WorkerDataAsset, FTransform(Location));
+		if (!Worker)
+		{
+			continue;
+		}
+
+		// Spawned pawns are only auto possessed when their class asks for it
+		if (!Worker->GetController())
+		{
+			Worker->SpawnDefaultController();
+		}
+
+		UGathererModule* Gatherer = Worker->GetModule<UGathererModule>();
+		if (!Gatherer)
+		{
+			continue;
+		}
+
+		if (Settings.GatherMethodClass)
+		{
+			Gatherer->GatherMethod = NewObject<UGatherMethod>(Gatherer, Settings.GatherMethodClass);
+		}
+		if (Settings.DepositMethodClass)
+		{
+			Gatherer->DepositMethod = NewObject<UDepositMethod>(Gatherer, Settings.DepositMethodClass);
+		}
+
+		// Re-run initialization so the module caches the controller and binds the overridden methods
+		Gatherer->InitializeModule(Worker);
+		Gatherer->OnResourceGathered.AddDynamic(this, &URTS_EconomyBenchmark::HandleResourceGathered);
+		Gatherer->OnResourceDeposited.AddDynamic(this, &URTS_EconomyBenchmark::HandleResourceDeposited);
+		Gatherer->ExecuteGathererModule(Resource);
+
+		Workers.Add(Worker);
+	}
+}
+
+void URTS_EconomyBenchmark::DestroyPopulation()
+{
+	for (ARTS_Actor* Worker : Workers)
+	{
+		if (!IsValid(Worker))
+		{
+			continue;
+		}
+		if (UGathererModule* Gatherer = Worker->GetModule<UGathererModule>())
+		{
+			Gatherer->OnResourceGathered.RemoveAll(this);
+			Gatherer->OnResourceDeposited.RemoveAll(this);
+			Gatherer->StopGathererModule();
+		}
+		Worker->Destroy();
+	}
+
+	for (ARTS_Actor* Resource : Resources)
+	{
+		if (IsValid(Resource))
+		{
+			Resource->Destroy();
+		}
+	}
+
+	Workers.Reset();
+	Resources.Reset();
+
+	// Collecting here would run inside the world tick, the engine does it between frames instead
+	if (GEngine)
+	{
+		GEngine->ForceGarbageCollection(true);
+	}
+}
+
+void URTS_EconomyBenchmark::Tick(float DeltaTime)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	if (Phase == EPhase::Warmup)
+	{
+		if (Now - PhaseStartTime >= Settings.WarmupSeconds)
+		{
+			GameThreadMs = 0.0;
+			Callbacks = 0;
+			Gathered = 0;
+			Deposited = 0;
+			Frames = 0;
+			Phase = EPhase::Sampling;
+			PhaseStartTime = Now;
+		}
+		return;
+	}
+
+	// Game thread time and scheduler callbacks of the previous frame
+	GameThreadMs += FPlatformTime::ToMilliseconds(GGameThreadTime);
+	if (const URTS_ModuleScheduler* Scheduler = URTS_ModuleScheduler::Get(this))
+	{
+		Callbacks += Scheduler->GetFiredLastFrame();
+	}
+	Frames++;
+
+	if (Now - PhaseStartTime >= Settings.SampleSeconds)
+	{
+		EndPass();
+	}
+}
+
+void URTS_EconomyBenchmark::EndPass()
+{
+	const double SimulatedSeconds = FMath::Max(GetWorld()->GetTimeSeconds() - PhaseStartTime, UE_SMALL_NUMBER);
+
+	FRTSEconomyBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+	Result.Workers = Workers.Num();
+	Result.Resources = Resources.Num();
+	Result.Frames = Frames;
+	Result.SimulatedSeconds = SimulatedSeconds;
+	Result.GameThreadMsPerFrame = Frames > 0 ? GameThreadMs / Frames : 0.0;
+	Result.ModuleCallbacksPerSecond = Callbacks / SimulatedSeconds;
+	Result.GatheredPerMinute = Gathered * 60.0 / SimulatedSeconds;
+	Result.DepositedPerMinute = Deposited * 60.0 / SimulatedSeconds;
+	Result.PeakUsedMB = FPlatformMemory::GetStats().PeakUsedPhysical / (1024.0 * 1024.0);
+
+	UE_LOG(LogTemp, Log, TEXT("URTS_EconomyBenchmark - %d workers: %.3f ms/frame GT, %.0f callbacks/s, %.0f gathered/min, %.0f deposited/min, %.1f MB peak"),
+		Result.Workers, Result.GameThreadMsPerFrame, Result.ModuleCallbacksPerSecond, Result.GatheredPerMinute, Result.DepositedPerMinute, Result.PeakUsedMB);
+
+	DestroyPopulation();
+
+	if (++PassIndex < Settings.WorkerCounts.Num())
+	{
+		BeginPass();
+	}
+	else
+	{
+		FinishBenchmark();
+	}
+}
+
+void URTS_EconomyBenchmark::FinishBenchmark()
+{
+	Phase = EPhase::Idle;
+	WriteCsv();
+
+	if (Settings.bQuitWhenDone)
+	{
+		UKismetSystemLibrary::QuitGame(this, nullptr, EQuitPreference::Quit, false);
+	}
+}
+
+void URTS_EconomyBenchmark::WriteCsv() const
+{
+	FString Csv = TEXT("GatherMethod,DepositMethod,Workers,Resources,Frames,SimulatedSeconds,GameThreadMsPerFrame,ModuleCallbacksPerSecond,GatheredPerMinute,DepositedPerMinute,PeakUsedMB\n");
+	for (const FRTSEconomyBenchmarkResult& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("%s,%s,%d,%d,%d,%.3f,%.4f,%.1f,%.1f,%.1f,%.1f\n"),
+			*GetNameSafe(Settings.GatherMethodClass.Get()),
+			*GetNameSafe(Settings.DepositMethodClass.Get()),
+			Result.Workers, Result.Resources, Result.Frames, Result.SimulatedSeconds,
+			Result.GameThreadMsPerFrame, Result.ModuleCallbacksPerSecond,
+			Result.GatheredPerMinute, Result.DepositedPerMinute, Result.PeakUsedMB);
+	}
+
+	const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"),
+		FString::Printf(TEXT("EconomyBenchmark_%s.csv"), *FDateTime::Now().ToString()));
+	if (FFileHelper::SaveStringToFile(Csv, *FilePath))
+	{
+		UE_LOG(LogTemp, Log, TEXT("URTS_EconomyBenchmark - Results written to %s"), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("URTS_EconomyBenchmark - Could not write %s"), *FilePath);
+	}
+}
+
+void URTS_EconomyBenchmark::HandleResourceGathered(ARTS_Actor* ResourceTarget, int32 ResourceAmount)
+{
+	if (Phase == EPhase::Sampling)
+	{
+		Gathered += ResourceAmount;
+	}
+}
+
+void URTS_EconomyBenchmark::HandleResourceDeposited(EResourceType ResourceType, int32 DepositedAmount)
+{
+	if (Phase == EPhase::Sampling)
+	{
+		Deposited += DepositedAmount;
+	}
+}
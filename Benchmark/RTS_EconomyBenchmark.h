@@ -0,0 +1,168 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ResourceTypes.h"
+#include "RTS_EconomyBenchmark.generated.h"
+
+class ARTS_Actor;
+class URTS_DataAsset;
+class UGatherMethod;
+class UDepositMethod;
+
+/** Settings of one benchmark run, filled from the RTS.Economy.Benchmark arguments */
+USTRUCT(BlueprintType)
+struct FRTSEconomyBenchmarkSettings
+{
+	GENERATED_BODY()
+
+	/** Data asset of the resource actors, needs a UGatherableModule, slots come from USlotReservationService */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy Benchmark")
+	TObjectPtr<URTS_DataAsset> ResourceDataAsset = nullptr;
+
+	/** Data asset of the workers, needs a UGathererModule */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy Benchmark")
+	TObjectPtr<URTS_DataAsset> WorkerDataAsset = nullptr;
+
+	/** Overrides the gather method of every worker, e.g. UGatherMethod_001 or UGatherMethod_002. Keeps the data asset's when empty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy Benchmark")
+	TSubclassOf<UGatherMethod> GatherMethodClass;
+
+	/** Overrides the deposit method of every worker, e.g. UInstantDeposit or UNormalDeposit. Keeps the data asset's when empty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy Benchmark")
+	TSubclassOf<UDepositMethod> DepositMethodClass;
+
+	/** Worker counts, one pass each */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy Benchmark")
+	TArray<int32> WorkerCounts = { 100, 1000, 5000, 10000 };
+
+	/** Resource actors per pass are WorkerCount / WorkersPerResource */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy Benchmark", meta = (ClampMin = "1"))
+	int32 WorkersPerResource = 4;
+
+	/** World seconds simulated before sampling starts */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy Benchmark")
+	float WarmupSeconds = 5.f;
+
+	/** World seconds sampled per pass */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy Benchmark")
+	float SampleSeconds = 60.f;
+
+	/** Request engine exit once the CSV is written, for unattended -nullrhi runs */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy Benchmark")
+	bool bQuitWhenDone = false;
+};
+
+/** Measurements of one pass */
+USTRUCT(BlueprintType)
+struct FRTSEconomyBenchmarkResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Benchmark")
+	int32 Workers = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Benchmark")
+	int32 Resources = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Benchmark")
+	int32 Frames = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Benchmark")
+	double SimulatedSeconds = 0.0;
+
+	/** Average game thread time per sampled frame */
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Benchmark")
+	double GameThreadMsPerFrame = 0.0;
+
+	/** Scheduler callbacks (gather completions, deposits, progress ticks) per simulated second */
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Benchmark")
+	double ModuleCallbacksPerSecond = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Benchmark")
+	double GatheredPerMinute = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Benchmark")
+	double DepositedPerMinute = 0.0;
+
+	/** Process peak physical memory at the end of the pass */
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Benchmark")
+	double PeakUsedMB = 0.0;
+};
+
+/**
+ * Headless scale benchmark of the gather -> deposit -> gather loop.
+ * Places resources and workers on a grid around the world origin, orders every worker to gather and samples
+ * the loop for each worker count. Results are logged and written as CSV to Saved/Benchmarks.
+ *
+ * Runs without a GPU, e.g. on a map with a navmesh around the origin:
+ *   UnrealEditor <Project> <Map> -game -nullrhi -unattended -benchmark -fps=30
+ *     -ExecCmds="RTS.Economy.Benchmark Resource=<Path> Worker=<Path> Gather=001 Deposit=Instant Quit"
+ */
+UCLASS()
+class DRAKTHYSPROJECT_API URTS_EconomyBenchmark : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URTS_EconomyBenchmark* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return Phase != EPhase::Idle; }
+
+	/** Starts a run, ignored while one is in progress */
+	UFUNCTION(BlueprintCallable, Category = "Economy Benchmark")
+	bool StartBenchmark(const FRTSEconomyBenchmarkSettings& InSettings);
+
+	UFUNCTION(BlueprintPure, Category = "Economy Benchmark")
+	bool IsRunning() const { return Phase != EPhase::Idle; }
+
+	UFUNCTION(BlueprintPure, Category = "Economy Benchmark")
+	TArray<FRTSEconomyBenchmarkResult> GetResults() const { return Results; }
+
+private:
+	enum class EPhase : uint8
+	{
+		Idle,
+		Warmup,
+		Sampling
+	};
+
+	void BeginPass();
+	void EndPass();
+	void FinishBenchmark();
+	void SpawnPopulation(int32 WorkerCount, int32 ResourceCount);
+	void DestroyPopulation();
+	void WriteCsv() const;
+
+	UFUNCTION()
+	void HandleResourceGathered(ARTS_Actor* ResourceTarget, int32 ResourceAmount);
+
+	UFUNCTION()
+	void HandleResourceDeposited(EResourceType ResourceType, int32 DepositedAmount);
+
+	/** Holds the loaded data assets for the whole run */
+	UPROPERTY()
+	FRTSEconomyBenchmarkSettings Settings;
+
+	UPROPERTY()
+	TArray<TObjectPtr<ARTS_Actor>> Workers;
+
+	UPROPERTY()
+	TArray<TObjectPtr<ARTS_Actor>> Resources;
+
+	TArray<FRTSEconomyBenchmarkResult> Results;
+
+	EPhase Phase = EPhase::Idle;
+	int32 PassIndex = 0;
+	double PhaseStartTime = 0.0;
+
+	// Sampling accumulators of the current pass
+	double GameThreadMs = 0.0;
+	int64 Callbacks = 0;
+	int64 Gathered = 0;
+	int64 Deposited = 0;
+	int32 Frames = 0;
+};
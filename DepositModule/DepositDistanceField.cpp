@@ -0,0 +1,607 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "DepositDistanceField.h"
+#include "DepositModule.h"
+#include "RTS_Actor.h"
+#include "NavigationSystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+namespace DepositDistanceField
+{
+	static const int32 NeighbourOffsetX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+	static const int32 NeighbourOffsetY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+	static const float NeighbourCost[8] = { 1.f, 1.f, 1.f, 1.f, UE_SQRT_2, UE_SQRT_2, UE_SQRT_2, UE_SQRT_2 };
+
+	/** Min-heap on travel cost */
+	struct FFrontierPredicate
+	{
+		bool operator()(const TPair<float, int32>& A, const TPair<float, int32>& B) const
+		{
+			return A.Key < B.Key;
+		}
+	};
+}
+
+// Field lookups against the straight-line scan over every drop-off a worker would otherwise do
+static FAutoConsoleCommandWithWorldAndArgs GBenchmarkDepositDistanceFieldCommand(
+	TEXT("RTS.Deposit.BenchmarkField"),
+	TEXT("Times deposit lookups on the distance field against a linear scan of drop-off buildings. Usage: RTS.Deposit.BenchmarkField Team ResourceType [Queries=10000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const UDepositDistanceField* DistanceField = UDepositDistanceField::Get(World);
+		if (!DistanceField || Args.Num() < 2)
+		{
+			UE_LOG(LogTemp, Log, TEXT("RTS.Deposit.BenchmarkField - Usage: RTS.Deposit.BenchmarkField Team ResourceType [Queries=10000]"));
+			return;
+		}
+
+		const int32 Team = FCString::Atoi(*Args[0]);
+		const EResourceType ResourceType = static_cast<EResourceType>(FCString::Atoi(*Args[1]));
+		const int32 Queries = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 10000;
+
+		TArray<TPair<ARTS_Actor*, FVector>> DropOffs;
+		FBox Bounds(ForceInit);
+		for (TObjectIterator<UDepositModule> It; It; ++It)
+		{
+			if (It->GetWorld() != World || !It->Owner || It->Owner->IsInPool() || It->GetTeamIndex() != Team || !It->AcceptsResource(ResourceType))
+			{
+				continue;
+			}
+			for (const FVector& Location : It->GetDropOffLocations())
+			{
+				DropOffs.Emplace(It->Owner, Location);
+				Bounds += Location;
+			}
+		}
+
+		if (DropOffs.Num() == 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("RTS.Deposit.BenchmarkField - Team %d has no drop-off for resource type %d"), Team, static_cast<int32>(ResourceType));
+			return;
+		}
+
+		FRandomStream Random(1234);
+		TArray<FVector> Origins;
+		Origins.Reserve(Queries);
+		for (int32 Query = 0; Query < Queries; ++Query)
+		{
+			Origins.Add(Random.RandPointInBox(Bounds.ExpandBy(5000.f)));
+		}
+
+		int32 FieldFound = 0;
+		const double FieldStart = FPlatformTime::Seconds();
+		for (const FVector& Origin : Origins)
+		{
+			FVector Location;
+			float TravelCost;
+			ARTS_Actor* Building;
+			FieldFound += DistanceField->FindBestDeposit(Team, ResourceType, Origin, Location, TravelCost, Building) ? 1 : 0;
+		}
+		const double FieldSeconds = FPlatformTime::Seconds() - FieldStart;
+
+		int32 ScanFound = 0;
+		const double ScanStart = FPlatformTime::Seconds();
+		for (const FVector& Origin : Origins)
+		{
+			float BestDistanceSquared = MAX_flt;
+			for (const TPair<ARTS_Actor*, FVector>& DropOff : DropOffs)
+			{
+				BestDistanceSquared = FMath::Min(BestDistanceSquared, static_cast<float>(FVector::DistSquared2D(DropOff.Value, Origin)));
+			}
+			ScanFound += BestDistanceSquared < MAX_flt ? 1 : 0;
+		}
+		const double ScanSeconds = FPlatformTime::Seconds() - ScanStart;
+
+		UE_LOG(LogTemp, Log, TEXT("RTS.Deposit.BenchmarkField - %d queries over %d drop-off points"), Queries, DropOffs.Num());
+		UE_LOG(LogTemp, Log, TEXT("  Distance field : %.2f ns/query (%d found)"), FieldSeconds * 1e9 / Queries, FieldFound);
+		UE_LOG(LogTemp, Log, TEXT("  Linear scan    : %.2f ns/query (%d found, straight line only)"), ScanSeconds * 1e9 / Queries, ScanFound);
+	}));
+
+UDepositDistanceField* UDepositDistanceField::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UDepositDistanceField>() : nullptr;
+}
+
+void UDepositDistanceField::Deinitialize()
+{
+	Fields.Empty();
+	Registrations.Empty();
+	RegisteredModules.Empty();
+	Passable.Empty();
+	bGridReady = false;
+	SampleCursor = INDEX_NONE;
+
+	if (UNavigationSystemV1* NavSystem = bBoundToNavigation ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()) : nullptr)
+	{
+		NavSystem->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &UDepositDistanceField::HandleNavigationGenerationFinished);
+	}
+	bBoundToNavigation = false;
+
+	Super::Deinitialize();
+}
+
+TStatId UDepositDistanceField::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDepositDistanceField, STATGROUP_Tickables);
+}
+
+uint32 UDepositDistanceField::MakeFieldKey(int32 Team, EResourceType ResourceType)
+{
+	return (static_cast<uint32>(Team) << 8) | static_cast<uint32>(ResourceType);
+}
+
+bool UDepositDistanceField::EnsureGrid(const FVector& Hint)
+{
+	if (bGridReady)
+	{
+		return true;
+	}
+
+	BindNavigationEvents();
+
+	const FBox Bounds = ComputeGridBounds(Hint);
+	const FVector Size = Bounds.GetSize();
+	GridCellSize = FMath::Max(CellSize, 1.f);
+	const double CellCount = (Size.X / GridCellSize) * (Size.Y / GridCellSize);
+	if (CellCount > MaxCells)
+	{
+		GridCellSize *= FMath::Sqrt(CellCount / MaxCells);
+	}
+
+	GridBounds = Bounds;
+	GridOrigin = FVector2D(Bounds.Min.X, Bounds.Min.Y);
+	GridSizeX = FMath::Max(1, FMath::CeilToInt(Size.X / GridCellSize));
+	GridSizeY = FMath::Max(1, FMath::CeilToInt(Size.Y / GridCellSize));
+
+	// Everything is passable until sampled, fields are usable right away and re-seeded once the real data is in
+	Passable.Init(true, GridSizeX * GridSizeY);
+	StartSampling();
+
+	bGridReady = true;
+	return true;
+}
+
+FBox UDepositDistanceField::ComputeGridBounds(const FVector& Hint) const
+{
+	FBox Bounds = FieldBounds;
+	if (!Bounds.IsValid)
+	{
+		if (const UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+		{
+			Bounds = NavSystem->GetNavigableWorldBounds();
+		}
+	}
+	if (!Bounds.IsValid)
+	{
+		// No navmesh yet, cover a generous area around the first building
+		Bounds = FBox::BuildAABB(Hint, FVector(50000.f, 50000.f, 5000.f));
+	}
+	return Bounds;
+}
+
+void UDepositDistanceField::StartSampling()
+{
+	const UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	bGridFromNavigation = FieldBounds.IsValid || (NavSystem && NavSystem->GetNavigableWorldBounds().IsValid);
+
+	// Without nav data there is nothing to sample, HandleNavigationGenerationFinished starts over once it exists
+	SampleCursor = NavSystem && NavSystem->GetDefaultNavDataInstance() ? 0 : INDEX_NONE;
+	bPassabilityChanged = false;
+}
+
+void UDepositDistanceField::Tick(float DeltaTime)
+{
+	if (SampleCursor == INDEX_NONE)
+	{
+		return;
+	}
+
+	UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSystem || !NavSystem->GetDefaultNavDataInstance())
+	{
+		SampleCursor = INDEX_NONE;
+		return;
+	}
+
+	// Cells off the navmesh block propagation
+	const float HalfHeight = FMath::Max(GridBounds.GetSize().Z * 0.5f, 500.f);
+	const FVector ProjectExtent(GridCellSize * 0.5f, GridCellSize * 0.5f, HalfHeight);
+	const float CenterZ = GridBounds.GetCenter().Z;
+
+	const int32 NumCells = Passable.Num();
+	const int32 SliceEnd = FMath::Min(NumCells, SampleCursor + FMath::Max(1, SamplesPerTick));
+	for (int32 CellIndex = SampleCursor; CellIndex < SliceEnd; ++CellIndex)
+	{
+		FNavLocation Projected;
+		const FVector Center = GetCellCenter(CellIndex) + FVector(0.f, 0.f, CenterZ);
+		const bool bPassable = NavSystem->ProjectPointToNavigation(Center, Projected, ProjectExtent);
+		if (Passable[CellIndex] != bPassable)
+		{
+			Passable[CellIndex] = bPassable;
+			bPassabilityChanged = true;
+		}
+	}
+
+	SampleCursor = SliceEnd < NumCells ? SliceEnd : INDEX_NONE;
+	if (SampleCursor == INDEX_NONE && bPassabilityChanged)
+	{
+		RepropagateFields();
+		bPassabilityChanged = false;
+	}
+}
+
+void UDepositDistanceField::RepropagateFields()
+{
+	const int32 NumCells = GridSizeX * GridSizeY;
+	for (TPair<uint32, FField>& Pair : Fields)
+	{
+		FField& Field = Pair.Value;
+		Field.Distance.Init(MAX_flt, NumCells);
+		Field.Nearest.Init(INDEX_NONE, NumCells);
+		for (FDropOff& DropOff : Field.DropOffs)
+		{
+			DropOff.OwnedCells.Reset();
+			DropOff.StaleCells = 0;
+		}
+
+		TArray<TPair<float, int32>> Frontier;
+		for (int32 DropOffIndex = 0; DropOffIndex < Field.DropOffs.Num(); ++DropOffIndex)
+		{
+			const FDropOff& DropOff = Field.DropOffs[DropOffIndex];
+			if (DropOff.Cell != INDEX_NONE && Field.Nearest[DropOff.Cell] == INDEX_NONE)
+			{
+				AssignCell(Field, DropOff.Cell, 0.f, DropOffIndex);
+				Frontier.HeapPush(TPair<float, int32>(0.f, DropOff.Cell), DepositDistanceField::FFrontierPredicate());
+			}
+		}
+		Propagate(Field, Frontier);
+	}
+}
+
+void UDepositDistanceField::BindNavigationEvents()
+{
+	if (bBoundToNavigation)
+	{
+		return;
+	}
+
+	if (UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSystem->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UDepositDistanceField::HandleNavigationGenerationFinished);
+		bBoundToNavigation = true;
+	}
+}
+
+void UDepositDistanceField::HandleNavigationGenerationFinished(ANavigationData* NavData)
+{
+	if (!bGridReady)
+	{
+		return;
+	}
+
+	// The grid was laid over the fallback box or the navigable area grew, lay it out again
+	const FBox Bounds = ComputeGridBounds(GridBounds.GetCenter());
+	if (!bGridFromNavigation || !GridBounds.IsInsideOrOn(Bounds.Min) || !GridBounds.IsInsideOrOn(Bounds.Max))
+	{
+		RebuildAll();
+		return;
+	}
+
+	// Same layout, tiles changed somewhere inside it
+	StartSampling();
+}
+
+int32 UDepositDistanceField::GetCellIndex(const FVector& Location) const
+{
+	const int32 X = FMath::Clamp(FMath::FloorToInt((Location.X - GridOrigin.X) / GridCellSize), 0, GridSizeX - 1);
+	const int32 Y = FMath::Clamp(FMath::FloorToInt((Location.Y - GridOrigin.Y) / GridCellSize), 0, GridSizeY - 1);
+	return Y * GridSizeX + X;
+}
+
+FVector UDepositDistanceField::GetCellCenter(int32 CellIndex) const
+{
+	const int32 X = CellIndex % GridSizeX;
+	const int32 Y = CellIndex / GridSizeX;
+	return FVector(GridOrigin.X + (X + 0.5f) * GridCellSize, GridOrigin.Y + (Y + 0.5f) * GridCellSize, 0.f);
+}
+
+UDepositDistanceField::FField& UDepositDistanceField::FindOrAddField(uint32 FieldKey)
+{
+	if (FField* Existing = Fields.Find(FieldKey))
+	{
+		return *Existing;
+	}
+
+	FField& Field = Fields.Add(FieldKey);
+	Field.Distance.Init(MAX_flt, GridSizeX * GridSizeY);
+	Field.Nearest.Init(INDEX_NONE, GridSizeX * GridSizeY);
+	return Field;
+}
+
+void UDepositDistanceField::RegisterDeposit(const UDepositModule* DepositModule)
+{
+	ARTS_Actor* Building = DepositModule ? DepositModule->Owner : nullptr;
+	if (!Building)
+	{
+		return;
+	}
+
+	// Re-registering replaces the old drop-offs, e.g. after a team change
+	UnregisterDeposit(Building);
+
+	const TArray<FVector> Locations = DepositModule->GetDropOffLocations();
+	if (Locations.Num() == 0 || !EnsureGrid(Locations[0]))
+	{
+		return;
+	}
+
+	const int32 Team = DepositModule->GetTeamIndex();
+	TArray<TPair<uint32, TArray<int32>>>& Entries = Registrations.Add(Building);
+	RegisteredModules.Add(Building, DepositModule);
+
+	const UEnum* ResourceEnum = StaticEnum<EResourceType>();
+	const int32 NumResourceTypes = ResourceEnum ? ResourceEnum->NumEnums() - 1 : 0;
+	for (int32 TypeIndex = 0; TypeIndex < NumResourceTypes; ++TypeIndex)
+	{
+		const EResourceType ResourceType = static_cast<EResourceType>(ResourceEnum->GetValueByIndex(TypeIndex));
+		if (!DepositModule->AcceptsResource(ResourceType))
+		{
+			continue;
+		}
+
+		const uint32 FieldKey = MakeFieldKey(Team, ResourceType);
+		FField& Field = FindOrAddField(FieldKey);
+
+		TPair<uint32, TArray<int32>>& Entry = Entries.Emplace_GetRef(FieldKey, TArray<int32>());
+		for (const FVector& Location : Locations)
+		{
+			FDropOff DropOff;
+			DropOff.Building = Building;
+			DropOff.Location = Location;
+			DropOff.Cell = GetCellIndex(Location);
+			AddDropOff(Field, DropOff, Entry.Value);
+		}
+	}
+}
+
+void UDepositDistanceField::UnregisterDeposit(ARTS_Actor* Building)
+{
+	TArray<TPair<uint32, TArray<int32>>> Entries;
+	if (!Building || !Registrations.RemoveAndCopyValue(Building, Entries))
+	{
+		return;
+	}
+	RegisteredModules.Remove(Building);
+
+	for (const TPair<uint32, TArray<int32>>& Entry : Entries)
+	{
+		if (FField* Field = Fields.Find(Entry.Key))
+		{
+			RemoveDropOffs(*Field, Entry.Value);
+		}
+	}
+}
+
+void UDepositDistanceField::AddDropOff(FField& Field, const FDropOff& DropOff, TArray<int32>& OutIndices)
+{
+	int32 DropOffIndex;
+	if (Field.FreeDropOffs.Num() > 0)
+	{
+		DropOffIndex = Field.FreeDropOffs.Pop(EAllowShrinking::No);
+		Field.DropOffs[DropOffIndex] = DropOff;
+	}
+	else
+	{
+		DropOffIndex = Field.DropOffs.Add(DropOff);
+	}
+	OutIndices.Add(DropOffIndex);
+
+	// Only the cells the new point is closer to get touched
+	if (Field.Distance[DropOff.Cell] > 0.f)
+	{
+		AssignCell(Field, DropOff.Cell, 0.f, DropOffIndex);
+
+		TArray<TPair<float, int32>> Frontier;
+		Frontier.HeapPush(TPair<float, int32>(0.f, DropOff.Cell), DepositDistanceField::FFrontierPredicate());
+		Propagate(Field, Frontier);
+	}
+}
+
+void UDepositDistanceField::RemoveDropOffs(FField& Field, const TArray<int32>& DropOffIndices)
+{
+	if (DropOffIndices.Num() == 0)
+	{
+		return;
+	}
+
+	// Clear the region the removed points owned, everything else keeps its distance
+	TArray<int32> Invalidated;
+	for (const int32 DropOffIndex : DropOffIndices)
+	{
+		for (const int32 CellIndex : Field.DropOffs[DropOffIndex].OwnedCells)
+		{
+			if (Field.Nearest[CellIndex] == DropOffIndex)
+			{
+				Field.Distance[CellIndex] = MAX_flt;
+				Field.Nearest[CellIndex] = INDEX_NONE;
+				Invalidated.Add(CellIndex);
+			}
+		}
+		Field.DropOffs[DropOffIndex] = FDropOff();
+		Field.FreeDropOffs.Add(DropOffIndex);
+	}
+
+	// Re-seed from the still valid cells bordering the cleared region, plus any remaining point inside it
+	TArray<TPair<float, int32>> Frontier;
+	for (const int32 CellIndex : Invalidated)
+	{
+		const int32 X = CellIndex % GridSizeX;
+		const int32 Y = CellIndex / GridSizeX;
+		for (int32 Direction = 0; Direction < 8; ++Direction)
+		{
+			const int32 NX = X + DepositDistanceField::NeighbourOffsetX[Direction];
+			const int32 NY = Y + DepositDistanceField::NeighbourOffsetY[Direction];
+			if (NX < 0 || NY < 0 || NX >= GridSizeX || NY >= GridSizeY)
+			{
+				continue;
+			}
+			const int32 NeighbourIndex = NY * GridSizeX + NX;
+			if (Field.Nearest[NeighbourIndex] != INDEX_NONE)
+			{
+				Frontier.HeapPush(TPair<float, int32>(Field.Distance[NeighbourIndex], NeighbourIndex), DepositDistanceField::FFrontierPredicate());
+			}
+		}
+	}
+
+	for (int32 DropOffIndex = 0; DropOffIndex < Field.DropOffs.Num(); ++DropOffIndex)
+	{
+		const FDropOff& DropOff = Field.DropOffs[DropOffIndex];
+		if (DropOff.Cell != INDEX_NONE && Field.Nearest[DropOff.Cell] == INDEX_NONE)
+		{
+			AssignCell(Field, DropOff.Cell, 0.f, DropOffIndex);
+			Frontier.HeapPush(TPair<float, int32>(0.f, DropOff.Cell), DepositDistanceField::FFrontierPredicate());
+		}
+	}
+
+	Propagate(Field, Frontier);
+}
+
+void UDepositDistanceField::AssignCell(FField& Field, int32 CellIndex, float Distance, int32 DropOffIndex)
+{
+	Field.Distance[CellIndex] = Distance;
+
+	const int32 Previous = Field.Nearest[CellIndex];
+	if (Previous == DropOffIndex)
+	{
+		return;
+	}
+	Field.Nearest[CellIndex] = DropOffIndex;
+	Field.DropOffs[DropOffIndex].OwnedCells.Add(CellIndex);
+
+	if (Previous == INDEX_NONE)
+	{
+		return;
+	}
+
+	// The previous owner's list now holds a stale entry, drop those once they make up half of it
+	FDropOff& PreviousDropOff = Field.DropOffs[Previous];
+	if (++PreviousDropOff.StaleCells * 2 > PreviousDropOff.OwnedCells.Num())
+	{
+		PreviousDropOff.OwnedCells.RemoveAllSwap([&Field, Previous](int32 OwnedCell) { return Field.Nearest[OwnedCell] != Previous; }, EAllowShrinking::No);
+		PreviousDropOff.StaleCells = 0;
+	}
+}
+
+void UDepositDistanceField::Propagate(FField& Field, TArray<TPair<float, int32>>& Frontier) const
+{
+	while (Frontier.Num() > 0)
+	{
+		TPair<float, int32> Current;
+		Frontier.HeapPop(Current, DepositDistanceField::FFrontierPredicate(), EAllowShrinking::No);
+
+		const int32 CellIndex = Current.Value;
+		if (Current.Key > Field.Distance[CellIndex])
+		{
+			// Stale entry, the cell was lowered again after this was pushed
+			continue;
+		}
+
+		const int32 X = CellIndex % GridSizeX;
+		const int32 Y = CellIndex / GridSizeX;
+		for (int32 Direction = 0; Direction < 8; ++Direction)
+		{
+			const int32 NX = X + DepositDistanceField::NeighbourOffsetX[Direction];
+			const int32 NY = Y + DepositDistanceField::NeighbourOffsetY[Direction];
+			if (NX < 0 || NY < 0 || NX >= GridSizeX || NY >= GridSizeY)
+			{
+				continue;
+			}
+
+			const int32 NeighbourIndex = NY * GridSizeX + NX;
+			if (!Passable[NeighbourIndex])
+			{
+				continue;
+			}
+
+			// No corner cutting past blocked cells on diagonals
+			if (Direction >= 4 && (!Passable[Y * GridSizeX + NX] || !Passable[NY * GridSizeX + X]))
+			{
+				continue;
+			}
+
+			const float NewDistance = Current.Key + DepositDistanceField::NeighbourCost[Direction] * GridCellSize;
+			if (NewDistance < Field.Distance[NeighbourIndex])
+			{
+				AssignCell(Field, NeighbourIndex, NewDistance, Field.Nearest[CellIndex]);
+				Frontier.HeapPush(TPair<float, int32>(NewDistance, NeighbourIndex), DepositDistanceField::FFrontierPredicate());
+			}
+		}
+	}
+}
+
+bool UDepositDistanceField::FindBestDeposit(int32 Team, EResourceType ResourceType, const FVector& From, FVector& OutLocation, float& OutTravelCost, ARTS_Actor*& OutBuilding) const
+{
+	OutBuilding = nullptr;
+	OutTravelCost = MAX_flt;
+
+	const FField* Field = bGridReady ? Fields.Find(MakeFieldKey(Team, ResourceType)) : nullptr;
+	if (!Field)
+	{
+		return false;
+	}
+
+	const int32 CellIndex = GetCellIndex(From);
+	const int32 Nearest = Field->Nearest[CellIndex];
+	if (Nearest != INDEX_NONE && Field->DropOffs[Nearest].Building.IsValid())
+	{
+		const FDropOff& DropOff = Field->DropOffs[Nearest];
+		OutLocation = DropOff.Location;
+		OutTravelCost = Field->Distance[CellIndex];
+		OutBuilding = DropOff.Building.Get();
+		return true;
+	}
+
+	// Worker stands in a cell the field does not reach (off the navmesh or walled in), straight line over the points
+	for (const FDropOff& DropOff : Field->DropOffs)
+	{
+		if (!DropOff.Building.IsValid())
+		{
+			continue;
+		}
+		const float Distance = FVector::Dist2D(DropOff.Location, From);
+		if (Distance < OutTravelCost)
+		{
+			OutLocation = DropOff.Location;
+			OutTravelCost = Distance;
+			OutBuilding = DropOff.Building.Get();
+		}
+	}
+	return OutBuilding != nullptr;
+}
+
+void UDepositDistanceField::RebuildAll()
+{
+	TArray<const UDepositModule*> Modules;
+	for (const TPair<TObjectKey<ARTS_Actor>, TWeakObjectPtr<const UDepositModule>>& Pair : RegisteredModules)
+	{
+		if (const UDepositModule* Module = Pair.Value.Get())
+		{
+			Modules.Add(Module);
+		}
+	}
+
+	Fields.Empty();
+	Registrations.Empty();
+	RegisteredModules.Empty();
+	Passable.Empty();
+	bGridReady = false;
+	SampleCursor = INDEX_NONE;
+
+	for (const UDepositModule* Module : Modules)
+	{
+		RegisterDeposit(Module);
+	}
+}
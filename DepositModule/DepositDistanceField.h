@@ -0,0 +1,131 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ResourceType.h"
+#include "UObject/ObjectKey.h"
+#include "DepositDistanceField.generated.h"
+
+class ARTS_Actor;
+class UDepositModule;
+class ANavigationData;
+
+/**
+ * Per team and resource type distance transform over a 2D grid of the navigable area.
+ * Every cell stores the travel cost to the closest drop-off point and which point that is, so a worker finds its
+ * deposit target with one cell lookup. Fields are seeded from UDepositModule buildings and updated incrementally:
+ * a new building only relaxes the cells it improves, a removed one only recomputes the cells it owned, tracked per point so removal never scans the grid.
+ * Passability is sampled from the navmesh a slice per frame, until then every cell counts as passable.
+ */
+UCLASS()
+class FINALRTS_API UDepositDistanceField : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UDepositDistanceField* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return SampleCursor != INDEX_NONE; }
+
+	/** Adds or re-seeds the drop-off points of the module's owner in every field it accepts resources for */
+	void RegisterDeposit(const UDepositModule* DepositModule);
+	void UnregisterDeposit(ARTS_Actor* Building);
+
+	/**
+	 * Closest drop-off for a worker of Team at From carrying ResourceType.
+	 * OutTravelCost approximates the path length along passable cells. Returns false when the team has no drop-off for the type
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Deposit Distance Field")
+	bool FindBestDeposit(int32 Team, EResourceType ResourceType, const FVector& From, FVector& OutLocation, float& OutTravelCost, ARTS_Actor*& OutBuilding) const;
+
+	/** Lays the grid out again, re-samples passability over the next frames and rebuilds every field */
+	UFUNCTION(BlueprintCallable, Category = "Deposit Distance Field")
+	void RebuildAll();
+
+	/** Area covered by the fields. Navigable world bounds are used when left invalid */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deposit Distance Field")
+	FBox FieldBounds = FBox(ForceInit);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deposit Distance Field")
+	float CellSize = 200.f;
+
+	/** Upper bound of cells per field, the cell size grows on very large maps to stay under it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deposit Distance Field")
+	int32 MaxCells = 512 * 512;
+
+	/** Navmesh projections per frame while passability is sampled */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deposit Distance Field")
+	int32 SamplesPerTick = 2048;
+
+private:
+	struct FDropOff
+	{
+		TWeakObjectPtr<ARTS_Actor> Building;
+		FVector Location = FVector::ZeroVector;
+		int32 Cell = INDEX_NONE;
+
+		/** Cells this point was made nearest of. Entries another point took over since are stale and skipped */
+		TArray<int32> OwnedCells;
+		int32 StaleCells = 0;
+	};
+
+	struct FField
+	{
+		TArray<float> Distance;
+		TArray<int32> Nearest;
+		TArray<FDropOff> DropOffs;
+		TArray<int32> FreeDropOffs;
+	};
+
+	static uint32 MakeFieldKey(int32 Team, EResourceType ResourceType);
+
+	bool EnsureGrid(const FVector& Hint);
+	FBox ComputeGridBounds(const FVector& Hint) const;
+	void StartSampling();
+
+	/** Re-seeds every field from its drop-offs, used once passability changed under them */
+	void RepropagateFields();
+
+	void BindNavigationEvents();
+
+	UFUNCTION()
+	void HandleNavigationGenerationFinished(ANavigationData* NavData);
+	int32 GetCellIndex(const FVector& Location) const;
+	FVector GetCellCenter(int32 CellIndex) const;
+	FField& FindOrAddField(uint32 FieldKey);
+	void AddDropOff(FField& Field, const FDropOff& DropOff, TArray<int32>& OutIndices);
+	void RemoveDropOffs(FField& Field, const TArray<int32>& DropOffIndices);
+
+	/** Makes DropOffIndex the nearest point of the cell and keeps the owned cell lists in step */
+	static void AssignCell(FField& Field, int32 CellIndex, float Distance, int32 DropOffIndex);
+
+	/** Dijkstra from the cells in Frontier, only lowering distances */
+	void Propagate(FField& Field, TArray<TPair<float, int32>>& Frontier) const;
+
+	bool bGridReady = false;
+	FVector2D GridOrigin = FVector2D::ZeroVector;
+	float GridCellSize = 200.f;
+	int32 GridSizeX = 0;
+	int32 GridSizeY = 0;
+	TBitArray<> Passable;
+
+	/** Bounds the grid was laid out over, false while they came from the fallback box */
+	FBox GridBounds = FBox(ForceInit);
+	bool bGridFromNavigation = false;
+
+	/** Next cell to sample, INDEX_NONE when sampling is done */
+	int32 SampleCursor = INDEX_NONE;
+	bool bPassabilityChanged = false;
+	bool bBoundToNavigation = false;
+
+	TMap<uint32, FField> Fields;
+
+	/** Field key and drop-off indices per registered building */
+	TMap<TObjectKey<ARTS_Actor>, TArray<TPair<uint32, TArray<int32>>>> Registrations;
+
+	/** Buildings kept for RebuildAll */
+	TMap<TObjectKey<ARTS_Actor>, TWeakObjectPtr<const UDepositModule>> RegisteredModules;
+};
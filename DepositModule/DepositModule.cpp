@@ -0,0 +1,91 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "DepositModule.h"
+#include "DepositDistanceField.h"
+#include "DepositPointIndex.h"
+#include "RTS_Actor.h"
+#include "TeamComponent/TeamComponent.h"
+
+void UDepositModule::InitializeModule_Implementation(ARTS_Actor* InOwner)
+{
+	Super::InitializeModule_Implementation(InOwner);
+
+	if (Owner)
+	{
+		Owner->OnDestroyed.AddUniqueDynamic(this, &UDepositModule::HandleOwnerDestroyed);
+	}
+	RefreshRegistration();
+}
+
+void UDepositModule::ResetModule_Implementation()
+{
+	Super::ResetModule_Implementation();
+
+	// Parked buildings stop being drop-offs, reactivated ones register at their new place
+	RefreshRegistration();
+}
+
+bool UDepositModule::AcceptsResource(EResourceType ResourceType) const
+{
+	return AcceptedResources.Num() == 0 || AcceptedResources.Contains(ResourceType);
+}
+
+TArray<FVector> UDepositModule::GetDropOffLocations() const
+{
+	TArray<FVector> Locations;
+	if (!Owner)
+	{
+		return Locations;
+	}
+
+	if (DropOffPoints.Num() == 0)
+	{
+		Locations.Add(Owner->GetActorLocation());
+		return Locations;
+	}
+
+	const FTransform& OwnerTransform = Owner->GetActorTransform();
+	for (const FVector& Point : DropOffPoints)
+	{
+		Locations.Add(OwnerTransform.TransformPosition(Point));
+	}
+	return Locations;
+}
+
+int32 UDepositModule::GetTeamIndex() const
+{
+	const UTeamComponent* TeamComponent = Owner ? Owner->FindComponentByClass<UTeamComponent>() : nullptr;
+	return TeamComponent ? TeamComponent->GetTeamIndex() : 0;
+}
+
+void UDepositModule::RefreshRegistration()
+{
+	if (!Owner)
+	{
+		return;
+	}
+
+	UDepositDistanceField* DistanceField = UDepositDistanceField::Get(Owner);
+	UDepositPointIndex* PointIndex = UDepositPointIndex::Get(Owner);
+	if (Owner->IsInPool())
+	{
+		if (DistanceField) DistanceField->UnregisterDeposit(Owner);
+		if (PointIndex) PointIndex->UnregisterDeposit(Owner);
+	}
+	else
+	{
+		if (DistanceField) DistanceField->RegisterDeposit(this);
+		if (PointIndex) PointIndex->RegisterDeposit(this);
+	}
+}
+
+void UDepositModule::HandleOwnerDestroyed(AActor* DestroyedActor)
+{
+	if (UDepositDistanceField* DistanceField = UDepositDistanceField::Get(DestroyedActor))
+	{
+		DistanceField->UnregisterDeposit(Cast<ARTS_Actor>(DestroyedActor));
+	}
+	if (UDepositPointIndex* PointIndex = UDepositPointIndex::Get(DestroyedActor))
+	{
+		PointIndex->UnregisterDeposit(Cast<ARTS_Actor>(DestroyedActor));
+	}
+}
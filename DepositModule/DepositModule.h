@@ -0,0 +1,48 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "RTS_Module.h"
+#include "ResourceType.h"
+#include "DepositModule.generated.h"
+
+/**
+ * Marks an actor as a drop-off building for gatherers.
+ * Registers the building with UDepositDistanceField and UDepositPointIndex for the owner's team while the actor is active.
+ */
+UCLASS(Blueprintable, EditInlineNew)
+class FINALRTS_API UDepositModule : public URTS_Module
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitializeModule_Implementation(ARTS_Actor* InOwner) override;
+	virtual void ResetModule_Implementation() override;
+	virtual bool SupportsSharedArchetype() const override { return true; }
+
+	/** Resource types this building takes, empty means every type */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deposit Module")
+	TArray<EResourceType> AcceptedResources;
+
+	/** Drop-off points relative to the actor, e.g. doors. The actor origin is used when empty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deposit Module")
+	TArray<FVector> DropOffPoints;
+
+	UFUNCTION(BlueprintPure, Category = "Deposit Module")
+	bool AcceptsResource(EResourceType ResourceType) const;
+
+	/** Drop-off points in world space */
+	UFUNCTION(BlueprintPure, Category = "Deposit Module")
+	TArray<FVector> GetDropOffLocations() const;
+
+	/** Team of the owner from its UTeamComponent, 0 (neutral) without one */
+	UFUNCTION(BlueprintPure, Category = "Deposit Module")
+	int32 GetTeamIndex() const;
+
+	/** Re-registers with the deposit field and point index, call after the owner changed team or moved */
+	UFUNCTION(BlueprintCallable, Category = "Deposit Module")
+	void RefreshRegistration();
+
+private:
+	UFUNCTION()
+	void HandleOwnerDestroyed(AActor* DestroyedActor);
+};
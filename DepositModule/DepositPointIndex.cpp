@@ -0,0 +1,421 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "DepositPointIndex.h"
+#include "DepositDistanceField.h"
+#include "DepositModule.h"
+#include "RTS_Actor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld GDumpDepositPointIndexCommand(
+	TEXT("RTS.Deposit.DumpPoints"),
+	TEXT("Logs every drop-off point with its inbound workers and queue estimate, plus the assignment counters."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UDepositPointIndex* PointIndex = UDepositPointIndex::Get(World))
+		{
+			PointIndex->DumpIndex();
+		}
+	}));
+
+UDepositPointIndex* UDepositPointIndex::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UDepositPointIndex>() : nullptr;
+}
+
+void UDepositPointIndex::Deinitialize()
+{
+	Sets.Empty();
+	Registrations.Empty();
+	Assignments.Empty();
+	Stats = FDepositPointIndexStats();
+
+	Super::Deinitialize();
+}
+
+uint32 UDepositPointIndex::MakeSetKey(int32 Team, EResourceType ResourceType)
+{
+	return (static_cast<uint32>(Team) << 8) | static_cast<uint32>(ResourceType);
+}
+
+void UDepositPointIndex::RegisterDeposit(const UDepositModule* DepositModule)
+{
+	ARTS_Actor* Building = DepositModule ? DepositModule->Owner : nullptr;
+	if (!Building)
+	{
+		return;
+	}
+
+	// Re-registering replaces the old points, e.g. after a team change
+	UnregisterDeposit(Building);
+
+	const TArray<FVector> Locations = DepositModule->GetDropOffLocations();
+	if (Locations.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 Team = DepositModule->GetTeamIndex();
+	TArray<uint32>& SetKeys = Registrations.Add(Building);
+
+	const UEnum* ResourceEnum = StaticEnum<EResourceType>();
+	const int32 NumResourceTypes = ResourceEnum ? ResourceEnum->NumEnums() - 1 : 0;
+	for (int32 TypeIndex = 0; TypeIndex < NumResourceTypes; ++TypeIndex)
+	{
+		const EResourceType ResourceType = static_cast<EResourceType>(ResourceEnum->GetValueByIndex(TypeIndex));
+		if (!DepositModule->AcceptsResource(ResourceType))
+		{
+			continue;
+		}
+
+		const uint32 SetKey = MakeSetKey(Team, ResourceType);
+		FPointSet& Set = Sets.FindOrAdd(SetKey);
+		Set.Version++;
+		SetKeys.Add(SetKey);
+
+		TArray<int32>& BuildingPoints = Set.BuildingPoints.Add(Building);
+		for (const FVector& Location : Locations)
+		{
+			const int32 PointIndex = Set.FreePoints.Num() > 0 ? Set.FreePoints.Pop(EAllowShrinking::No) : Set.Points.AddDefaulted();
+			FPoint& Point = Set.Points[PointIndex];
+			Point.Building = Building;
+			Point.Location = Location;
+			Point.Inbound = 0;
+			BuildingPoints.Add(PointIndex);
+			HeapPush(Set, PointIndex);
+		}
+	}
+}
+
+void UDepositPointIndex::UnregisterDeposit(ARTS_Actor* Building)
+{
+	TArray<uint32> SetKeys;
+	if (!Building || !Registrations.RemoveAndCopyValue(Building, SetKeys))
+	{
+		return;
+	}
+
+	for (const uint32 SetKey : SetKeys)
+	{
+		FPointSet* Set = Sets.Find(SetKey);
+		TArray<int32> BuildingPoints;
+		if (!Set || !Set->BuildingPoints.RemoveAndCopyValue(Building, BuildingPoints))
+		{
+			continue;
+		}
+
+		for (const int32 PointIndex : BuildingPoints)
+		{
+			FPoint& Point = Set->Points[PointIndex];
+			HeapRemove(*Set, PointIndex);
+			Stats.InboundWorkers -= Point.Inbound;
+			Point.Inbound = 0;
+			Point.Building.Reset();
+			Point.Serial++;
+			Set->FreePoints.Add(PointIndex);
+		}
+
+		// Workers of this team pick again on their next trip
+		Set->Version++;
+	}
+
+	// Building changes are rare, a good moment to drop assignments of workers that are gone
+	for (auto It = Assignments.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.ResolveObjectPtr())
+		{
+			ReleaseAssignment(It->Value);
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool UDepositPointIndex::AcquireDeposit(ARTS_Actor* Worker, int32 Team, EResourceType ResourceType, const FVector& From, FVector& OutLocation, ARTS_Actor*& OutBuilding)
+{
+	OutBuilding = nullptr;
+
+	const uint32 SetKey = MakeSetKey(Team, ResourceType);
+	FPointSet* Set = Sets.Find(SetKey);
+	if (!Worker || !Set || Set->Heap.Num() == 0)
+	{
+		return false;
+	}
+
+	FAssignment& Assignment = Assignments.FindOrAdd(Worker);
+	const bool bCacheValid = Assignment.PointIndex != INDEX_NONE
+		&& Assignment.SetKey == SetKey
+		&& Assignment.Version == Set->Version
+		&& Set->Points.IsValidIndex(Assignment.PointIndex)
+		&& Set->Points[Assignment.PointIndex].Serial == Assignment.PointSerial
+		&& FVector::DistSquared2D(From, Assignment.AssignedFrom) <= FMath::Square(ReassignDistance);
+
+	if (bCacheValid)
+	{
+		Stats.CachedAssignments++;
+		if (!Assignment.bInbound)
+		{
+			ChangeInbound(*Set, Assignment.PointIndex, 1);
+			Assignment.bInbound = true;
+		}
+	}
+	else
+	{
+		// The worker's own claim must not count against the points it is choosing between
+		ReleaseAssignment(Assignment);
+
+		bool bRerouted = false;
+		const int32 PointIndex = SelectPoint(*Set, Team, ResourceType, From, bRerouted);
+		if (PointIndex == INDEX_NONE)
+		{
+			Assignments.Remove(Worker);
+			return false;
+		}
+
+		Stats.EvaluatedAssignments++;
+		Stats.CongestionReroutes += bRerouted ? 1 : 0;
+
+		Assignment.SetKey = SetKey;
+		Assignment.PointIndex = PointIndex;
+		Assignment.PointSerial = Set->Points[PointIndex].Serial;
+		Assignment.Version = Set->Version;
+		Assignment.AssignedFrom = From;
+		Assignment.bInbound = true;
+		ChangeInbound(*Set, PointIndex, 1);
+	}
+
+	const FPoint& Point = Set->Points[Assignment.PointIndex];
+	OutLocation = Point.Location;
+	OutBuilding = Point.Building.Get();
+	return true;
+}
+
+void UDepositPointIndex::ReleaseInbound(ARTS_Actor* Worker)
+{
+	if (FAssignment* Assignment = Assignments.Find(Worker))
+	{
+		ReleaseAssignment(*Assignment);
+	}
+}
+
+void UDepositPointIndex::ReleaseAssignment(FAssignment& Assignment)
+{
+	if (!Assignment.bInbound)
+	{
+		return;
+	}
+	Assignment.bInbound = false;
+
+	FPointSet* Set = Sets.Find(Assignment.SetKey);
+	if (Set && Set->Points.IsValidIndex(Assignment.PointIndex) && Set->Points[Assignment.PointIndex].Serial == Assignment.PointSerial)
+	{
+		ChangeInbound(*Set, Assignment.PointIndex, -1);
+	}
+}
+
+int32 UDepositPointIndex::SelectPoint(const FPointSet& Set, int32 Team, EResourceType ResourceType, const FVector& From, bool& bOutRerouted) const
+{
+	bOutRerouted = false;
+
+	int32 BestPoint = INDEX_NONE;
+	float BestScore = MAX_flt;
+
+	// Nearest building by path cost from the distance field, then its least busy point
+	FVector NearestLocation;
+	float NearestCost;
+	ARTS_Actor* NearestBuilding;
+	const UDepositDistanceField* DistanceField = UDepositDistanceField::Get(this);
+	const TArray<int32>* NearestPoints = DistanceField && DistanceField->FindBestDeposit(Team, ResourceType, From, NearestLocation, NearestCost, NearestBuilding)
+		? Set.BuildingPoints.Find(NearestBuilding)
+		: nullptr;
+
+	if (NearestPoints)
+	{
+		for (const int32 PointIndex : *NearestPoints)
+		{
+			// Points of one building share the field cost up to the walk between them
+			const FPoint& Point = Set.Points[PointIndex];
+			const float Score = (NearestCost + FVector::Dist2D(NearestLocation, Point.Location)) / WorkerSpeed + GetQueueTime(Point);
+			if (Score < BestScore)
+			{
+				BestScore = Score;
+				BestPoint = PointIndex;
+			}
+		}
+	}
+	else
+	{
+		// No field for this team yet (e.g. no navmesh), straight line over every point
+		for (const TPair<TObjectKey<ARTS_Actor>, TArray<int32>>& Pair : Set.BuildingPoints)
+		{
+			for (const int32 PointIndex : Pair.Value)
+			{
+				const FPoint& Point = Set.Points[PointIndex];
+				const float Score = FVector::Dist2D(From, Point.Location) * DetourFactor / WorkerSpeed + GetQueueTime(Point);
+				if (Score < BestScore)
+				{
+					BestScore = Score;
+					BestPoint = PointIndex;
+				}
+			}
+		}
+		return BestPoint;
+	}
+
+	// The least congested point of the team wins when the queue it saves outweighs the longer walk
+	if (Set.Heap.Num() > 0 && Set.Heap[0] != BestPoint)
+	{
+		const FPoint& Point = Set.Points[Set.Heap[0]];
+		const float Score = FVector::Dist2D(From, Point.Location) * DetourFactor / WorkerSpeed + GetQueueTime(Point);
+		if (Score < BestScore && Point.Building.IsValid())
+		{
+			bOutRerouted = BestPoint != INDEX_NONE && Point.Building.Get() != NearestBuilding;
+			BestPoint = Set.Heap[0];
+		}
+	}
+	return BestPoint;
+}
+
+float UDepositPointIndex::GetEstimatedQueueTime(int32 Team, EResourceType ResourceType, const FVector& Location) const
+{
+	const FPointSet* Set = Sets.Find(MakeSetKey(Team, ResourceType));
+	const UDepositDistanceField* DistanceField = UDepositDistanceField::Get(this);
+	if (!Set || !DistanceField)
+	{
+		return -1.f;
+	}
+
+	FVector NearestLocation;
+	float NearestCost;
+	ARTS_Actor* NearestBuilding;
+	const TArray<int32>* NearestPoints = DistanceField->FindBestDeposit(Team, ResourceType, Location, NearestLocation, NearestCost, NearestBuilding)
+		? Set->BuildingPoints.Find(NearestBuilding)
+		: nullptr;
+	if (!NearestPoints)
+	{
+		return -1.f;
+	}
+
+	float QueueTime = MAX_flt;
+	for (const int32 PointIndex : *NearestPoints)
+	{
+		QueueTime = FMath::Min(QueueTime, GetQueueTime(Set->Points[PointIndex]));
+	}
+	return QueueTime == MAX_flt ? -1.f : QueueTime;
+}
+
+void UDepositPointIndex::ChangeInbound(FPointSet& Set, int32 PointIndex, int32 Delta)
+{
+	FPoint& Point = Set.Points[PointIndex];
+	Point.Inbound = FMath::Max(0, Point.Inbound + Delta);
+	Stats.InboundWorkers = FMath::Max(0, Stats.InboundWorkers + Delta);
+
+	if (Point.HeapIndex != INDEX_NONE)
+	{
+		if (Delta > 0)
+		{
+			HeapSiftDown(Set, Point.HeapIndex);
+		}
+		else
+		{
+			HeapSiftUp(Set, Point.HeapIndex);
+		}
+	}
+}
+
+void UDepositPointIndex::HeapPush(FPointSet& Set, int32 PointIndex)
+{
+	Set.Points[PointIndex].HeapIndex = Set.Heap.Add(PointIndex);
+	HeapSiftUp(Set, Set.Points[PointIndex].HeapIndex);
+}
+
+void UDepositPointIndex::HeapRemove(FPointSet& Set, int32 PointIndex)
+{
+	const int32 HeapIndex = Set.Points[PointIndex].HeapIndex;
+	if (HeapIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 LastIndex = Set.Heap.Num() - 1;
+	HeapSwap(Set, HeapIndex, LastIndex);
+	Set.Heap.Pop(EAllowShrinking::No);
+	Set.Points[PointIndex].HeapIndex = INDEX_NONE;
+
+	if (HeapIndex < Set.Heap.Num())
+	{
+		HeapSiftDown(Set, HeapIndex);
+		HeapSiftUp(Set, HeapIndex);
+	}
+}
+
+void UDepositPointIndex::HeapSiftUp(FPointSet& Set, int32 HeapIndex)
+{
+	while (HeapIndex > 0)
+	{
+		const int32 ParentIndex = (HeapIndex - 1) / 2;
+		if (Set.Points[Set.Heap[ParentIndex]].Inbound <= Set.Points[Set.Heap[HeapIndex]].Inbound)
+		{
+			break;
+		}
+		HeapSwap(Set, HeapIndex, ParentIndex);
+		HeapIndex = ParentIndex;
+	}
+}
+
+void UDepositPointIndex::HeapSiftDown(FPointSet& Set, int32 HeapIndex)
+{
+	const int32 Num = Set.Heap.Num();
+	while (true)
+	{
+		const int32 LeftIndex = HeapIndex * 2 + 1;
+		const int32 RightIndex = LeftIndex + 1;
+		int32 SmallestIndex = HeapIndex;
+		if (LeftIndex < Num && Set.Points[Set.Heap[LeftIndex]].Inbound < Set.Points[Set.Heap[SmallestIndex]].Inbound)
+		{
+			SmallestIndex = LeftIndex;
+		}
+		if (RightIndex < Num && Set.Points[Set.Heap[RightIndex]].Inbound < Set.Points[Set.Heap[SmallestIndex]].Inbound)
+		{
+			SmallestIndex = RightIndex;
+		}
+		if (SmallestIndex == HeapIndex)
+		{
+			break;
+		}
+		HeapSwap(Set, HeapIndex, SmallestIndex);
+		HeapIndex = SmallestIndex;
+	}
+}
+
+void UDepositPointIndex::HeapSwap(FPointSet& Set, int32 A, int32 B)
+{
+	if (A == B)
+	{
+		return;
+	}
+	Set.Heap.Swap(A, B);
+	Set.Points[Set.Heap[A]].HeapIndex = A;
+	Set.Points[Set.Heap[B]].HeapIndex = B;
+}
+
+FDepositPointIndexStats UDepositPointIndex::GetStats() const
+{
+	return Stats;
+}
+
+void UDepositPointIndex::DumpIndex() const
+{
+	UE_LOG(LogTemp, Log, TEXT("UDepositPointIndex - %d inbound, %lld cached, %lld evaluated, %lld congestion reroutes"),
+		Stats.InboundWorkers, Stats.CachedAssignments, Stats.EvaluatedAssignments, Stats.CongestionReroutes);
+	for (const TPair<uint32, FPointSet>& SetPair : Sets)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  Team %u, type %u: %d points"), SetPair.Key >> 8, SetPair.Key & 0xFF, SetPair.Value.Heap.Num());
+		for (const int32 PointIndex : SetPair.Value.Heap)
+		{
+			const FPoint& Point = SetPair.Value.Points[PointIndex];
+			UE_LOG(LogTemp, Log, TEXT("    %s at %s: %d inbound, ~%.1fs queue"),
+				*GetNameSafe(Point.Building.Get()), *Point.Location.ToCompactString(), Point.Inbound, GetQueueTime(Point));
+		}
+	}
+}
@@ -0,0 +1,148 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ResourceType.h"
+#include "UObject/ObjectKey.h"
+#include "DepositPointIndex.generated.h"
+
+class ARTS_Actor;
+class UDepositModule;
+
+USTRUCT(BlueprintType)
+struct FDepositPointIndexStats
+{
+	GENERATED_BODY()
+
+	/** Acquires answered by the worker's cached assignment */
+	UPROPERTY(BlueprintReadOnly, Category = "Deposit Point Index")
+	int64 CachedAssignments = 0;
+
+	/** Acquires that ran a selection */
+	UPROPERTY(BlueprintReadOnly, Category = "Deposit Point Index")
+	int64 EvaluatedAssignments = 0;
+
+	/** Selections that sent the worker past its nearest building because of congestion */
+	UPROPERTY(BlueprintReadOnly, Category = "Deposit Point Index")
+	int64 CongestionReroutes = 0;
+
+	/** Workers currently heading to a drop-off point */
+	UPROPERTY(BlueprintReadOnly, Category = "Deposit Point Index")
+	int32 InboundWorkers = 0;
+};
+
+/**
+ * Per team and resource type index of the drop-off points of every UDepositModule building.
+ * Tracks how many workers are inbound to each point and picks a point by travel time plus estimated queue time.
+ * The nearest building comes from UDepositDistanceField, the least congested point of the team from a min-heap
+ * on inbound workers, so a selection is a cell lookup, a scan of one building's points and an O(log n) heap update.
+ * Workers keep their assignment between trips until buildings of their team change or they move to another area.
+ */
+UCLASS()
+class FINALRTS_API UDepositPointIndex : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UDepositPointIndex* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	/** Adds or replaces the drop-off points of the module's owner */
+	void RegisterDeposit(const UDepositModule* DepositModule);
+	void UnregisterDeposit(ARTS_Actor* Building);
+
+	/**
+	 * Drop-off point for Worker of Team at From carrying ResourceType, counting the worker as inbound to it
+	 * until ReleaseInbound. Returns false when the team has no drop-off for the type.
+	 */
+	bool AcquireDeposit(ARTS_Actor* Worker, int32 Team, EResourceType ResourceType, const FVector& From, FVector& OutLocation, ARTS_Actor*& OutBuilding);
+
+	/** Worker arrived or gave up, the assignment is kept for its next trip */
+	void ReleaseInbound(ARTS_Actor* Worker);
+
+	/** Estimated seconds a worker arriving now waits at the point nearest to Location, -1 without a point */
+	UFUNCTION(BlueprintPure, Category = "Deposit Point Index")
+	float GetEstimatedQueueTime(int32 Team, EResourceType ResourceType, const FVector& Location) const;
+
+	UFUNCTION(BlueprintPure, Category = "Deposit Point Index")
+	FDepositPointIndexStats GetStats() const;
+
+	void DumpIndex() const;
+
+	/** Seconds one worker occupies a drop-off point */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deposit Point Index", meta = (ClampMin = "0"))
+	float DepositServiceTime = 0.5f;
+
+	/** Speed used to turn travel distance into seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deposit Point Index", meta = (ClampMin = "1"))
+	float WorkerSpeed = 300.f;
+
+	/** Straight-line distance to a point off the distance field is scaled by this to approximate its path length */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deposit Point Index", meta = (ClampMin = "1"))
+	float DetourFactor = 1.3f;
+
+	/** A cached assignment is re-evaluated once the worker asks from further away than this */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Deposit Point Index")
+	float ReassignDistance = 1500.f;
+
+private:
+	struct FPoint
+	{
+		TWeakObjectPtr<ARTS_Actor> Building;
+		FVector Location = FVector::ZeroVector;
+		int32 Inbound = 0;
+		int32 HeapIndex = INDEX_NONE;
+
+		/** Bumped whenever the slot is freed, so assignments to a removed point do not touch its successor */
+		uint32 Serial = 0;
+	};
+
+	struct FPointSet
+	{
+		TArray<FPoint> Points;
+		TArray<int32> FreePoints;
+
+		/** Min-heap of point indices on Inbound */
+		TArray<int32> Heap;
+
+		TMap<TObjectKey<ARTS_Actor>, TArray<int32>> BuildingPoints;
+
+		/** Bumped when a building is added or removed, invalidates every cached assignment of the set */
+		uint32 Version = 0;
+	};
+
+	struct FAssignment
+	{
+		uint32 SetKey = 0;
+		int32 PointIndex = INDEX_NONE;
+		uint32 PointSerial = 0;
+		uint32 Version = 0;
+		FVector AssignedFrom = FVector::ZeroVector;
+		bool bInbound = false;
+	};
+
+	static uint32 MakeSetKey(int32 Team, EResourceType ResourceType);
+
+	int32 SelectPoint(const FPointSet& Set, int32 Team, EResourceType ResourceType, const FVector& From, bool& bOutRerouted) const;
+	float GetQueueTime(const FPoint& Point) const { return Point.Inbound * DepositServiceTime; }
+	void ChangeInbound(FPointSet& Set, int32 PointIndex, int32 Delta);
+
+	void HeapPush(FPointSet& Set, int32 PointIndex);
+	void HeapRemove(FPointSet& Set, int32 PointIndex);
+	void HeapSiftUp(FPointSet& Set, int32 HeapIndex);
+	void HeapSiftDown(FPointSet& Set, int32 HeapIndex);
+	void HeapSwap(FPointSet& Set, int32 A, int32 B);
+
+	/** Releases the inbound count an assignment holds, if its point still exists */
+	void ReleaseAssignment(FAssignment& Assignment);
+
+	TMap<uint32, FPointSet> Sets;
+
+	/** Set keys per registered building */
+	TMap<TObjectKey<ARTS_Actor>, TArray<uint32>> Registrations;
+
+	TMap<TObjectKey<ARTS_Actor>, FAssignment> Assignments;
+
+	FDepositPointIndexStats Stats;
+};
@@ -0,0 +1,239 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+
+// Built by EconomyCore/CMakeLists.txt only, the game build sees an empty translation unit
+#if defined(RTS_ECONOMY_CORE_STANDALONE)
+
+#include "EconomyCore/GatherPolicy.h"
+#include "EconomyCore/ResourceNode.h"
+#include "EconomyCore/Experience.h"
+#include "EconomyCore/Production.h"
+#include "EconomyCore/EconomySimulation.h"
+#include "EconomyCore/EconomySnapshot.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <vector>
+
+using namespace RTSEconomy;
+
+namespace
+{
+	FGatherPolicy MakePolicy(EGatherStorage Storage)
+	{
+		FGatherPolicy Policy;
+		Policy.Storage = Storage;
+		Policy.StacksStorageAmount = 5;
+		Policy.HarvestPower = 2;
+		Policy.StoragePower = 10;
+		return Policy;
+	}
+
+	/** Default XP table of UExperienceModule */
+	const std::vector<int32_t>& GetXPTable()
+	{
+		static const std::vector<int32_t> Table = {
+			0, 10, 14, 20, 25, 30, 35, 34, 39, 49, 52,
+			58, 64, 69, 75, 85, 120, 150, 155, 169, 174,
+			195, 240, 280, 420, 500, 480, 460, 440, 420, 400
+		};
+		return Table;
+	}
+}
+
+// One gather -> harvest -> decide round of a single worker, the per-cycle cost of the policy
+static void BM_GatherCycle(benchmark::State& BenchState)
+{
+	const FGatherPolicy Policy = MakePolicy(static_cast<EGatherStorage>(BenchState.range(0)));
+	FGathererState Worker;
+	int32_t NodeAmount = 0;
+
+	for (auto _ : BenchState)
+	{
+		if (DecideNextStep(Policy, Worker, 0) == EGatherDecision::Deposit)
+		{
+			benchmark::DoNotOptimize(ApplyDeposit(Worker));
+			continue;
+		}
+
+		if (NodeAmount <= 0)
+		{
+			NodeAmount = 1 << 30;
+		}
+		int32_t Granted = GetHarvestRequest(Policy, 5);
+		int32_t Harvested = 0;
+		ConsumeHarvests(NodeAmount, &Granted, 1, Harvested);
+		ApplyHarvest(Policy, Worker, Granted, 0);
+	}
+	BenchState.SetItemsProcessed(BenchState.iterations());
+}
+BENCHMARK(BM_GatherCycle)->Arg(static_cast<int>(EGatherStorage::Stacks))->Arg(static_cast<int>(EGatherStorage::Units));
+
+// One frame of a contended node: Range(0) workers finishing on the same node, resolved in one pass
+static void BM_ConsumeHarvests(benchmark::State& BenchState)
+{
+	const int32_t Workers = static_cast<int32_t>(BenchState.range(0));
+	std::vector<int32_t> Amounts(Workers);
+	int32_t NodeAmount = 0;
+
+	for (auto _ : BenchState)
+	{
+		if (NodeAmount <= 0)
+		{
+			NodeAmount = 1 << 30;
+		}
+		std::fill(Amounts.begin(), Amounts.end(), 5);
+		int32_t Harvested = 0;
+		benchmark::DoNotOptimize(ConsumeHarvests(NodeAmount, Amounts.data(), Workers, Harvested));
+	}
+	BenchState.SetItemsProcessed(BenchState.iterations() * Workers);
+}
+BENCHMARK(BM_ConsumeHarvests)->Arg(1)->Arg(8)->Arg(64);
+
+static void BM_AddExperience(benchmark::State& BenchState)
+{
+	const std::vector<int32_t>& Table = GetXPTable();
+	const int32_t MaxLevel = static_cast<int32_t>(Table.size()) - 1;
+	const auto GetRequiredXP = [&Table](int32_t Level) { return Level < static_cast<int32_t>(Table.size()) ? Table[Level] : -1; };
+	FExperienceState Experience;
+
+	for (auto _ : BenchState)
+	{
+		if (Experience.Level >= MaxLevel)
+		{
+			Experience = FExperienceState();
+		}
+		benchmark::DoNotOptimize(AddExperience(Experience, 7, MaxLevel, GetRequiredXP));
+	}
+	BenchState.SetItemsProcessed(BenchState.iterations());
+}
+BENCHMARK(BM_AddExperience);
+
+// A building that always has Range(0) units queued, advanced one simulated second at a time
+static void BM_ProductionQueue(benchmark::State& BenchState)
+{
+	const int32_t QueueLength = static_cast<int32_t>(BenchState.range(0));
+	FProductionQueue Queue;
+	double Now = 0.0;
+	int64_t Completed = 0;
+
+	for (auto _ : BenchState)
+	{
+		while (static_cast<int32_t>(Queue.Num()) < QueueLength)
+		{
+			Queue.Enqueue(2.5f);
+		}
+		Now += 1.0;
+		Completed += AdvanceProduction(Queue, Now);
+	}
+	BenchState.SetItemsProcessed(Completed);
+}
+BENCHMARK(BM_ProductionQueue)->Arg(5);
+
+// Macro: Range(0) workers over Range(0) / 4 nodes for one simulated minute, items are harvest cycles
+static void BM_EconomySimulation(benchmark::State& BenchState)
+{
+	const int32_t WorkerCount = static_cast<int32_t>(BenchState.range(0));
+	const int32_t NodeCount = std::max(1, WorkerCount / 4);
+	int64_t Cycles = 0;
+
+	for (auto _ : BenchState)
+	{
+		FEconomySimulation Simulation;
+		Simulation.Policy = MakePolicy(EGatherStorage::Stacks);
+		for (int32_t Node = 0; Node < NodeCount; ++Node)
+		{
+			FSimNode SimNode;
+			SimNode.Amount = 2000;
+			SimNode.Stack = 5;
+			SimNode.GatheringTime = 1.5f;
+			SimNode.ResourceType = static_cast<uint8_t>(Node % 3);
+			Simulation.AddNode(SimNode);
+		}
+		for (int32_t Worker = 0; Worker < WorkerCount; ++Worker)
+		{
+			Simulation.AddWorker(Worker % NodeCount, 4.f + static_cast<float>(Worker % 7));
+		}
+
+		Simulation.AdvanceTo(60.0);
+		Cycles += Simulation.GetHarvests();
+		benchmark::DoNotOptimize(Simulation.GetDeposited(0));
+	}
+	BenchState.SetItemsProcessed(Cycles);
+}
+BENCHMARK(BM_EconomySimulation)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+namespace
+{
+	/** Range(0) gathering workers over Range(0) / 4 nodes of three types, plus a few busy recruitment queues */
+	FEconomySnapshot MakeSnapshot(int32_t WorkerCount)
+	{
+		FEconomySnapshot Snapshot;
+		const int32_t NodeCount = std::max(3, WorkerCount / 4);
+		for (int32_t Node = 0; Node < NodeCount; ++Node)
+		{
+			FSnapshotNode SnapshotNode;
+			SnapshotNode.Amount = 2000;
+			SnapshotNode.Stack = 5;
+			SnapshotNode.GatheringTime = 1.5f;
+			SnapshotNode.ResourceType = static_cast<uint8_t>(Node % 3);
+			Snapshot.AddNode(SnapshotNode);
+		}
+		for (int32_t Worker = 0; Worker < WorkerCount; ++Worker)
+		{
+			FSnapshotGatherer Gatherer;
+			Gatherer.Policy = MakePolicy(EGatherStorage::Stacks);
+			Gatherer.Node = Worker % NodeCount;
+			Gatherer.Team = Worker % 2;
+			Gatherer.Phase = ESnapshotPhase::ToNode;
+			Gatherer.ToDepositTime = 4.f + static_cast<float>(Worker % 7);
+			Gatherer.ToNodeTime = Gatherer.ToDepositTime;
+			Snapshot.AddGatherer(Gatherer);
+		}
+		for (int32_t Producer = 0; Producer < 16; ++Producer)
+		{
+			FSnapshotProducer SnapshotProducer;
+			SnapshotProducer.Team = Producer % 2;
+			for (int32_t Unit = 0; Unit < 5; ++Unit)
+			{
+				SnapshotProducer.Queue.Enqueue(12.f);
+			}
+			Snapshot.AddProducer(SnapshotProducer);
+		}
+		return Snapshot;
+	}
+}
+
+// Fork cost alone: every page stays shared
+static void BM_SnapshotFork(benchmark::State& BenchState)
+{
+	const FEconomySnapshot Snapshot = MakeSnapshot(static_cast<int32_t>(BenchState.range(0)));
+	for (auto _ : BenchState)
+	{
+		FEconomySnapshot Branch = Snapshot.Fork();
+		benchmark::DoNotOptimize(Branch);
+	}
+	BenchState.SetItemsProcessed(BenchState.iterations());
+}
+BENCHMARK(BM_SnapshotFork)->Arg(1000)->Arg(10000);
+
+// "What if 10 workers move to another resource": fork, retask, simulate one minute in 0.25s steps
+static void BM_SnapshotBranch(benchmark::State& BenchState)
+{
+	const FEconomySnapshot Snapshot = MakeSnapshot(static_cast<int32_t>(BenchState.range(0)));
+	int64_t PagesCopied = 0;
+	for (auto _ : BenchState)
+	{
+		FEconomySnapshot Branch = Snapshot.Fork();
+		for (int32_t Worker = 0; Worker < 10; ++Worker)
+		{
+			Branch.Retask(Worker, 1, 6.f);
+		}
+		Branch.Simulate(60.f, 0.25f);
+		PagesCopied += Branch.GetPagesCopied();
+		benchmark::DoNotOptimize(Branch.GetDeposited(0, 1));
+	}
+	BenchState.SetItemsProcessed(BenchState.iterations());
+	BenchState.counters["PagesCopied"] = benchmark::Counter(static_cast<double>(PagesCopied), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SnapshotBranch)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+#endif
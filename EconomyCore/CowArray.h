@@ -0,0 +1,76 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace RTSEconomy
+{
+	/**
+	 * Array split into fixed-size pages that copies share until one side writes.
+	 * Copying the array copies PageSize times fewer pointers than elements, Edit copies a page the first time
+	 * it writes to one that is still shared. Shared pages are only ever read, so copies may be stepped on
+	 * different threads as long as each array object itself is used by one thread at a time.
+	 */
+	template<typename ElementType, int32_t PageSize = 64>
+	class TCowArray
+	{
+	public:
+		int32_t Num() const { return Count; }
+		int32_t NumPages() const { return static_cast<int32_t>(Pages.size()); }
+
+		int32_t Add(const ElementType& Element)
+		{
+			if (Count % PageSize == 0)
+			{
+				Pages.push_back(std::make_shared<FPage>());
+				Pages.back()->reserve(PageSize);
+			}
+			EditPage(NumPages() - 1).push_back(Element);
+			return Count++;
+		}
+
+		const ElementType& operator[](int32_t Index) const
+		{
+			return (*Pages[Index / PageSize])[Index % PageSize];
+		}
+
+		/** Writable element, copies its page first if another array still shares it */
+		ElementType& Edit(int32_t Index)
+		{
+			return EditPage(Index / PageSize)[Index % PageSize];
+		}
+
+		/** Read-only view of one page, for loops that only write to the pages that need it */
+		const std::vector<ElementType>& GetPage(int32_t PageIndex) const { return *Pages[PageIndex]; }
+
+		std::vector<ElementType>& EditPage(int32_t PageIndex)
+		{
+			std::shared_ptr<FPage>& Page = Pages[PageIndex];
+			if (Page.use_count() != 1)
+			{
+				Page = std::make_shared<FPage>(*Page);
+				++PagesCopied;
+			}
+			else
+			{
+				// The last other owner may have released the page on another thread, see its reads before writing
+				std::atomic_thread_fence(std::memory_order_acquire);
+			}
+			return *Page;
+		}
+
+		/** Pages this array copied on write since it was created or forked */
+		int64_t GetPagesCopied() const { return PagesCopied; }
+		void ResetPagesCopied() { PagesCopied = 0; }
+
+	private:
+		using FPage = std::vector<ElementType>;
+
+		std::vector<std::shared_ptr<FPage>> Pages;
+		int32_t Count = 0;
+		int64_t PagesCopied = 0;
+	};
+}
@@ -0,0 +1,117 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "EconomySimulation.h"
+#include "ResourceNode.h"
+
+namespace RTSEconomy
+{
+	int32_t FEconomySimulation::AddNode(const FSimNode& Node)
+	{
+		Nodes.push_back(Node);
+		return static_cast<int32_t>(Nodes.size()) - 1;
+	}
+
+	int32_t FEconomySimulation::AddWorker(int32_t Node, float TravelTime)
+	{
+		FSimWorker& Worker = Workers.emplace_back();
+		Worker.Node = Node;
+		Worker.TravelTime = TravelTime;
+
+		const int32_t WorkerIndex = static_cast<int32_t>(Workers.size()) - 1;
+		Decide(WorkerIndex, Now);
+		return WorkerIndex;
+	}
+
+	int64_t FEconomySimulation::GetDeposited(uint8_t ResourceType) const
+	{
+		return ResourceType < Deposited.size() ? Deposited[ResourceType] : 0;
+	}
+
+	void FEconomySimulation::AdvanceTo(double Time)
+	{
+		while (!Events.empty() && Events.top().Time <= Time)
+		{
+			const FEvent Event = Events.top();
+			Events.pop();
+			Now = Event.Time;
+
+			FSimWorker& Worker = Workers[Event.Worker];
+			if (Event.Type == EEventType::Harvest)
+			{
+				FSimNode& Node = Nodes[Worker.Node];
+				int32_t Granted = GetHarvestRequest(Policy, Node.Stack);
+				int32_t Harvested = 0;
+				ConsumeHarvests(Node.Amount, &Granted, 1, Harvested);
+				if (Granted > 0)
+				{
+					ApplyHarvest(Policy, Worker.State, Granted, Node.ResourceType);
+				}
+				++Harvests;
+				Decide(Event.Worker, Now);
+			}
+			else
+			{
+				const uint8_t ResourceType = Worker.State.CarriedType;
+				if (ResourceType >= Deposited.size())
+				{
+					Deposited.resize(ResourceType + 1, 0);
+				}
+				Deposited[ResourceType] += ApplyDeposit(Worker.State);
+				++Deposits;
+
+				// The next decision is made back at the slot
+				Decide(Event.Worker, Now + Worker.TravelTime);
+			}
+		}
+		Now = Time;
+	}
+
+	void FEconomySimulation::Decide(int32_t WorkerIndex, double Time)
+	{
+		FSimWorker& Worker = Workers[WorkerIndex];
+		if (!ResolveNode(Worker))
+		{
+			// Nothing left to gather, bring home what is carried and stop
+			Worker.bIdle = true;
+			if (Worker.State.CarriedAmount > 0)
+			{
+				Events.push({ Time + Worker.TravelTime + DepositTime, WorkerIndex, EEventType::Deposit });
+			}
+			return;
+		}
+
+		const FSimNode& Node = Nodes[Worker.Node];
+		if (DecideNextStep(Policy, Worker.State, Node.ResourceType) == EGatherDecision::Gather)
+		{
+			Events.push({ Time + Node.GatheringTime, WorkerIndex, EEventType::Harvest });
+		}
+		else
+		{
+			Events.push({ Time + Worker.TravelTime + DepositTime, WorkerIndex, EEventType::Deposit });
+		}
+	}
+
+	bool FEconomySimulation::ResolveNode(FSimWorker& Worker) const
+	{
+		if (Worker.Node < 0 || Worker.Node >= static_cast<int32_t>(Nodes.size()))
+		{
+			return false;
+		}
+		if (Nodes[Worker.Node].Amount > 0)
+		{
+			return true;
+		}
+
+		const uint8_t ResourceType = Nodes[Worker.Node].ResourceType;
+		const int32_t NodeCount = static_cast<int32_t>(Nodes.size());
+		for (int32_t Offset = 1; Offset < NodeCount; ++Offset)
+		{
+			const int32_t Candidate = (Worker.Node + Offset) % NodeCount;
+			if (Nodes[Candidate].ResourceType == ResourceType && Nodes[Candidate].Amount > 0)
+			{
+				Worker.Node = Candidate;
+				return true;
+			}
+		}
+		return false;
+	}
+}
@@ -0,0 +1,94 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "GatherPolicy.h"
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace RTSEconomy
+{
+	struct FSimNode
+	{
+		int32_t Amount = 100;
+		int32_t Stack = 1;
+		float GatheringTime = 5.f;
+		uint8_t ResourceType = 0;
+	};
+
+	struct FSimWorker
+	{
+		FGathererState State;
+		int32_t Node = -1;
+
+		/** One-way travel time between the worker's slot and its drop-off */
+		float TravelTime = 0.f;
+
+		/** No node of its type left, the worker waits for orders */
+		bool bIdle = false;
+	};
+
+	/**
+	 * Event-driven gather/deposit loop for balance simulations and benchmarks.
+	 * Workers run the same rules as the gather methods (DecideNextStep, ConsumeHarvests), movement is a fixed
+	 * travel time per worker and every harvest and deposit is an event on one queue, so nothing is stepped per frame.
+	 */
+	class FEconomySimulation
+	{
+	public:
+		FGatherPolicy Policy;
+
+		/** Time spent at the drop-off, UInstantDeposit waits 0.5s */
+		float DepositTime = 0.5f;
+
+		int32_t AddNode(const FSimNode& Node);
+
+		/** Adds a worker standing at Node's slot, it starts its first cycle at the current time */
+		int32_t AddWorker(int32_t Node, float TravelTime);
+
+		/** Runs every event up to and including Time */
+		void AdvanceTo(double Time);
+
+		double GetTime() const { return Now; }
+		int64_t GetHarvests() const { return Harvests; }
+		int64_t GetDeposits() const { return Deposits; }
+		int64_t GetDeposited(uint8_t ResourceType) const;
+
+		const std::vector<FSimNode>& GetNodes() const { return Nodes; }
+		const std::vector<FSimWorker>& GetWorkers() const { return Workers; }
+
+	private:
+		enum class EEventType : uint8_t
+		{
+			Harvest,
+			Deposit
+		};
+
+		struct FEvent
+		{
+			double Time = 0.0;
+			int32_t Worker = -1;
+			EEventType Type = EEventType::Harvest;
+
+			bool operator>(const FEvent& Other) const { return Time > Other.Time; }
+		};
+
+		/** Next step of a worker standing at its node at Time */
+		void Decide(int32_t WorkerIndex, double Time);
+
+		/** Keeps the worker's node or moves it to the next node of the same type with anything left */
+		bool ResolveNode(FSimWorker& Worker) const;
+
+		std::vector<FSimNode> Nodes;
+		std::vector<FSimWorker> Workers;
+		std::priority_queue<FEvent, std::vector<FEvent>, std::greater<FEvent>> Events;
+
+		/** Indexed by resource type */
+		std::vector<int64_t> Deposited;
+
+		double Now = 0.0;
+		int64_t Harvests = 0;
+		int64_t Deposits = 0;
+	};
+}
@@ -0,0 +1,242 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "EconomySnapshot.h"
+#include "ResourceNode.h"
+#include <algorithm>
+
+namespace RTSEconomy
+{
+	namespace
+	{
+		/** Zero-length phases would never let a step finish */
+		constexpr float MinPhaseTime = 0.01f;
+
+		void AddPhaseTime(FSnapshotGatherer& Gatherer, float Time)
+		{
+			Gatherer.TimeLeft += std::max(Time, MinPhaseTime);
+		}
+	}
+
+	void FEconomySnapshot::AddDeposited(int32_t Team, uint8_t ResourceType, int64_t Amount)
+	{
+		FTeamTotals& Totals = FindOrAddTeam(Team);
+		if (ResourceType >= Totals.Deposited.size())
+		{
+			Totals.Deposited.resize(ResourceType + 1, 0);
+		}
+		Totals.Deposited[ResourceType] += Amount;
+	}
+
+	FEconomySnapshot FEconomySnapshot::Fork() const
+	{
+		FEconomySnapshot Branch = *this;
+		Branch.Gatherers.ResetPagesCopied();
+		Branch.Nodes.ResetPagesCopied();
+		Branch.Producers.ResetPagesCopied();
+		return Branch;
+	}
+
+	void FEconomySnapshot::Retask(int32_t GathererIndex, int32_t Node, float TravelTime)
+	{
+		FSnapshotGatherer& Gatherer = Gatherers.Edit(GathererIndex);
+		Gatherer.Node = Node;
+		Gatherer.Phase = ESnapshotPhase::ToNode;
+		Gatherer.TimeLeft = 0.f;
+		AddPhaseTime(Gatherer, TravelTime);
+	}
+
+	void FEconomySnapshot::Step(float DeltaTime)
+	{
+		if (DeltaTime <= 0.f)
+		{
+			return;
+		}
+		Time += DeltaTime;
+
+		// Pages of idle workers and empty queues stay shared
+		for (int32_t PageIndex = 0; PageIndex < Gatherers.NumPages(); ++PageIndex)
+		{
+			const std::vector<FSnapshotGatherer>& Page = Gatherers.GetPage(PageIndex);
+			if (std::none_of(Page.begin(), Page.end(), [](const FSnapshotGatherer& Gatherer) { return Gatherer.Phase != ESnapshotPhase::Idle; }))
+			{
+				continue;
+			}
+
+			for (FSnapshotGatherer& Gatherer : Gatherers.EditPage(PageIndex))
+			{
+				if (Gatherer.Phase == ESnapshotPhase::Idle)
+				{
+					continue;
+				}
+
+				Gatherer.TimeLeft -= DeltaTime;
+				while (Gatherer.Phase != ESnapshotPhase::Idle && Gatherer.TimeLeft <= 0.f)
+				{
+					AdvancePhase(Gatherer);
+				}
+			}
+		}
+
+		for (int32_t PageIndex = 0; PageIndex < Producers.NumPages(); ++PageIndex)
+		{
+			const std::vector<FSnapshotProducer>& Page = Producers.GetPage(PageIndex);
+			if (std::none_of(Page.begin(), Page.end(), [](const FSnapshotProducer& Producer) { return Producer.Queue.Num() > 0; }))
+			{
+				continue;
+			}
+
+			for (FSnapshotProducer& Producer : Producers.EditPage(PageIndex))
+			{
+				Producer.Completed += AdvanceProduction(Producer.Queue, Time);
+			}
+		}
+	}
+
+	void FEconomySnapshot::Simulate(float Duration, float StepTime)
+	{
+		StepTime = std::max(StepTime, MinPhaseTime);
+		while (Duration > 0.f)
+		{
+			const float DeltaTime = std::min(Duration, StepTime);
+			Step(DeltaTime);
+			Duration -= DeltaTime;
+		}
+	}
+
+	int64_t FEconomySnapshot::GetDeposited(int32_t Team, uint8_t ResourceType) const
+	{
+		for (const FTeamTotals& Totals : Teams)
+		{
+			if (Totals.Team == Team)
+			{
+				return ResourceType < Totals.Deposited.size() ? Totals.Deposited[ResourceType] : 0;
+			}
+		}
+		return 0;
+	}
+
+	int64_t FEconomySnapshot::GetPagesCopied() const
+	{
+		return Gatherers.GetPagesCopied() + Nodes.GetPagesCopied() + Producers.GetPagesCopied();
+	}
+
+	void FEconomySnapshot::AdvancePhase(FSnapshotGatherer& Gatherer)
+	{
+		switch (Gatherer.Phase)
+		{
+		case ESnapshotPhase::ToNode:
+			DecideAtNode(Gatherer);
+			break;
+
+		case ESnapshotPhase::Gathering:
+		{
+			FSnapshotNode& Node = Nodes.Edit(Gatherer.Node);
+			int32_t Granted = GetHarvestRequest(Gatherer.Policy, Node.Stack);
+			int32_t Harvested = 0;
+			ConsumeHarvests(Node.Amount, &Granted, 1, Harvested);
+			if (Granted > 0)
+			{
+				ApplyHarvest(Gatherer.Policy, Gatherer.State, Granted, Node.ResourceType);
+			}
+			++Harvests;
+			DecideAtNode(Gatherer);
+			break;
+		}
+
+		case ESnapshotPhase::ToDeposit:
+			Gatherer.Phase = ESnapshotPhase::Depositing;
+			AddPhaseTime(Gatherer, DepositTime);
+			break;
+
+		case ESnapshotPhase::Depositing:
+		{
+			const uint8_t ResourceType = Gatherer.State.CarriedType;
+			AddDeposited(Gatherer.Team, ResourceType, ApplyDeposit(Gatherer.State));
+			++Deposits;
+			if (ResolveNode(Gatherer))
+			{
+				Gatherer.Phase = ESnapshotPhase::ToNode;
+				AddPhaseTime(Gatherer, Gatherer.ToNodeTime);
+			}
+			else
+			{
+				Gatherer.Phase = ESnapshotPhase::Idle;
+				Gatherer.TimeLeft = 0.f;
+			}
+			break;
+		}
+
+		case ESnapshotPhase::Idle:
+			break;
+		}
+	}
+
+	void FEconomySnapshot::DecideAtNode(FSnapshotGatherer& Gatherer)
+	{
+		if (!ResolveNode(Gatherer))
+		{
+			// Nothing left to gather, bring home what is carried and stop there
+			if (Gatherer.State.CarriedAmount > 0)
+			{
+				Gatherer.Phase = ESnapshotPhase::ToDeposit;
+				AddPhaseTime(Gatherer, Gatherer.ToDepositTime);
+			}
+			else
+			{
+				Gatherer.Phase = ESnapshotPhase::Idle;
+				Gatherer.TimeLeft = 0.f;
+			}
+			return;
+		}
+
+		const FSnapshotNode& Node = Nodes[Gatherer.Node];
+		if (DecideNextStep(Gatherer.Policy, Gatherer.State, Node.ResourceType) == EGatherDecision::Gather)
+		{
+			Gatherer.Phase = ESnapshotPhase::Gathering;
+			AddPhaseTime(Gatherer, Node.GatheringTime);
+		}
+		else
+		{
+			Gatherer.Phase = ESnapshotPhase::ToDeposit;
+			AddPhaseTime(Gatherer, Gatherer.ToDepositTime);
+		}
+	}
+
+	bool FEconomySnapshot::ResolveNode(FSnapshotGatherer& Gatherer) const
+	{
+		const int32_t NodeCount = Nodes.Num();
+		if (Gatherer.Node < 0 || Gatherer.Node >= NodeCount)
+		{
+			return false;
+		}
+		if (Nodes[Gatherer.Node].Amount > 0)
+		{
+			return true;
+		}
+
+		const uint8_t ResourceType = Nodes[Gatherer.Node].ResourceType;
+		for (int32_t Offset = 1; Offset < NodeCount; ++Offset)
+		{
+			const int32_t Candidate = (Gatherer.Node + Offset) % NodeCount;
+			if (Nodes[Candidate].ResourceType == ResourceType && Nodes[Candidate].Amount > 0)
+			{
+				Gatherer.Node = Candidate;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FEconomySnapshot::FTeamTotals& FEconomySnapshot::FindOrAddTeam(int32_t Team)
+	{
+		for (FTeamTotals& Totals : Teams)
+		{
+			if (Totals.Team == Team)
+			{
+				return Totals;
+			}
+		}
+		FTeamTotals& Totals = Teams.emplace_back();
+		Totals.Team = Team;
+		return Totals;
+	}
+}
@@ -0,0 +1,143 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "CowArray.h"
+#include "GatherPolicy.h"
+#include "Production.h"
+#include <cstdint>
+#include <vector>
+
+namespace RTSEconomy
+{
+	/** Where a snapshot gatherer is in its node -> drop-off -> node loop */
+	enum class ESnapshotPhase : uint8_t
+	{
+		Idle,
+		ToNode,
+		Gathering,
+		ToDeposit,
+		Depositing
+	};
+
+	struct FSnapshotGatherer
+	{
+		FGathererState State;
+		FGatherPolicy Policy;
+		ESnapshotPhase Phase = ESnapshotPhase::Idle;
+
+		/** Seconds until the current phase ends */
+		float TimeLeft = 0.f;
+
+		int32_t Node = -1;
+		int32_t Team = 0;
+
+		/** Slot to drop-off and back, measured or estimated when the snapshot was taken */
+		float ToDepositTime = 0.f;
+		float ToNodeTime = 0.f;
+	};
+
+	struct FSnapshotNode
+	{
+		int32_t Amount = 0;
+		int32_t Stack = 1;
+		float GatheringTime = 5.f;
+		uint8_t ResourceType = 0;
+	};
+
+	/** A recruitment queue, its clock runs on snapshot time */
+	struct FSnapshotProducer
+	{
+		FProductionQueue Queue;
+		int32_t Team = 0;
+
+		/** Units finished since the snapshot was taken */
+		int32_t Completed = 0;
+	};
+
+	/**
+	 * Economic state of a world, detached from it: gatherers, resource nodes, recruitment queues and deposited
+	 * totals per team. Gatherers, nodes and producers live in copy-on-write pages, so Fork is a copy of page
+	 * pointers and a branch only pays for the pages it changes. Stepping runs the gather methods' rules
+	 * (DecideNextStep, ConsumeHarvests) with fixed travel times instead of movement.
+	 * A snapshot is used by one thread at a time, its forks can be stepped on other threads.
+	 */
+	class FEconomySnapshot
+	{
+	public:
+		/** Time spent at the drop-off, UInstantDeposit waits 0.5s */
+		float DepositTime = 0.5f;
+
+		int32_t AddGatherer(const FSnapshotGatherer& Gatherer) { return Gatherers.Add(Gatherer); }
+		int32_t AddNode(const FSnapshotNode& Node) { return Nodes.Add(Node); }
+		int32_t AddProducer(const FSnapshotProducer& Producer) { return Producers.Add(Producer); }
+		void AddDeposited(int32_t Team, uint8_t ResourceType, int64_t Amount);
+
+		/** A branch sharing every page with this snapshot until one of them writes */
+		FEconomySnapshot Fork() const;
+
+		int32_t NumGatherers() const { return Gatherers.Num(); }
+		int32_t NumNodes() const { return Nodes.Num(); }
+		int32_t NumProducers() const { return Producers.Num(); }
+
+		const FSnapshotGatherer& GetGatherer(int32_t Index) const { return Gatherers[Index]; }
+		const FSnapshotNode& GetNode(int32_t Index) const { return Nodes[Index]; }
+		const FSnapshotProducer& GetProducer(int32_t Index) const { return Producers[Index]; }
+
+		FSnapshotGatherer& EditGatherer(int32_t Index) { return Gatherers.Edit(Index); }
+		FSnapshotNode& EditNode(int32_t Index) { return Nodes.Edit(Index); }
+		FSnapshotProducer& EditProducer(int32_t Index) { return Producers.Edit(Index); }
+
+		/** Orders a gatherer to Node, arriving after TravelTime. Anything of another type is deposited first */
+		void Retask(int32_t GathererIndex, int32_t Node, float TravelTime);
+
+		/** Advances every gatherer and producer by DeltaTime */
+		void Step(float DeltaTime);
+
+		/**
+		 * Steps up to Duration in StepTime increments. Harvests are taken from the node as each gatherer's phase ends,
+		 * so within one step workers sharing a node are served in gatherer order rather than by finish time
+		 */
+		void Simulate(float Duration, float StepTime);
+
+		/** Seconds since the snapshot was taken */
+		double GetTime() const { return Time; }
+
+		int64_t GetDeposited(int32_t Team, uint8_t ResourceType) const;
+		int64_t GetHarvests() const { return Harvests; }
+		int64_t GetDeposits() const { return Deposits; }
+
+		/** Pages copied on write since the snapshot was taken or forked */
+		int64_t GetPagesCopied() const;
+
+	private:
+		struct FTeamTotals
+		{
+			int32_t Team = 0;
+
+			/** Indexed by resource type */
+			std::vector<int64_t> Deposited;
+		};
+
+		/** Runs the transition at the end of the gatherer's current phase */
+		void AdvancePhase(FSnapshotGatherer& Gatherer);
+
+		/** Next step of a gatherer standing at its node */
+		void DecideAtNode(FSnapshotGatherer& Gatherer);
+
+		/** Keeps the gatherer's node or moves it to the next node of the same type with anything left */
+		bool ResolveNode(FSnapshotGatherer& Gatherer) const;
+
+		FTeamTotals& FindOrAddTeam(int32_t Team);
+
+		TCowArray<FSnapshotGatherer> Gatherers;
+		TCowArray<FSnapshotNode> Nodes;
+		TCowArray<FSnapshotProducer, 16> Producers;
+
+		/** A few teams of a few resource types, copied with the snapshot */
+		std::vector<FTeamTotals> Teams;
+
+		double Time = 0.0;
+		int64_t Harvests = 0;
+		int64_t Deposits = 0;
+	};
+}
@@ -0,0 +1,17 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "Experience.h"
+
+namespace RTSEconomy
+{
+	bool TryLevelUp(FExperienceState& State, int32_t MaxLevel, int32_t RequiredXP)
+	{
+		if (RequiredXP < 0 || State.Level >= MaxLevel || State.XP < RequiredXP)
+		{
+			return false;
+		}
+
+		State.XP -= RequiredXP;
+		++State.Level;
+		return true;
+	}
+}
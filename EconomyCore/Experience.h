@@ -0,0 +1,37 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include <cstdint>
+
+namespace RTSEconomy
+{
+	struct FExperienceState
+	{
+		int32_t Level = 1;
+		int32_t XP = 0;
+	};
+
+	/**
+	 * Spends RequiredXP on one level if the state has enough of it and is below MaxLevel.
+	 * RequiredXP < 0 means the current level is not in the XP table, which also ends leveling.
+	 */
+	bool TryLevelUp(FExperienceState& State, int32_t MaxLevel, int32_t RequiredXP);
+
+	/**
+	 * Adds Amount and levels up as often as it pays for, the rules behind UExperienceModule::AddExperience.
+	 * GetRequiredXP(Level) returns the XP needed to leave Level, or < 0 past the end of the table.
+	 * Returns the number of levels gained.
+	 */
+	template<typename RequiredXPFn>
+	int32_t AddExperience(FExperienceState& State, int32_t Amount, int32_t MaxLevel, RequiredXPFn&& GetRequiredXP)
+	{
+		State.XP += Amount;
+
+		int32_t LevelsGained = 0;
+		while (TryLevelUp(State, MaxLevel, GetRequiredXP(State.Level)))
+		{
+			++LevelsGained;
+		}
+		return LevelsGained;
+	}
+}
@@ -0,0 +1,66 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "GatherPolicy.h"
+#include <algorithm>
+
+namespace RTSEconomy
+{
+	EGatherDecision DecideNextStep(const FGatherPolicy& Policy, FGathererState& State, uint8_t TargetType)
+	{
+		// Carrying a different resource type than the target, deposit first
+		if (State.CarriedAmount > 0 && State.CarriedType != TargetType)
+		{
+			return EGatherDecision::Deposit;
+		}
+
+		// Recently deposited, the method-local counter starts over
+		if (State.CarriedAmount == 0 && State.Stored > 0)
+		{
+			State.Stored = 0;
+		}
+
+		const int32_t Capacity = Policy.Storage == EGatherStorage::Stacks ? Policy.StacksStorageAmount : Policy.StoragePower;
+		return State.Stored >= Capacity ? EGatherDecision::Deposit : EGatherDecision::Gather;
+	}
+
+	int32_t GetHarvestRequest(const FGatherPolicy& Policy, int32_t NodeStack)
+	{
+		return Policy.Storage == EGatherStorage::Stacks ? NodeStack : Policy.HarvestPower;
+	}
+
+	void ApplyHarvest(const FGatherPolicy& Policy, FGathererState& State, int32_t Granted, uint8_t ResourceType)
+	{
+		State.CarriedAmount += Granted;
+		State.CarriedType = ResourceType;
+		if (Policy.Storage == EGatherStorage::Stacks)
+		{
+			State.Stored = std::clamp(State.Stored + 1, 0, Policy.StacksStorageAmount);
+		}
+		else
+		{
+			State.Stored = std::clamp(State.Stored + Granted, 0, Policy.StoragePower);
+		}
+	}
+
+	int32_t ApplyDeposit(FGathererState& State)
+	{
+		const int32_t Deposited = State.CarriedAmount;
+		State.CarriedAmount = 0;
+		return Deposited;
+	}
+
+	bool GetTripYield(const FGatherPolicy& Policy, int32_t NodeStack, int32_t& OutHarvestsPerTrip, int32_t& OutAmountPerHarvest)
+	{
+		if (Policy.Storage == EGatherStorage::Stacks)
+		{
+			OutHarvestsPerTrip = Policy.StacksStorageAmount;
+			OutAmountPerHarvest = NodeStack;
+		}
+		else
+		{
+			// The last harvest of a trip may overshoot StoragePower, the full HarvestPower is still carried
+			OutHarvestsPerTrip = Policy.HarvestPower > 0 ? (Policy.StoragePower + Policy.HarvestPower - 1) / Policy.HarvestPower : 0;
+			OutAmountPerHarvest = Policy.HarvestPower;
+		}
+		return OutHarvestsPerTrip > 0 && OutAmountPerHarvest > 0;
+	}
+}
@@ -0,0 +1,63 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Engine-independent gather/deposit rules.
+ * UGatherMethod_001, UGatherMethod_002 and the gatherer Mass processor wrap these, so the same decisions
+ * can be run and benchmarked outside of a world (see EconomyCore/CMakeLists.txt).
+ */
+namespace RTSEconomy
+{
+	/** How a gatherer fills up before it deposits */
+	enum class EGatherStorage : uint8_t
+	{
+		/** UGatherMethod_001: one ResourceStack per cycle, deposits after StacksStorageAmount stacks */
+		Stacks,
+		/** UGatherMethod_002: HarvestPower units per cycle, deposits after StoragePower units */
+		Units
+	};
+
+	struct FGatherPolicy
+	{
+		EGatherStorage Storage = EGatherStorage::Stacks;
+		int32_t StacksStorageAmount = 1;
+		int32_t HarvestPower = 1;
+		int32_t StoragePower = 5;
+	};
+
+	/** What a gatherer carries. Resource types are the raw EResourceType values */
+	struct FGathererState
+	{
+		int32_t CarriedAmount = 0;
+		uint8_t CarriedType = 0;
+
+		/** Method-local fill level, stacks or units depending on the policy */
+		int32_t Stored = 0;
+	};
+
+	enum class EGatherDecision : uint8_t
+	{
+		Gather,
+		Deposit
+	};
+
+	/**
+	 * The decision UGatherMethod::Gather makes when a worker reaches or re-evaluates a node of TargetType.
+	 * Clears Stored once the worker has deposited everything it carried.
+	 */
+	EGatherDecision DecideNextStep(const FGatherPolicy& Policy, FGathererState& State, uint8_t TargetType);
+
+	/** Units one gathering cycle asks the node for */
+	int32_t GetHarvestRequest(const FGatherPolicy& Policy, int32_t NodeStack);
+
+	/** Adds a resolved harvest to what the worker carries */
+	void ApplyHarvest(const FGatherPolicy& Policy, FGathererState& State, int32_t Granted, uint8_t ResourceType);
+
+	/** Hands over everything carried, Stored is cleared on the next decision */
+	int32_t ApplyDeposit(FGathererState& State);
+
+	/** Harvests per trip and units per harvest of a full node -> deposit loop, false if the policy never fills up */
+	bool GetTripYield(const FGatherPolicy& Policy, int32_t NodeStack, int32_t& OutHarvestsPerTrip, int32_t& OutAmountPerHarvest);
+}
@@ -0,0 +1,80 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "Production.h"
+#include <algorithm>
+
+namespace RTSEconomy
+{
+	bool StartProduction(FProductionState& State, double Now, float TimeNeeded)
+	{
+		if (State.bProducing)
+		{
+			return false;
+		}
+
+		State.StartTime = Now;
+		State.TimeNeeded = TimeNeeded;
+		State.bProducing = true;
+		return true;
+	}
+
+	bool FinishProduction(FProductionState& State)
+	{
+		if (!State.bProducing)
+		{
+			return false;
+		}
+
+		State.StartTime = -1.0;
+		State.bProducing = false;
+		return true;
+	}
+
+	float GetProductionTimeSpent(const FProductionState& State, double Now)
+	{
+		if (!State.bProducing)
+		{
+			return 0.f;
+		}
+		return std::clamp(static_cast<float>(Now - State.StartTime), 0.f, State.TimeNeeded);
+	}
+
+	float GetProductionProgress(const FProductionState& State, double Now)
+	{
+		return State.TimeNeeded > 0.f ? GetProductionTimeSpent(State, Now) / State.TimeNeeded : 0.f;
+	}
+
+	int32_t AdvanceProduction(FProductionQueue& Queue, double Now)
+	{
+		int32_t Completed = 0;
+		while (Queue.Num() > 0)
+		{
+			if (!Queue.State.bProducing)
+			{
+				// Idle queues pick up the next unit right away
+				StartProduction(Queue.State, Now, Queue.TimesNeeded[Queue.Head]);
+			}
+
+			const double CompletionTime = Queue.State.StartTime + Queue.State.TimeNeeded;
+			if (CompletionTime > Now)
+			{
+				break;
+			}
+
+			FinishProduction(Queue.State);
+			++Queue.Head;
+			++Completed;
+			if (Queue.Num() > 0)
+			{
+				StartProduction(Queue.State, CompletionTime, Queue.TimesNeeded[Queue.Head]);
+			}
+		}
+
+		// Drop completed entries once they dominate, keeps Enqueue amortized O(1)
+		if (Queue.Head > 64 && Queue.Head * 2 > Queue.TimesNeeded.size())
+		{
+			Queue.TimesNeeded.erase(Queue.TimesNeeded.begin(), Queue.TimesNeeded.begin() + static_cast<std::ptrdiff_t>(Queue.Head));
+			Queue.Head = 0;
+		}
+		return Completed;
+	}
+}
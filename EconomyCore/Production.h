@@ -0,0 +1,49 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RTSEconomy
+{
+	/** The unit currently in production, the timing part of URecruitmentModule */
+	struct FProductionState
+	{
+		/** Time the current unit started at, negative while idle */
+		double StartTime = -1.0;
+		float TimeNeeded = 0.f;
+		bool bProducing = false;
+	};
+
+	/** Starts the next unit at Now unless one is already in production */
+	bool StartProduction(FProductionState& State, double Now, float TimeNeeded);
+
+	/** Ends the current unit, returns false if nothing was in production */
+	bool FinishProduction(FProductionState& State);
+
+	/** Seconds spent on the current unit, clamped to TimeNeeded */
+	float GetProductionTimeSpent(const FProductionState& State, double Now);
+
+	/** Progress of the current unit in 0-1 */
+	float GetProductionProgress(const FProductionState& State, double Now);
+
+	/** A production queue of unit build times, for simulations that have no scheduler to drive it */
+	struct FProductionQueue
+	{
+		FProductionState State;
+		std::vector<float> TimesNeeded;
+
+		/** Index of the unit in production or next up */
+		size_t Head = 0;
+
+		void Enqueue(float TimeNeeded) { TimesNeeded.push_back(TimeNeeded); }
+		size_t Num() const { return TimesNeeded.size() - Head; }
+	};
+
+	/**
+	 * Completes every unit due by Now. Each unit starts when the previous one completes, like
+	 * URecruitmentModule::ProcessProductionQueue chaining into EnableProduction. Returns the units completed.
+	 */
+	int32_t AdvanceProduction(FProductionQueue& Queue, double Now);
+}
@@ -0,0 +1,25 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "ResourceNode.h"
+#include <algorithm>
+
+namespace RTSEconomy
+{
+	bool ConsumeHarvests(int32_t& InOutNodeAmount, int32_t* InOutAmounts, int32_t Count, int32_t& OutHarvested)
+	{
+		OutHarvested = 0;
+		if (InOutNodeAmount <= 0)
+		{
+			// Already depleted, nothing left to hand out
+			std::fill(InOutAmounts, InOutAmounts + Count, 0);
+			return false;
+		}
+
+		for (int32_t Index = 0; Index < Count; ++Index)
+		{
+			InOutAmounts[Index] = std::clamp(InOutAmounts[Index], 0, InOutNodeAmount);
+			InOutNodeAmount -= InOutAmounts[Index];
+			OutHarvested += InOutAmounts[Index];
+		}
+		return InOutNodeAmount <= 0;
+	}
+}
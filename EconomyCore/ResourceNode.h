@@ -0,0 +1,15 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include <cstdint>
+
+namespace RTSEconomy
+{
+	/**
+	 * Hands out what is left of a node to Amounts in order, clamping each to the remainder.
+	 * OutHarvested is the total handed out. Returns true if this call emptied the node,
+	 * a node that was already empty gives out nothing and does not deplete again.
+	 * The rules behind UGatherableModule::ConsumeHarvests.
+	 */
+	bool ConsumeHarvests(int32_t& InOutNodeAmount, int32_t* InOutAmounts, int32_t Count, int32_t& OutHarvested);
+}
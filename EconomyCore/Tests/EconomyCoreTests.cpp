@@ -0,0 +1,382 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+
+// Built by EconomyCore/CMakeLists.txt only, the game build sees an empty translation unit
+#if defined(RTS_ECONOMY_CORE_STANDALONE)
+
+#include "EconomyCore/GatherPolicy.h"
+#include "EconomyCore/ResourceNode.h"
+#include "EconomyCore/Experience.h"
+#include "EconomyCore/Production.h"
+#include "EconomyCore/CowArray.h"
+#include "EconomyCore/EconomySnapshot.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace RTSEconomy;
+
+namespace
+{
+	constexpr uint8_t Wood = 0;
+	constexpr uint8_t Stone = 1;
+
+	FGatherPolicy MakePolicy(EGatherStorage Storage)
+	{
+		FGatherPolicy Policy;
+		Policy.Storage = Storage;
+		Policy.StacksStorageAmount = 3;
+		Policy.HarvestPower = 2;
+		Policy.StoragePower = 5;
+		return Policy;
+	}
+}
+
+// DecideNextStep
+
+TEST(GatherPolicy, GathersUntilStacksAreFull)
+{
+	const FGatherPolicy Policy = MakePolicy(EGatherStorage::Stacks);
+	FGathererState State;
+	for (int32_t Stack = 0; Stack < Policy.StacksStorageAmount; ++Stack)
+	{
+		EXPECT_EQ(DecideNextStep(Policy, State, Wood), EGatherDecision::Gather);
+		ApplyHarvest(Policy, State, 10, Wood);
+	}
+	EXPECT_EQ(DecideNextStep(Policy, State, Wood), EGatherDecision::Deposit);
+}
+
+TEST(GatherPolicy, DepositsBeforeSwitchingResourceType)
+{
+	const FGatherPolicy Policy = MakePolicy(EGatherStorage::Stacks);
+	FGathererState State;
+	ApplyHarvest(Policy, State, 10, Wood);
+
+	EXPECT_EQ(DecideNextStep(Policy, State, Stone), EGatherDecision::Deposit);
+	EXPECT_EQ(DecideNextStep(Policy, State, Wood), EGatherDecision::Gather);
+}
+
+TEST(GatherPolicy, StoredStartsOverAfterDeposit)
+{
+	const FGatherPolicy Policy = MakePolicy(EGatherStorage::Units);
+	FGathererState State;
+	ApplyHarvest(Policy, State, 2, Wood);
+	ApplyHarvest(Policy, State, 2, Wood);
+	ApplyHarvest(Policy, State, 2, Wood);
+	ASSERT_EQ(DecideNextStep(Policy, State, Wood), EGatherDecision::Deposit);
+
+	EXPECT_EQ(ApplyDeposit(State), 6);
+	EXPECT_EQ(DecideNextStep(Policy, State, Wood), EGatherDecision::Gather);
+	EXPECT_EQ(State.Stored, 0);
+}
+
+// ApplyHarvest
+
+TEST(GatherPolicy, StacksCountOneHarvestEach)
+{
+	const FGatherPolicy Policy = MakePolicy(EGatherStorage::Stacks);
+	FGathererState State;
+	ApplyHarvest(Policy, State, 7, Stone);
+
+	EXPECT_EQ(State.CarriedAmount, 7);
+	EXPECT_EQ(State.CarriedType, Stone);
+	EXPECT_EQ(State.Stored, 1);
+}
+
+TEST(GatherPolicy, UnitsClampToStoragePower)
+{
+	const FGatherPolicy Policy = MakePolicy(EGatherStorage::Units);
+	FGathererState State;
+	ApplyHarvest(Policy, State, 4, Wood);
+	ApplyHarvest(Policy, State, 4, Wood);
+
+	// Everything granted is carried, only the fill level is capped
+	EXPECT_EQ(State.CarriedAmount, 8);
+	EXPECT_EQ(State.Stored, Policy.StoragePower);
+}
+
+TEST(GatherPolicy, ClampedHarvestOnlyCountsWhatWasGranted)
+{
+	const FGatherPolicy Policy = MakePolicy(EGatherStorage::Units);
+	FGathererState State;
+	ApplyHarvest(Policy, State, 1, Wood);
+
+	EXPECT_EQ(State.CarriedAmount, 1);
+	EXPECT_EQ(State.Stored, 1);
+}
+
+// ConsumeHarvests
+
+TEST(ResourceNode, HandsOutInRequestOrder)
+{
+	int32_t NodeAmount = 10;
+	std::vector<int32_t> Amounts = { 4, 4, 4 };
+	int32_t Harvested = 0;
+
+	EXPECT_TRUE(ConsumeHarvests(NodeAmount, Amounts.data(), static_cast<int32_t>(Amounts.size()), Harvested));
+	EXPECT_EQ(Amounts, (std::vector<int32_t>{ 4, 4, 2 }));
+	EXPECT_EQ(Harvested, 10);
+	EXPECT_EQ(NodeAmount, 0);
+}
+
+TEST(ResourceNode, LaterRequestsGetNothingOnceEmpty)
+{
+	int32_t NodeAmount = 3;
+	std::vector<int32_t> Amounts = { 5, 5 };
+	int32_t Harvested = 0;
+
+	EXPECT_TRUE(ConsumeHarvests(NodeAmount, Amounts.data(), static_cast<int32_t>(Amounts.size()), Harvested));
+	EXPECT_EQ(Amounts, (std::vector<int32_t>{ 3, 0 }));
+	EXPECT_EQ(Harvested, 3);
+}
+
+TEST(ResourceNode, NegativeRequestsClampToZero)
+{
+	int32_t NodeAmount = 10;
+	std::vector<int32_t> Amounts = { -3, 2 };
+	int32_t Harvested = 0;
+
+	EXPECT_FALSE(ConsumeHarvests(NodeAmount, Amounts.data(), static_cast<int32_t>(Amounts.size()), Harvested));
+	EXPECT_EQ(Amounts, (std::vector<int32_t>{ 0, 2 }));
+	EXPECT_EQ(NodeAmount, 8);
+}
+
+TEST(ResourceNode, EmptyNodeDoesNotDepleteAgain)
+{
+	int32_t NodeAmount = 0;
+	std::vector<int32_t> Amounts = { 5 };
+	int32_t Harvested = 0;
+
+	EXPECT_FALSE(ConsumeHarvests(NodeAmount, Amounts.data(), static_cast<int32_t>(Amounts.size()), Harvested));
+	EXPECT_EQ(Amounts[0], 0);
+	EXPECT_EQ(Harvested, 0);
+}
+
+// TryLevelUp
+
+TEST(Experience, LevelsUpAndKeepsTheRemainder)
+{
+	FExperienceState State;
+	State.XP = 15;
+
+	EXPECT_TRUE(TryLevelUp(State, 10, 10));
+	EXPECT_EQ(State.Level, 2);
+	EXPECT_EQ(State.XP, 5);
+}
+
+TEST(Experience, NotEnoughXP)
+{
+	FExperienceState State;
+	State.XP = 9;
+
+	EXPECT_FALSE(TryLevelUp(State, 10, 10));
+	EXPECT_EQ(State.Level, 1);
+	EXPECT_EQ(State.XP, 9);
+}
+
+TEST(Experience, StopsAtMaxLevelAndEndOfTable)
+{
+	FExperienceState State;
+	State.Level = 10;
+	State.XP = 100;
+	EXPECT_FALSE(TryLevelUp(State, 10, 10));
+
+	State.Level = 5;
+	EXPECT_FALSE(TryLevelUp(State, 10, -1));
+	EXPECT_EQ(State.XP, 100);
+}
+
+TEST(Experience, AddExperienceGainsSeveralLevels)
+{
+	FExperienceState State;
+	const int32_t LevelsGained = AddExperience(State, 35, 10, [](int32_t) { return 10; });
+
+	EXPECT_EQ(LevelsGained, 3);
+	EXPECT_EQ(State.Level, 4);
+	EXPECT_EQ(State.XP, 5);
+}
+
+// AdvanceProduction
+
+TEST(Production, IdleQueueStartsAtNow)
+{
+	FProductionQueue Queue;
+	Queue.Enqueue(2.f);
+
+	EXPECT_EQ(AdvanceProduction(Queue, 1.0), 0);
+	EXPECT_TRUE(Queue.State.bProducing);
+	EXPECT_DOUBLE_EQ(Queue.State.StartTime, 1.0);
+	EXPECT_FLOAT_EQ(GetProductionProgress(Queue.State, 2.0), 0.5f);
+
+	EXPECT_EQ(AdvanceProduction(Queue, 3.0), 1);
+	EXPECT_FALSE(Queue.State.bProducing);
+	EXPECT_EQ(Queue.Num(), 0u);
+}
+
+TEST(Production, UnitsChainFromThePreviousCompletion)
+{
+	FProductionQueue Queue;
+	AdvanceProduction(Queue, 0.0);
+	Queue.Enqueue(1.f);
+	Queue.Enqueue(2.f);
+	Queue.Enqueue(4.f);
+	ASSERT_EQ(AdvanceProduction(Queue, 0.0), 0);
+
+	// A late update still completes every unit that was due, each starting when the last one ended
+	EXPECT_EQ(AdvanceProduction(Queue, 3.5), 2);
+	EXPECT_TRUE(Queue.State.bProducing);
+	EXPECT_DOUBLE_EQ(Queue.State.StartTime, 3.0);
+	EXPECT_EQ(Queue.Num(), 1u);
+
+	EXPECT_EQ(AdvanceProduction(Queue, 7.0), 1);
+	EXPECT_EQ(Queue.Num(), 0u);
+}
+
+TEST(Production, CompactsLongQueues)
+{
+	FProductionQueue Queue;
+	for (int32_t Unit = 0; Unit < 200; ++Unit)
+	{
+		Queue.Enqueue(1.f);
+	}
+	AdvanceProduction(Queue, 0.0);
+
+	EXPECT_EQ(AdvanceProduction(Queue, 150.0), 150);
+	EXPECT_EQ(Queue.Num(), 50u);
+	EXPECT_LT(Queue.TimesNeeded.size(), 200u);
+}
+
+// TCowArray
+
+TEST(CowArray, EditingACopyLeavesTheSourceUnchanged)
+{
+	TCowArray<int32_t, 4> Source;
+	for (int32_t Value = 0; Value < 10; ++Value)
+	{
+		Source.Add(Value);
+	}
+
+	TCowArray<int32_t, 4> Copy = Source;
+	Copy.Edit(5) = 99;
+
+	EXPECT_EQ(Source[5], 5);
+	EXPECT_EQ(Copy[5], 99);
+	EXPECT_EQ(Copy[4], 4);
+	EXPECT_EQ(Source.GetPagesCopied(), 0);
+}
+
+TEST(CowArray, CopiesOnlyTouchedPages)
+{
+	TCowArray<int32_t, 4> Source;
+	for (int32_t Value = 0; Value < 16; ++Value)
+	{
+		Source.Add(Value);
+	}
+	ASSERT_EQ(Source.NumPages(), 4);
+
+	TCowArray<int32_t, 4> Copy = Source;
+	Copy.ResetPagesCopied();
+	Copy.Edit(1) = -1;
+	Copy.Edit(2) = -2;
+	Copy.Edit(13) = -13;
+	EXPECT_EQ(Copy.GetPagesCopied(), 2);
+
+	// The copy took its own page 0, the source is the only owner of its page now
+	Source.Edit(0) = -100;
+	EXPECT_EQ(Source.GetPagesCopied(), 0);
+	EXPECT_EQ(Copy[0], 0);
+}
+
+// FEconomySnapshot
+
+namespace
+{
+	FSnapshotGatherer MakeSnapshotGatherer(int32_t Node)
+	{
+		FSnapshotGatherer Gatherer;
+		Gatherer.Policy = MakePolicy(EGatherStorage::Stacks);
+		Gatherer.Node = Node;
+		Gatherer.Team = 1;
+		Gatherer.ToNodeTime = 2.f;
+		Gatherer.ToDepositTime = 2.f;
+		return Gatherer;
+	}
+
+	FSnapshotNode MakeSnapshotNode(uint8_t ResourceType)
+	{
+		FSnapshotNode Node;
+		Node.Amount = 100;
+		Node.Stack = 10;
+		Node.GatheringTime = 1.f;
+		Node.ResourceType = ResourceType;
+		return Node;
+	}
+}
+
+TEST(EconomySnapshot, SteppingAForkLeavesTheSourceUnchanged)
+{
+	FEconomySnapshot Source;
+	Source.AddNode(MakeSnapshotNode(Wood));
+	Source.AddGatherer(MakeSnapshotGatherer(0));
+	Source.Retask(0, 0, 1.f);
+
+	FEconomySnapshot Branch = Source.Fork();
+	Branch.Simulate(10.f, 0.5f);
+
+	EXPECT_LT(Branch.GetNode(0).Amount, 100);
+	EXPECT_GT(Branch.GetDeposited(1, Wood), 0);
+
+	EXPECT_EQ(Source.GetNode(0).Amount, 100);
+	EXPECT_EQ(Source.GetGatherer(0).Phase, ESnapshotPhase::ToNode);
+	EXPECT_EQ(Source.GetDeposited(1, Wood), 0);
+	EXPECT_DOUBLE_EQ(Source.GetTime(), 0.0);
+}
+
+TEST(EconomySnapshot, IdlePagesStayShared)
+{
+	FEconomySnapshot Source;
+	Source.AddNode(MakeSnapshotNode(Wood));
+	for (int32_t Index = 0; Index < 128; ++Index)
+	{
+		Source.AddGatherer(MakeSnapshotGatherer(0));
+	}
+	// Only the second page of gatherers has a worker on the move
+	Source.Retask(100, 0, 10.f);
+
+	FEconomySnapshot Branch = Source.Fork();
+	Branch.Step(0.5f);
+
+	// The moving worker's page only, the idle page and the untouched node stay shared with the source
+	EXPECT_EQ(Branch.GetPagesCopied(), 1);
+	EXPECT_EQ(Branch.GetGatherer(100).TimeLeft, 9.5f);
+	EXPECT_EQ(Source.GetGatherer(100).TimeLeft, 10.f);
+}
+
+TEST(EconomySnapshot, RetaskDepositsTheOtherTypeFirst)
+{
+	FEconomySnapshot Snapshot;
+	const int32_t WoodNode = Snapshot.AddNode(MakeSnapshotNode(Wood));
+	const int32_t StoneNode = Snapshot.AddNode(MakeSnapshotNode(Stone));
+
+	FSnapshotGatherer Gatherer = MakeSnapshotGatherer(WoodNode);
+	ApplyHarvest(Gatherer.Policy, Gatherer.State, 10, Wood);
+	Snapshot.AddGatherer(Gatherer);
+
+	Snapshot.Retask(0, StoneNode, 1.f);
+
+	// Arrives at the stone node still carrying wood, and turns around to drop it off
+	Snapshot.Step(1.5f);
+	EXPECT_EQ(Snapshot.GetGatherer(0).Phase, ESnapshotPhase::ToDeposit);
+	EXPECT_EQ(Snapshot.GetNode(StoneNode).Amount, 100);
+
+	Snapshot.Step(2.f);
+	EXPECT_EQ(Snapshot.GetDeposited(1, Wood), 10);
+	EXPECT_EQ(Snapshot.GetGatherer(0).Phase, ESnapshotPhase::ToNode);
+	EXPECT_EQ(Snapshot.GetGatherer(0).Node, StoneNode);
+
+	// Back at the stone node with empty hands, it gathers there now
+	Snapshot.Simulate(4.f, 0.5f);
+	EXPECT_LT(Snapshot.GetNode(StoneNode).Amount, 100);
+	EXPECT_EQ(Snapshot.GetNode(WoodNode).Amount, 100);
+	EXPECT_EQ(Snapshot.GetGatherer(0).State.CarriedType, Stone);
+}
+
+#endif
@@ -1,68 +1,128 @@
-#include "ExperienceModule.h"
-
-UExperienceModule::UExperienceModule()
-{
-	// Initialize runtime state
-	CurrentXP = 0;
-	CurrentLevel = 1;
-
-	// Default XP requirements per level
-	XPRequirements = {
-		{1, 10}, {2, 14}, {3, 20}, {4, 25}, {5, 30}, {6, 35}, {7, 34}, {8, 39}, {9, 49}, {10, 52},
-		{11, 58}, {12, 64}, {13, 69}, {14, 75}, {15, 85}, {16, 120}, {17, 150}, {18, 155}, {19, 169}, {20, 174},
-		{21, 195}, {22, 240}, {23, 280}, {24, 420}, {25, 500}, {26, 480}, {27, 460}, {28, 440}, {29, 420}, {30, 400}
-	};
-
-	// Ensure MaxLevel matches the XPRequirements map size
-	MaxLevel = XPRequirements.Num();
-}
-
-void UExperienceModule::InitializeModule_Implementation(ARTS_Actor* InOwner)
-{
-	Super::InitializeModule_Implementation(InOwner);
-
-	// Reset runtime state on initialization
-	CurrentXP = 0;
-	CurrentLevel = 1;
-}
-
-void UExperienceModule::AddExperience(int32 Amount)
-{
-	CurrentXP += Amount;
-	OnExperienceGained.Broadcast(Amount);
-	OnExperienceUpdate.Broadcast(CurrentXP, XPRequirements.Contains(CurrentLevel) ? XPRequirements[CurrentLevel] : 0);
-
-	while (XPRequirements.Contains(CurrentLevel) && CurrentXP >= XPRequirements[CurrentLevel])
-	{
-		LevelUp();
-		OnExperienceUpdate.Broadcast(CurrentXP, XPRequirements.Contains(CurrentLevel) ? XPRequirements[CurrentLevel] : 0);
-	}
-}
-
-void UExperienceModule::LevelUp()
-{
-	if (CurrentLevel >= MaxLevel) return;
-
-	int32 RequiredXP = XPRequirements.Contains(CurrentLevel) ? XPRequirements[CurrentLevel] : 0;
-	CurrentXP -= RequiredXP;
-	CurrentLevel++;
-
-	UE_LOG(LogTemp, Warning, TEXT("Leveled Up! New Level: %d"), CurrentLevel);
-
-	OnLevelUp.Broadcast(CurrentLevel);
-	OnExperienceUpdate.Broadcast(CurrentXP, XPRequirements.Contains(CurrentLevel) ? XPRequirements[CurrentLevel] : 0);
-}
-
-int32 UExperienceModule::GetCurrentLevel() const
-{
-	return CurrentLevel;
-}
-
-int32 UExperienceModule::GetXPToNextLevel() const
-{
-	if (XPRequirements.Contains(CurrentLevel))
-	{
-		return XPRequirements[CurrentLevel] - CurrentXP;
-	}
-	return 0;
+#include "ExperienceModule.h"
+#include "RTS_Stats.h"
+#include "RTS_UIEventSubsystem.h"
+#include "EconomyCore/Experience.h"
+
+namespace
+{
+	// Default XP requirements per level, one table for the whole process instead of one per module
+	const TMap<int32, int32>& GetDefaultXPRequirements()
+	{
+		static const TMap<int32, int32> DefaultXPRequirements = {
+			{1, 10}, {2, 14}, {3, 20}, {4, 25}, {5, 30}, {6, 35}, {7, 34}, {8, 39}, {9, 49}, {10, 52},
+			{11, 58}, {12, 64}, {13, 69}, {14, 75}, {15, 85}, {16, 120}, {17, 150}, {18, 155}, {19, 169}, {20, 174},
+			{21, 195}, {22, 240}, {23, 280}, {24, 420}, {25, 500}, {26, 480}, {27, 460}, {28, 440}, {29, 420}, {30, 400}
+		};
+		return DefaultXPRequirements;
+	}
+}
+
+UExperienceModule::UExperienceModule()
+{
+	// Initialize runtime state
+	CurrentXP = 0;
+	CurrentLevel = 1;
+
+	// Ensure MaxLevel matches the default XP table size
+	MaxLevel = GetDefaultXPRequirements().Num();
+}
+
+void UExperienceModule::InitializeModule_Implementation(ARTS_Actor* InOwner)
+{
+	Super::InitializeModule_Implementation(InOwner);
+
+	// Reset runtime state on initialization
+	ResetModule();
+}
+
+void UExperienceModule::ResetModule_Implementation()
+{
+	Super::ResetModule_Implementation();
+
+	CurrentXP = 0;
+	CurrentLevel = 1;
+}
+
+void UExperienceModule::GetSharedArchetypeProperties(TArray<FName>& OutPropertyNames) const
+{
+	// Read through GetXPRequirements
+	OutPropertyNames.Add(GET_MEMBER_NAME_CHECKED(UExperienceModule, XPRequirements));
+}
+
+const TMap<int32, int32>& UExperienceModule::GetXPRequirements() const
+{
+	if (XPRequirements.Num() > 0)
+	{
+		return XPRequirements;
+	}
+
+	const UExperienceModule* Config = GetArchetype<UExperienceModule>();
+	if (Config && Config->XPRequirements.Num() > 0)
+	{
+		return Config->XPRequirements;
+	}
+	return GetDefaultXPRequirements();
+}
+
+void UExperienceModule::SetXPRequirements(const TMap<int32, int32>& InXPRequirements)
+{
+	XPRequirements = InXPRequirements;
+}
+
+int32 UExperienceModule::GetRequiredXP(int32 Level) const
+{
+	const int32* RequiredXP = GetXPRequirements().Find(Level);
+	return RequiredXP ? *RequiredXP : 0;
+}
+
+void UExperienceModule::AddExperience(int32 Amount)
+{
+	RTS_MODULE_SCOPE(STAT_RTS_ExperienceAdd);
+
+	CurrentXP += Amount;
+	OnExperienceGained.Broadcast(Amount);
+	OnExperienceUpdate.Broadcast(CurrentXP, GetRequiredXP(CurrentLevel));
+
+	// Stops at MaxLevel even when the table goes further, a capped unit used to spin here forever
+	while (LevelUp())
+	{
+	}
+
+	URTS_UIEventSubsystem::PostEvent(Owner, ERTSUIEvent::ExperienceChanged);
+}
+
+bool UExperienceModule::LevelUp()
+{
+	// Levels missing from the table end leveling
+	const int32* RequiredXP = GetXPRequirements().Find(CurrentLevel);
+
+	RTSEconomy::FExperienceState State;
+	State.Level = CurrentLevel;
+	State.XP = CurrentXP;
+	if (!RTSEconomy::TryLevelUp(State, MaxLevel, RequiredXP ? *RequiredXP : -1))
+	{
+		return false;
+	}
+	CurrentLevel = State.Level;
+	CurrentXP = State.XP;
+
+	UE_LOG(LogTemp, Warning, TEXT("Leveled Up! New Level: %d"), CurrentLevel);
+
+	OnLevelUp.Broadcast(CurrentLevel);
+	OnExperienceUpdate.Broadcast(CurrentXP, GetRequiredXP(CurrentLevel));
+	return true;
+}
+
+int32 UExperienceModule::GetCurrentLevel() const
+{
+	return CurrentLevel;
+}
+
+int32 UExperienceModule::GetXPToNextLevel() const
+{
+	if (GetXPRequirements().Contains(CurrentLevel))
+	{
+		return GetRequiredXP(CurrentLevel) - CurrentXP;
+	}
+	return 0;
 } 
\ No newline at end of file
@@ -1,57 +1,74 @@
-#pragma once
-
-#include "CoreMinimal.h"
-#include "RTS_Module.h"
-#include "ExperienceModule.generated.h"
-
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLevelUp, int32, NewLevel);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnExperienceGained, int32, XPAdded);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnExperienceUpdate, int32, CurrentXP, int32, RequiredXP);
-
-UCLASS(Abstract, Blueprintable, EditInlineNew)
-class FINALRTS_API UExperienceModule : public URTS_Module
-{
-	GENERATED_BODY()
-
-public:
-	UExperienceModule();
-
-	virtual void InitializeModule_Implementation(ARTS_Actor* InOwner) override;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Experience Module")
-	int32 CurrentLevel = 1;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Experience Module")
-	int32 CurrentXP = 0;
-
-	// Settings
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Experience Module")
-	int32 MaxLevel = 40;
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Experience Module")
-	TMap<int32, int32> XPRequirements;
-
-	// Delegates
-	UPROPERTY(BlueprintAssignable, Category = "Experience Module")
-	FOnLevelUp OnLevelUp;
-
-	UPROPERTY(BlueprintAssignable, Category = "Experience Module")
-	FOnExperienceGained OnExperienceGained;
-
-	UPROPERTY(BlueprintAssignable, Category = "Experience Module")
-	FOnExperienceUpdate OnExperienceUpdate;
-
-	// API
-	UFUNCTION(BlueprintCallable, Category = "Experience Module")
-	void AddExperience(int32 Amount);
-
-	UFUNCTION(BlueprintPure, Category = "Experience Module")
-	int32 GetCurrentLevel() const;
-
-	UFUNCTION(BlueprintPure, Category = "Experience Module")
-	int32 GetXPToNextLevel() const;
-
-private:
-	// Internal logic
-	void LevelUp();
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RTS_Module.h"
+#include "ExperienceModule.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLevelUp, int32, NewLevel);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnExperienceGained, int32, XPAdded);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnExperienceUpdate, int32, CurrentXP, int32, RequiredXP);
+
+UCLASS(Abstract, Blueprintable, EditInlineNew)
+class FINALRTS_API UExperienceModule : public URTS_Module
+{
+	GENERATED_BODY()
+
+public:
+	UExperienceModule();
+
+	virtual void InitializeModule_Implementation(ARTS_Actor* InOwner) override;
+	virtual void ResetModule_Implementation() override;
+	virtual bool SupportsSharedArchetype() const override { return true; }
+	virtual void GetSharedArchetypeProperties(TArray<FName>& OutPropertyNames) const override;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Experience Module")
+	int32 CurrentLevel = 1;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Experience Module")
+	int32 CurrentXP = 0;
+
+	// Settings
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Experience Module")
+	int32 MaxLevel = 40;
+
+	/** XP needed to leave each level. Empty uses the archetype's table, then the built-in one, see GetXPRequirements */
+	UPROPERTY(EditDefaultsOnly, BlueprintGetter = GetXPRequirementTable, BlueprintSetter = SetXPRequirements, Category = "Experience Module")
+	TMap<int32, int32> XPRequirements;
+
+	// Delegates
+	UPROPERTY(BlueprintAssignable, Category = "Experience Module")
+	FOnLevelUp OnLevelUp;
+
+	UPROPERTY(BlueprintAssignable, Category = "Experience Module")
+	FOnExperienceGained OnExperienceGained;
+
+	UPROPERTY(BlueprintAssignable, Category = "Experience Module")
+	FOnExperienceUpdate OnExperienceUpdate;
+
+	// API
+	UFUNCTION(BlueprintCallable, Category = "Experience Module")
+	void AddExperience(int32 Amount);
+
+	UFUNCTION(BlueprintPure, Category = "Experience Module")
+	int32 GetCurrentLevel() const;
+
+	UFUNCTION(BlueprintPure, Category = "Experience Module")
+	int32 GetXPToNextLevel() const;
+
+	/** XP table in use: this module's own if set, else the archetype's, else the built-in table */
+	const TMap<int32, int32>& GetXPRequirements() const;
+
+	UFUNCTION(BlueprintGetter)
+	TMap<int32, int32> GetXPRequirementTable() const { return GetXPRequirements(); }
+
+	/** Gives this module its own table instead of the shared one */
+	UFUNCTION(BlueprintSetter)
+	void SetXPRequirements(const TMap<int32, int32>& InXPRequirements);
+
+private:
+	/** XP needed to leave the given level, 0 past the end of the table */
+	int32 GetRequiredXP(int32 Level) const;
+
+	/** Spends the XP of one level if there is enough and MaxLevel is not reached, see EconomyCore/Experience.h */
+	bool LevelUp();
 }; 
\ No newline at end of file
@@ -1,75 +1,174 @@
-﻿// Copyright AmberleafCotton 2025. All Rights Reserved.=
-#include "GatherableModule.h"
-#include "RTS_Actor.h"
-
-UGatherableModule::UGatherableModule()
-{
-	
-}
-
-void UGatherableModule::InitializeModule_Implementation(ARTS_Actor* InOwner)
-{
-	Super::InitializeModule_Implementation(InOwner);
-
-	switch (ResourceSize)
-	{
-	case EResourceSize::Normal:
-		CurrentResourceAmount = ResourceAmount;
-		break;
-	case EResourceSize::Plentiful:
-		// Placeholder
-		break;
-	case EResourceSize::Mega:
-		// Placeholder
-		break;
-	default:
-		CurrentResourceAmount = ResourceAmount;
-		break;
-	}
-}
-
-void UGatherableModule::HarvestResource(int32 Amount, bool& OutHarvested, int32& OutStackAmount, EResourceType& OutResourceType)
-{
-	// Default values before processing
-	OutStackAmount = ResourceStack;
-	OutResourceType = ResourceType;
-	OutHarvested = false;
-
-	if (CurrentResourceAmount <= 0)
-	{
-		// No resources to harvest
-		OutHarvested = false;
-		return;
-	}
-
-	// Perform the harvesting logic
-	CurrentResourceAmount -= Amount;
-
-	if (CurrentResourceAmount <= 0)
-	{
-		OnResourceDepleted.Broadcast();
-
-		// Destroy the owner actor when resource is depleted
-		if (Owner)
-		{
-			Owner->Destroy();
-		}
-	}
-
-	OnResourceHarvested.Broadcast(CurrentResourceAmount, ResourceAmount, Amount);
-
-	// Successfully harvested
-	OutHarvested = true;
-}
-
-
-int32 UGatherableModule::GetCurrentResourceAmount() const
-{
-	return CurrentResourceAmount;
-}
-
-int32 UGatherableModule::GetResourceStackAmount() const
-{
-	return ResourceStack;
-}
-
+﻿// Copyright AmberleafCotton 2025. All Rights Reserved.=
+#include "GatherableModule.h"
+#include "RTS_Actor.h"
+#include "RTS_ActorPool.h"
+#include "ResourceSpatialIndex.h"
+#include "SlotReservationService.h"
+#include "EconomyCore/ResourceNode.h"
+
+UGatherableModule::UGatherableModule()
+{
+	
+}
+
+void UGatherableModule::InitializeModule_Implementation(ARTS_Actor* InOwner)
+{
+	Super::InitializeModule_Implementation(InOwner);
+
+	ResetModule();
+}
+
+void UGatherableModule::ResetModule_Implementation()
+{
+	Super::ResetModule_Implementation();
+
+	CurrentResourceAmount = GetStartingResourceAmount();
+
+	// Active resources are findable, parked ones are not
+	if (Owner)
+	{
+		// Slot layout is rebuilt lazily at the node's new place
+		if (USlotReservationService* SlotService = USlotReservationService::Get(Owner))
+		{
+			SlotService->UnregisterResource(Owner);
+		}
+
+		if (UResourceSpatialIndex* SpatialIndex = UResourceSpatialIndex::Get(Owner))
+		{
+			if (Owner->IsInPool())
+			{
+				SpatialIndex->UnregisterResource(Owner);
+			}
+			else
+			{
+				SpatialIndex->RegisterResource(Owner, ResourceType, GetMaxGatherers());
+			}
+		}
+	}
+}
+
+int32 UGatherableModule::GetStartingResourceAmount() const
+{
+	switch (ResourceSize)
+	{
+	case EResourceSize::Plentiful:
+		return ResourceAmount * PlentifulAmountMultiplier;
+	case EResourceSize::Mega:
+		return ResourceAmount * MegaAmountMultiplier;
+	default:
+		return ResourceAmount;
+	}
+}
+
+int32 UGatherableModule::GetMaxGatherers() const
+{
+	int32 Gatherers = MaxGatherers;
+	switch (ResourceSize)
+	{
+	case EResourceSize::Plentiful:
+		Gatherers *= PlentifulGathererMultiplier;
+		break;
+	case EResourceSize::Mega:
+		Gatherers *= MegaGathererMultiplier;
+		break;
+	default:
+		break;
+	}
+	return FMath::Clamp(Gatherers, 1, 64);
+}
+
+void UGatherableModule::HarvestResource(int32 Amount, bool& OutHarvested, int32& OutStackAmount, EResourceType& OutResourceType)
+{
+	// Default values before processing
+	OutStackAmount = ResourceStack;
+	OutResourceType = ResourceType;
+
+	TArray<int32> Granted = { Amount };
+	const bool bDepleted = ConsumeHarvests(Granted);
+	OutHarvested = Granted[0] > 0;
+
+	if (bDepleted)
+	{
+		RecycleOwner();
+	}
+}
+
+void UGatherableModule::RequestHarvest(int32 Amount, FOnHarvestResolved OnResolved)
+{
+	if (UHarvestResolver* Resolver = UHarvestResolver::Get(this))
+	{
+		Resolver->RequestHarvest(this, Amount, MoveTemp(OnResolved));
+		return;
+	}
+
+	// No world subsystems (e.g. editor preview), resolve on the spot
+	TArray<int32> Granted = { Amount };
+	if (ConsumeHarvests(Granted))
+	{
+		RecycleOwner();
+	}
+	OnResolved.ExecuteIfBound(Granted[0] > 0, Granted[0], ResourceType);
+}
+
+bool UGatherableModule::ConsumeHarvests(TArray<int32>& InOutAmounts)
+{
+	// A recycled node is refilled by ResetModule while it waits in the pool, workers that still target it get nothing
+	if (CurrentResourceAmount <= 0 || (Owner && Owner->IsInPool()))
+	{
+		// Already depleted this frame or parked, nothing to hand out
+		for (int32& Amount : InOutAmounts)
+		{
+			Amount = 0;
+		}
+		return false;
+	}
+
+	// Hands out in request order, clamping each to what is left (EconomyCore/ResourceNode.h)
+	int32 Harvested = 0;
+	const bool bDepleted = RTSEconomy::ConsumeHarvests(CurrentResourceAmount, InOutAmounts.GetData(), InOutAmounts.Num(), Harvested);
+	if (bDepleted)
+	{
+		if (UResourceSpatialIndex* SpatialIndex = Owner ? UResourceSpatialIndex::Get(Owner) : nullptr)
+		{
+			SpatialIndex->UnregisterResource(Owner);
+		}
+		if (USlotReservationService* SlotService = Owner ? USlotReservationService::Get(Owner) : nullptr)
+		{
+			SlotService->UnregisterResource(Owner);
+		}
+		OnResourceDepleted.Broadcast();
+	}
+
+	OnResourceHarvested.Broadcast(CurrentResourceAmount, GetStartingResourceAmount(), Harvested);
+	return bDepleted;
+}
+
+void UGatherableModule::RecycleOwner()
+{
+	// Recycle the owner actor when resource is depleted, destroy it if there is no pool
+	if (!Owner)
+	{
+		return;
+	}
+
+	if (URTS_ActorPool* Pool = URTS_ActorPool::Get(Owner))
+	{
+		Pool->ReleaseActor(Owner);
+	}
+	else
+	{
+		Owner->Destroy();
+	}
+}
+
+
+int32 UGatherableModule::GetCurrentResourceAmount() const
+{
+	return CurrentResourceAmount;
+}
+
+int32 UGatherableModule::GetResourceStackAmount() const
+{
+	return ResourceStack;
+}
+
@@ -1,66 +1,108 @@
-﻿// Copyright AmberleafCotton 2025. All Rights Reserved.
-#pragma once
-
-#include "RTS_Module.h"
-#include "ResourceType.h"
-#include "ResourceSize.h"
-#include "GatherableModule.generated.h"
-
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnResourceHarvested, int32, CurrentResourceAmount, int32, MaxResourceAmount, int32, ValueAmount);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnResourceDepleted);
-
-/**
- * A module representing a gatherable resource.
- * Handles basic resource tracking and exposes a harvesting event.
- */
-UCLASS(Abstract, Blueprintable, EditInlineNew)
-class FINALRTS_API UGatherableModule : public URTS_Module
-{
-	GENERATED_BODY()
-
-public:
-	UGatherableModule();
-
-	virtual void InitializeModule_Implementation(ARTS_Actor* InOwner) override;
-	
-	/** Resource type (e.g., Wood, Stone) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module")
-	EResourceType ResourceType = EResourceType::Wood;
-
-	/** Resource size (e.g., Small, Normal, Large) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module")
-	EResourceSize ResourceSize = EResourceSize::Normal;
-	
-	/** Total amount of resource available at start */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module")
-	int32 ResourceAmount = 100;
-
-	/** Current remaining resource amount */
-	UPROPERTY()
-	int32 CurrentResourceAmount = 0;
-
-	/** Resource stack size (e.g., 1 stack = 5 wood) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module")
-	int32 ResourceStack = 1;
-
-	/** Time needed to gather one stack */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module")
-	float GatheringTime = 5.f;
-	
-	UFUNCTION(BlueprintPure, Category = "Gatherable Module")
-	int32 GetCurrentResourceAmount() const;
-	
-	UFUNCTION(BlueprintPure, Category = "Gatherable Module")
-	int32 GetResourceStackAmount() const;
-	
-	UFUNCTION(BlueprintCallable, Category = "Gatherable Module")
-	void HarvestResource(int32 Amount, bool& OutHarvested, int32& OutStackAmount, EResourceType& OutResourceType);
-	
-	/** Called when a resource is gathered */
-	UPROPERTY(BlueprintAssignable, Category = "Gatherable Module")
-	FOnResourceHarvested OnResourceHarvested;
-	
-	/** Called when a resource is depleted */
-	UPROPERTY(BlueprintAssignable, Category = "Gatherable Module")
-	FOnResourceDepleted OnResourceDepleted;
-};
+﻿// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "RTS_Module.h"
+#include "ResourceType.h"
+#include "ResourceSize.h"
+#include "HarvestResolver.h"
+#include "GatherableModule.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnResourceHarvested, int32, CurrentResourceAmount, int32, MaxResourceAmount, int32, ValueAmount);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnResourceDepleted);
+
+/**
+ * A module representing a gatherable resource.
+ * Handles basic resource tracking and exposes a harvesting event.
+ */
+UCLASS(Abstract, Blueprintable, EditInlineNew)
+class FINALRTS_API UGatherableModule : public URTS_Module
+{
+	GENERATED_BODY()
+
+public:
+	UGatherableModule();
+
+	virtual void InitializeModule_Implementation(ARTS_Actor* InOwner) override;
+	virtual void ResetModule_Implementation() override;
+	virtual bool SupportsSharedArchetype() const override { return true; }
+	
+	/** Resource type (e.g., Wood, Stone) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module")
+	EResourceType ResourceType = EResourceType::Wood;
+
+	/** Resource size (e.g., Small, Normal, Large) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module")
+	EResourceSize ResourceSize = EResourceSize::Normal;
+	
+	/** Total amount of resource available at start */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module")
+	int32 ResourceAmount = 100;
+
+	/** Current remaining resource amount */
+	UPROPERTY()
+	int32 CurrentResourceAmount = 0;
+
+	/** Resource stack size (e.g., 1 stack = 5 wood) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module")
+	int32 ResourceStack = 1;
+
+	/** Time needed to gather one stack */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module")
+	float GatheringTime = 5.f;
+
+	/** Workers that can gather at the same time on a Normal node, see GetMaxGatherers */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module", meta = (ClampMin = "1"))
+	int32 MaxGatherers = 4;
+
+	/** ResourceAmount and MaxGatherers multipliers of Plentiful nodes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module|Size", meta = (ClampMin = "1"))
+	int32 PlentifulAmountMultiplier = 3;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module|Size", meta = (ClampMin = "1"))
+	int32 PlentifulGathererMultiplier = 2;
+
+	/** ResourceAmount and MaxGatherers multipliers of Mega nodes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module|Size", meta = (ClampMin = "1"))
+	int32 MegaAmountMultiplier = 10;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherable Module|Size", meta = (ClampMin = "1"))
+	int32 MegaGathererMultiplier = 4;
+
+	/** Starting amount for the node's ResourceSize */
+	UFUNCTION(BlueprintPure, Category = "Gatherable Module")
+	int32 GetStartingResourceAmount() const;
+
+	/** Gatherers for the node's ResourceSize, the slot ring size in USlotReservationService (at most 64) */
+	UFUNCTION(BlueprintPure, Category = "Gatherable Module")
+	int32 GetMaxGatherers() const;
+	
+	UFUNCTION(BlueprintPure, Category = "Gatherable Module")
+	int32 GetCurrentResourceAmount() const;
+	
+	UFUNCTION(BlueprintPure, Category = "Gatherable Module")
+	int32 GetResourceStackAmount() const;
+	
+	/** Harvests right away. Gatherers should use RequestHarvest so contended nodes resolve once per frame */
+	UFUNCTION(BlueprintCallable, Category = "Gatherable Module")
+	void HarvestResource(int32 Amount, bool& OutHarvested, int32& OutStackAmount, EResourceType& OutResourceType);
+
+	/** Queues a harvest with UHarvestResolver, OnResolved gets the amount actually granted */
+	void RequestHarvest(int32 Amount, FOnHarvestResolved OnResolved);
+
+	/**
+	 * Hands out what is left to Amounts in order, clamping each to the remainder, and broadcasts once.
+	 * Returns true if this call emptied the node; its owner is recycled by RecycleOwner afterwards.
+	 */
+	bool ConsumeHarvests(TArray<int32>& InOutAmounts);
+
+	/** Returns the depleted owner to URTS_ActorPool, or destroys it without a pool */
+	void RecycleOwner();
+	
+	/** Called when a resource is gathered */
+	UPROPERTY(BlueprintAssignable, Category = "Gatherable Module")
+	FOnResourceHarvested OnResourceHarvested;
+	
+	/** Called when a resource is depleted */
+	UPROPERTY(BlueprintAssignable, Category = "Gatherable Module")
+	FOnResourceDepleted OnResourceDepleted;
+};
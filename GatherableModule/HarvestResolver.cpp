@@ -0,0 +1,145 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "HarvestResolver.h"
+#include "GatherableModule.h"
+#include "RTS_Stats.h"
+#include "Algo/StableSort.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld GDumpHarvestResolverCommand(
+	TEXT("RTS.Harvest.Dump"),
+	TEXT("Logs request/clamp/depletion counters of the batched harvest resolver."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UHarvestResolver* Resolver = UHarvestResolver::Get(World))
+		{
+			Resolver->DumpStats();
+		}
+	}));
+
+UHarvestResolver* UHarvestResolver::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UHarvestResolver>() : nullptr;
+}
+
+void UHarvestResolver::Deinitialize()
+{
+	PendingRequests.Empty();
+	RequestOrder.Empty();
+	NodeAmounts.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UHarvestResolver::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHarvestResolver, STATGROUP_Tickables);
+}
+
+void UHarvestResolver::Tick(float DeltaTime)
+{
+	ResolvePending();
+}
+
+void UHarvestResolver::RequestHarvest(UGatherableModule* Node, int32 Amount, FOnHarvestResolved OnResolved)
+{
+	FHarvestRequest& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.Node = Node;
+	Request.Requested = FMath::Max(0, Amount);
+	Request.OnResolved = MoveTemp(OnResolved);
+}
+
+void UHarvestResolver::ResolvePending()
+{
+	if (PendingRequests.Num() == 0)
+	{
+		return;
+	}
+
+	// Callbacks often queue the worker's next harvest, those belong to the next frame
+	TArray<FHarvestRequest> Requests = MoveTemp(PendingRequests);
+	PendingRequests.Reset();
+	Resolve(Requests);
+}
+
+void UHarvestResolver::Resolve(TArray<FHarvestRequest>& Requests)
+{
+	if (Requests.Num() == 0)
+	{
+		return;
+	}
+
+	RTS_MODULE_SCOPE(STAT_RTS_HarvestResolve);
+	Stats.Requests += Requests.Num();
+
+	// Group by node, request order is kept inside a group so earlier finishers are served first
+	RequestOrder.Reset(Requests.Num());
+	for (int32 Index = 0; Index < Requests.Num(); ++Index)
+	{
+		RequestOrder.Add(Index);
+	}
+	Algo::StableSortBy(RequestOrder, [&Requests](int32 Index) { return Requests[Index].Node.Get(); });
+
+	TArray<UGatherableModule*, TInlineAllocator<8>> DepletedNodes;
+	for (int32 GroupStart = 0; GroupStart < RequestOrder.Num();)
+	{
+		UGatherableModule* Node = Requests[RequestOrder[GroupStart]].Node.Get();
+		int32 GroupEnd = GroupStart + 1;
+		while (GroupEnd < RequestOrder.Num() && Requests[RequestOrder[GroupEnd]].Node.Get() == Node)
+		{
+			++GroupEnd;
+		}
+
+		if (Node)
+		{
+			NodeAmounts.Reset(GroupEnd - GroupStart);
+			for (int32 OrderIndex = GroupStart; OrderIndex < GroupEnd; ++OrderIndex)
+			{
+				NodeAmounts.Add(Requests[RequestOrder[OrderIndex]].Requested);
+			}
+
+			if (Node->ConsumeHarvests(NodeAmounts))
+			{
+				DepletedNodes.Add(Node);
+				Stats.Depletions++;
+			}
+			Stats.NodeResolves++;
+			Stats.PeakRequestsPerNode = FMath::Max(Stats.PeakRequestsPerNode, GroupEnd - GroupStart);
+
+			for (int32 OrderIndex = GroupStart; OrderIndex < GroupEnd; ++OrderIndex)
+			{
+				FHarvestRequest& Request = Requests[RequestOrder[OrderIndex]];
+				Request.Granted = NodeAmounts[OrderIndex - GroupStart];
+				Request.bHarvested = Request.Granted > 0;
+				Request.ResourceType = Node->ResourceType;
+				Stats.ClampedRequests += Request.bHarvested && Request.Granted < Request.Requested ? 1 : 0;
+				Stats.RejectedRequests += Request.bHarvested ? 0 : 1;
+			}
+		}
+		else
+		{
+			Stats.RejectedRequests += GroupEnd - GroupStart;
+		}
+
+		GroupStart = GroupEnd;
+	}
+
+	// Depleted nodes leave before workers hear back, so their next Gather() already sees the node gone
+	for (UGatherableModule* Node : DepletedNodes)
+	{
+		Node->RecycleOwner();
+	}
+
+	for (FHarvestRequest& Request : Requests)
+	{
+		Request.OnResolved.ExecuteIfBound(Request.bHarvested, Request.Granted, Request.ResourceType);
+	}
+}
+
+void UHarvestResolver::DumpStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("UHarvestResolver - %lld requests over %lld node passes, %lld clamped, %lld rejected, %lld depletions, peak %d requests per node"),
+		Stats.Requests, Stats.NodeResolves, Stats.ClampedRequests, Stats.RejectedRequests, Stats.Depletions, Stats.PeakRequestsPerNode);
+}
@@ -0,0 +1,91 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ResourceType.h"
+#include "HarvestResolver.generated.h"
+
+class UGatherableModule;
+
+/** Result of one queued harvest: whether anything was granted, how much and of which type */
+DECLARE_DELEGATE_ThreeParams(FOnHarvestResolved, bool /*bHarvested*/, int32 /*Amount*/, EResourceType /*ResourceType*/);
+
+/** One harvest against a node, Granted/bHarvested are filled in by UHarvestResolver */
+struct FHarvestRequest
+{
+	TWeakObjectPtr<UGatherableModule> Node;
+	int32 Requested = 0;
+	int32 Granted = 0;
+	bool bHarvested = false;
+	EResourceType ResourceType = EResourceType::Wood;
+	FOnHarvestResolved OnResolved;
+};
+
+USTRUCT(BlueprintType)
+struct FHarvestResolverStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Harvest Resolver")
+	int64 Requests = 0;
+
+	/** Node passes, one OnResourceHarvested broadcast each */
+	UPROPERTY(BlueprintReadOnly, Category = "Harvest Resolver")
+	int64 NodeResolves = 0;
+
+	/** Requests granted less than they asked for because the node ran out */
+	UPROPERTY(BlueprintReadOnly, Category = "Harvest Resolver")
+	int64 ClampedRequests = 0;
+
+	/** Requests that got nothing, the node was already empty */
+	UPROPERTY(BlueprintReadOnly, Category = "Harvest Resolver")
+	int64 RejectedRequests = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Harvest Resolver")
+	int64 Depletions = 0;
+
+	/** Most requests one node received in a single frame */
+	UPROPERTY(BlueprintReadOnly, Category = "Harvest Resolver")
+	int32 PeakRequestsPerNode = 0;
+};
+
+/**
+ * Collects harvests against UGatherableModule nodes during a frame and resolves them per node in one pass.
+ * A node hands out what it has left in request order, so contended nodes are never over-harvested, and every
+ * node broadcasts OnResourceHarvested once and depletes at most once per frame, no matter how many workers finished.
+ */
+UCLASS()
+class FINALRTS_API UHarvestResolver : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UHarvestResolver* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Queues a harvest, OnResolved runs when the frame's requests are resolved */
+	void RequestHarvest(UGatherableModule* Node, int32 Amount, FOnHarvestResolved OnResolved);
+
+	/** Resolves Requests right away with the same per-node rules, for callers that batch themselves (e.g. Mass processors) */
+	void Resolve(TArray<FHarvestRequest>& Requests);
+
+	/** Resolves everything queued so far */
+	void ResolvePending();
+
+	UFUNCTION(BlueprintPure, Category = "Harvest Resolver")
+	FHarvestResolverStats GetStats() const { return Stats; }
+
+	void DumpStats() const;
+
+private:
+	TArray<FHarvestRequest> PendingRequests;
+
+	/** Scratch for Resolve, kept to avoid reallocating every frame */
+	TArray<int32> RequestOrder;
+	TArray<int32> NodeAmounts;
+
+	FHarvestResolverStats Stats;
+};
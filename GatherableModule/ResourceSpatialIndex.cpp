@@ -0,0 +1,393 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "ResourceSpatialIndex.h"
+#include "GatherableModule.h"
+#include "RTS_Actor.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// Grid queries against a TActorIterator scan, the way FindNewResource would have to do it without the index
+static FAutoConsoleCommandWithWorldAndArgs GBenchmarkResourceSpatialIndexCommand(
+	TEXT("RTS.Resources.BenchmarkIndex"),
+	TEXT("Times nearest-resource queries on the spatial index against brute force actor iteration. Usage: RTS.Resources.BenchmarkIndex [Queries=10000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const UResourceSpatialIndex* Index = UResourceSpatialIndex::Get(World);
+		if (!Index || Index->GetNumResources() == 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("RTS.Resources.BenchmarkIndex - No registered resources in the world"));
+			return;
+		}
+
+		const int32 Queries = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+
+		// Query origins and types sampled from the resources themselves
+		FBox Bounds(ForceInit);
+		TArray<EResourceType> Types;
+		for (TActorIterator<ARTS_Actor> It(World); It; ++It)
+		{
+			if (const UGatherableModule* Gatherable = It->GetModule<UGatherableModule>())
+			{
+				Bounds += It->GetActorLocation();
+				Types.AddUnique(Gatherable->ResourceType);
+			}
+		}
+
+		FRandomStream Random(1234);
+		TArray<TPair<EResourceType, FVector>> Cases;
+		Cases.Reserve(Queries);
+		for (int32 Query = 0; Query < Queries; ++Query)
+		{
+			Cases.Emplace(Types[Random.RandRange(0, Types.Num() - 1)], Random.RandPointInBox(Bounds.ExpandBy(1000.f)));
+		}
+
+		int32 IndexFound = 0;
+		TArray<ARTS_Actor*> Results;
+		const double IndexStart = FPlatformTime::Seconds();
+		for (const TPair<EResourceType, FVector>& Case : Cases)
+		{
+			Results.Reset();
+			Index->FindNearest(Case.Key, Case.Value, 1, 0.f, false, Results);
+			IndexFound += Results.Num();
+		}
+		const double IndexSeconds = FPlatformTime::Seconds() - IndexStart;
+
+		int32 BruteFound = 0;
+		const double BruteStart = FPlatformTime::Seconds();
+		for (const TPair<EResourceType, FVector>& Case : Cases)
+		{
+			ARTS_Actor* Best = nullptr;
+			float BestDistanceSquared = MAX_flt;
+			for (TActorIterator<ARTS_Actor> It(World); It; ++It)
+			{
+				const UGatherableModule* Gatherable = It->GetModule<UGatherableModule>();
+				if (!Gatherable || Gatherable->ResourceType != Case.Key || It->IsInPool())
+				{
+					continue;
+				}
+				const float DistanceSquared = FVector::DistSquared2D(It->GetActorLocation(), Case.Value);
+				if (DistanceSquared < BestDistanceSquared)
+				{
+					BestDistanceSquared = DistanceSquared;
+					Best = *It;
+				}
+			}
+			BruteFound += Best ? 1 : 0;
+		}
+		const double BruteSeconds = FPlatformTime::Seconds() - BruteStart;
+
+		UE_LOG(LogTemp, Log, TEXT("RTS.Resources.BenchmarkIndex - %d queries over %d resources"), Queries, Index->GetNumResources());
+		UE_LOG(LogTemp, Log, TEXT("  Spatial index : %.2f us/query (%d found)"), IndexSeconds * 1e6 / Queries, IndexFound);
+		UE_LOG(LogTemp, Log, TEXT("  Brute force   : %.2f us/query (%d found)"), BruteSeconds * 1e6 / Queries, BruteFound);
+	}));
+
+UResourceSpatialIndex* UResourceSpatialIndex::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UResourceSpatialIndex>() : nullptr;
+}
+
+void UResourceSpatialIndex::Deinitialize()
+{
+	Entries.Empty();
+	FreeEntries.Empty();
+	EntryLookup.Empty();
+	Grids.Empty();
+
+	Super::Deinitialize();
+}
+
+FIntPoint UResourceSpatialIndex::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+UResourceSpatialIndex::FTypeGrid* UResourceSpatialIndex::FindGrid(EResourceType ResourceType)
+{
+	const int32 TypeIndex = static_cast<int32>(ResourceType);
+	return Grids.IsValidIndex(TypeIndex) ? &Grids[TypeIndex] : nullptr;
+}
+
+const UResourceSpatialIndex::FTypeGrid* UResourceSpatialIndex::FindGrid(EResourceType ResourceType) const
+{
+	const int32 TypeIndex = static_cast<int32>(ResourceType);
+	return Grids.IsValidIndex(TypeIndex) ? &Grids[TypeIndex] : nullptr;
+}
+
+void UResourceSpatialIndex::RegisterResource(ARTS_Actor* Resource, EResourceType ResourceType, int32 Capacity)
+{
+	if (!Resource)
+	{
+		return;
+	}
+
+	const int32 TypeIndex = static_cast<int32>(ResourceType);
+	const FVector Location = Resource->GetActorLocation();
+	const FIntPoint Cell = GetCell(Location);
+
+	// Already indexed at the same place, only refresh the capacity
+	if (const int32* Existing = EntryLookup.Find(Resource))
+	{
+		FEntry& Entry = Entries[*Existing];
+		if (Entry.TypeIndex == TypeIndex && Entry.Cell == Cell)
+		{
+			Entry.Location = Location;
+			Entry.Capacity = Capacity;
+			return;
+		}
+		RemoveEntry(*Existing);
+	}
+
+	if (!Grids.IsValidIndex(TypeIndex))
+	{
+		Grids.SetNum(TypeIndex + 1);
+	}
+
+	const int32 EntryIndex = FreeEntries.Num() > 0 ? FreeEntries.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Actor = Resource;
+	Entry.Location = Location;
+	Entry.Cell = Cell;
+	Entry.TypeIndex = TypeIndex;
+	Entry.Capacity = Capacity;
+	Entry.Occupants = 0;
+
+	FTypeGrid& Grid = Grids[TypeIndex];
+	Grid.Cells.FindOrAdd(Cell).Add(EntryIndex);
+	Grid.MinCell = FIntPoint(FMath::Min(Grid.MinCell.X, Cell.X), FMath::Min(Grid.MinCell.Y, Cell.Y));
+	Grid.MaxCell = FIntPoint(FMath::Max(Grid.MaxCell.X, Cell.X), FMath::Max(Grid.MaxCell.Y, Cell.Y));
+	Grid.Num++;
+
+	EntryLookup.Add(Resource, EntryIndex);
+}
+
+void UResourceSpatialIndex::UnregisterResource(ARTS_Actor* Resource)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (EntryLookup.RemoveAndCopyValue(Resource, EntryIndex))
+	{
+		RemoveEntry(EntryIndex);
+	}
+}
+
+void UResourceSpatialIndex::RemoveEntry(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	if (Grids.IsValidIndex(Entry.TypeIndex))
+	{
+		FTypeGrid& Grid = Grids[Entry.TypeIndex];
+		if (TArray<int32>* Cell = Grid.Cells.Find(Entry.Cell))
+		{
+			Cell->RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+			if (Cell->Num() == 0)
+			{
+				Grid.Cells.Remove(Entry.Cell);
+			}
+		}
+		// Bounds only grow, they just limit how far an unbounded ring search walks
+		Grid.Num--;
+	}
+
+	Entry = FEntry();
+	FreeEntries.Add(EntryIndex);
+}
+
+void UResourceSpatialIndex::AddOccupant(ARTS_Actor* Resource)
+{
+	if (const int32* EntryIndex = EntryLookup.Find(Resource))
+	{
+		Entries[*EntryIndex].Occupants++;
+	}
+}
+
+void UResourceSpatialIndex::RemoveOccupant(ARTS_Actor* Resource)
+{
+	if (const int32* EntryIndex = EntryLookup.Find(Resource))
+	{
+		Entries[*EntryIndex].Occupants = FMath::Max(0, Entries[*EntryIndex].Occupants - 1);
+	}
+}
+
+bool UResourceSpatialIndex::IsCandidate(const FEntry& Entry, bool bRequireFreeSlot, const TMap<int32, int32>* BatchReservations) const
+{
+	const ARTS_Actor* Actor = Entry.Actor.Get();
+	if (!Actor || Actor->IsInPool())
+	{
+		return false;
+	}
+	if (!bRequireFreeSlot)
+	{
+		return true;
+	}
+
+	int32 Occupants = Entry.Occupants;
+	if (BatchReservations)
+	{
+		const int32 EntryIndex = static_cast<int32>(&Entry - Entries.GetData());
+		if (const int32* Reserved = BatchReservations->Find(EntryIndex))
+		{
+			Occupants += *Reserved;
+		}
+	}
+	return Occupants < Entry.Capacity;
+}
+
+void UResourceSpatialIndex::FindNearestEntries(const FTypeGrid& Grid, const FVector& Origin, int32 K, float MaxRadius, bool bRequireFreeSlot,
+	const TMap<int32, int32>* BatchReservations, TArray<TPair<float, int32>, TInlineAllocator<8>>& OutEntries) const
+{
+	OutEntries.Reset();
+	if (Grid.Num <= 0 || K <= 0)
+	{
+		return;
+	}
+
+	const FIntPoint OriginCell = GetCell(Origin);
+	const float MaxRadiusSquared = MaxRadius > 0.f ? FMath::Square(MaxRadius) : MAX_flt;
+
+	// Furthest ring that can still hold anything: the radius limit or the grid bounds
+	int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(OriginCell.X - Grid.MinCell.X), FMath::Abs(Grid.MaxCell.X - OriginCell.X)),
+		FMath::Max(FMath::Abs(OriginCell.Y - Grid.MinCell.Y), FMath::Abs(Grid.MaxCell.Y - OriginCell.Y)));
+	if (MaxRadius > 0.f)
+	{
+		MaxRing = FMath::Min(MaxRing, FMath::CeilToInt32(MaxRadius / CellSize));
+	}
+
+	auto VisitCell = [&](const FIntPoint& Cell)
+	{
+		const TArray<int32>* CellEntries = Grid.Cells.Find(Cell);
+		if (!CellEntries)
+		{
+			return;
+		}
+		for (const int32 EntryIndex : *CellEntries)
+		{
+			const FEntry& Entry = Entries[EntryIndex];
+			const float DistanceSquared = FVector::DistSquared2D(Entry.Location, Origin);
+			if (DistanceSquared > MaxRadiusSquared || !IsCandidate(Entry, bRequireFreeSlot, BatchReservations))
+			{
+				continue;
+			}
+			if (OutEntries.Num() == K && DistanceSquared >= OutEntries.Last().Key)
+			{
+				continue;
+			}
+
+			// Insertion into the small sorted result set
+			int32 InsertAt = OutEntries.Num();
+			while (InsertAt > 0 && OutEntries[InsertAt - 1].Key > DistanceSquared)
+			{
+				--InsertAt;
+			}
+			OutEntries.Insert(TPair<float, int32>(DistanceSquared, EntryIndex), InsertAt);
+			if (OutEntries.Num() > K)
+			{
+				OutEntries.Pop(EAllowShrinking::No);
+			}
+		}
+	};
+
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		if (Ring == 0)
+		{
+			VisitCell(OriginCell);
+		}
+		else
+		{
+			for (int32 Offset = -Ring; Offset <= Ring; ++Offset)
+			{
+				VisitCell(FIntPoint(OriginCell.X + Offset, OriginCell.Y - Ring));
+				VisitCell(FIntPoint(OriginCell.X + Offset, OriginCell.Y + Ring));
+			}
+			for (int32 Offset = -Ring + 1; Offset <= Ring - 1; ++Offset)
+			{
+				VisitCell(FIntPoint(OriginCell.X - Ring, OriginCell.Y + Offset));
+				VisitCell(FIntPoint(OriginCell.X + Ring, OriginCell.Y + Offset));
+			}
+		}
+
+		// Anything in the next ring is at least Ring cells away
+		if (OutEntries.Num() == K && OutEntries.Last().Key <= FMath::Square(Ring * CellSize))
+		{
+			break;
+		}
+	}
+}
+
+void UResourceSpatialIndex::FindNearest(EResourceType ResourceType, const FVector& Origin, int32 K, float MaxRadius, bool bRequireFreeSlot, TArray<ARTS_Actor*>& OutResources) const
+{
+	OutResources.Reset();
+	const FTypeGrid* Grid = FindGrid(ResourceType);
+	if (!Grid)
+	{
+		return;
+	}
+
+	TArray<TPair<float, int32>, TInlineAllocator<8>> Found;
+	FindNearestEntries(*Grid, Origin, K, MaxRadius, bRequireFreeSlot, nullptr, Found);
+	for (const TPair<float, int32>& Pair : Found)
+	{
+		OutResources.Add(Entries[Pair.Value].Actor.Get());
+	}
+}
+
+void UResourceSpatialIndex::FindInRadius(EResourceType ResourceType, const FVector& Origin, float Radius, bool bRequireFreeSlot, TArray<ARTS_Actor*>& OutResources) const
+{
+	OutResources.Reset();
+	const FTypeGrid* Grid = FindGrid(ResourceType);
+	if (!Grid || Radius <= 0.f)
+	{
+		return;
+	}
+
+	const float RadiusSquared = FMath::Square(Radius);
+	const FIntPoint MinCell = GetCell(Origin - FVector(Radius, Radius, 0.f));
+	const FIntPoint MaxCell = GetCell(Origin + FVector(Radius, Radius, 0.f));
+	for (int32 X = FMath::Max(MinCell.X, Grid->MinCell.X); X <= FMath::Min(MaxCell.X, Grid->MaxCell.X); ++X)
+	{
+		for (int32 Y = FMath::Max(MinCell.Y, Grid->MinCell.Y); Y <= FMath::Min(MaxCell.Y, Grid->MaxCell.Y); ++Y)
+		{
+			const TArray<int32>* CellEntries = Grid->Cells.Find(FIntPoint(X, Y));
+			if (!CellEntries)
+			{
+				continue;
+			}
+			for (const int32 EntryIndex : *CellEntries)
+			{
+				const FEntry& Entry = Entries[EntryIndex];
+				if (FVector::DistSquared2D(Entry.Location, Origin) <= RadiusSquared && IsCandidate(Entry, bRequireFreeSlot, nullptr))
+				{
+					OutResources.Add(Entry.Actor.Get());
+				}
+			}
+		}
+	}
+}
+
+void UResourceSpatialIndex::FindNearestBatch(EResourceType ResourceType, const TArray<FVector>& Origins, float MaxRadius, bool bRequireFreeSlot, TArray<ARTS_Actor*>& OutResources) const
+{
+	OutResources.Reset();
+	OutResources.SetNumZeroed(Origins.Num());
+	const FTypeGrid* Grid = FindGrid(ResourceType);
+	if (!Grid)
+	{
+		return;
+	}
+
+	TMap<int32, int32> BatchReservations;
+	TArray<TPair<float, int32>, TInlineAllocator<8>> Found;
+	for (int32 OriginIndex = 0; OriginIndex < Origins.Num(); ++OriginIndex)
+	{
+		FindNearestEntries(*Grid, Origins[OriginIndex], 1, MaxRadius, bRequireFreeSlot, &BatchReservations, Found);
+		if (Found.Num() > 0)
+		{
+			OutResources[OriginIndex] = Entries[Found[0].Value].Actor.Get();
+			if (bRequireFreeSlot)
+			{
+				BatchReservations.FindOrAdd(Found[0].Value)++;
+			}
+		}
+	}
+}
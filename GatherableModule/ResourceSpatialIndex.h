@@ -0,0 +1,90 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ResourceType.h"
+#include "UObject/ObjectKey.h"
+#include "ResourceSpatialIndex.generated.h"
+
+class ARTS_Actor;
+
+/**
+ * Uniform grid of every active actor with a UGatherableModule, one grid per EResourceType.
+ * Gatherable modules register themselves when they become active and unregister on depletion or pooling,
+ * gather methods report slot occupancy so queries can skip resources without a free gathering slot.
+ */
+UCLASS()
+class FINALRTS_API UResourceSpatialIndex : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UResourceSpatialIndex* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	/** Adds or moves Resource. Capacity is the number of workers that can gather from it at once */
+	void RegisterResource(ARTS_Actor* Resource, EResourceType ResourceType, int32 Capacity);
+	void UnregisterResource(ARTS_Actor* Resource);
+
+	/** Slot bookkeeping, called when a worker takes or frees a gathering slot on Resource */
+	void AddOccupant(ARTS_Actor* Resource);
+	void RemoveOccupant(ARTS_Actor* Resource);
+
+	/** Up to K resources of ResourceType ordered by distance. MaxRadius <= 0 searches the whole grid */
+	UFUNCTION(BlueprintCallable, Category = "Resource Spatial Index")
+	void FindNearest(EResourceType ResourceType, const FVector& Origin, int32 K, float MaxRadius, bool bRequireFreeSlot, TArray<ARTS_Actor*>& OutResources) const;
+
+	/** Every resource of ResourceType within Radius, unordered */
+	UFUNCTION(BlueprintCallable, Category = "Resource Spatial Index")
+	void FindInRadius(EResourceType ResourceType, const FVector& Origin, float Radius, bool bRequireFreeSlot, TArray<ARTS_Actor*>& OutResources) const;
+
+	/**
+	 * Nearest resource per origin in one call, e.g. for a group of idle workers.
+	 * With bRequireFreeSlot each answer reserves a slot for the rest of the batch, so a group spreads over
+	 * several resources instead of piling onto one. Entries are null where nothing was found.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Resource Spatial Index")
+	void FindNearestBatch(EResourceType ResourceType, const TArray<FVector>& Origins, float MaxRadius, bool bRequireFreeSlot, TArray<ARTS_Actor*>& OutResources) const;
+
+	UFUNCTION(BlueprintPure, Category = "Resource Spatial Index")
+	int32 GetNumResources() const { return EntryLookup.Num(); }
+
+	/** Grid cell edge length, roughly the typical gather search radius */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Resource Spatial Index")
+	float CellSize = 2000.f;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<ARTS_Actor> Actor;
+		FVector Location = FVector::ZeroVector;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		int32 TypeIndex = INDEX_NONE;
+		int32 Capacity = 0;
+		int32 Occupants = 0;
+	};
+
+	struct FTypeGrid
+	{
+		TMap<FIntPoint, TArray<int32>> Cells;
+		FIntPoint MinCell = FIntPoint(MAX_int32, MAX_int32);
+		FIntPoint MaxCell = FIntPoint(MIN_int32, MIN_int32);
+		int32 Num = 0;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+	FTypeGrid* FindGrid(EResourceType ResourceType);
+	const FTypeGrid* FindGrid(EResourceType ResourceType) const;
+	void RemoveEntry(int32 EntryIndex);
+	bool IsCandidate(const FEntry& Entry, bool bRequireFreeSlot, const TMap<int32, int32>* BatchReservations) const;
+
+	/** Ring search shared by FindNearest and FindNearestBatch, OutEntries is sorted by distance */
+	void FindNearestEntries(const FTypeGrid& Grid, const FVector& Origin, int32 K, float MaxRadius, bool bRequireFreeSlot,
+		const TMap<int32, int32>* BatchReservations, TArray<TPair<float, int32>, TInlineAllocator<8>>& OutEntries) const;
+
+	TArray<FEntry> Entries;
+	TArray<int32> FreeEntries;
+	TMap<TObjectKey<ARTS_Actor>, int32> EntryLookup;
+	TArray<FTypeGrid> Grids;
+};
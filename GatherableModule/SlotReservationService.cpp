@@ -0,0 +1,408 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "SlotReservationService.h"
+#include "GatherableModule.h"
+#include "RTS_Actor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld GDumpSlotReservationCommand(
+	TEXT("RTS.Slots.Dump"),
+	TEXT("Logs occupancy, lending and utilization counters of the gathering slot service."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const USlotReservationService* Service = USlotReservationService::Get(World))
+		{
+			Service->DumpStats();
+		}
+	}));
+
+USlotReservationService* USlotReservationService::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<USlotReservationService>() : nullptr;
+}
+
+void USlotReservationService::Deinitialize()
+{
+	ResourceSlots.Empty();
+	FreeResourceSlots.Empty();
+	ResourceLookup.Empty();
+	WorkerSlots.Empty();
+
+	Super::Deinitialize();
+}
+
+double USlotReservationService::GetServiceTime() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+int32 USlotReservationService::FindOrAddResource(ARTS_Actor* Resource)
+{
+	if (const int32* Existing = ResourceLookup.Find(Resource))
+	{
+		return *Existing;
+	}
+
+	const UGatherableModule* Gatherable = Resource->GetModule<UGatherableModule>();
+	if (!Gatherable)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("USlotReservationService - %s has no UGatherableModule"), *Resource->GetName());
+		return INDEX_NONE;
+	}
+
+	const int32 NumSlots = FMath::Clamp(Gatherable->GetMaxGatherers(), 1, MaxSlotsPerResource);
+	const int32 ResourceIndex = FreeResourceSlots.Num() > 0 ? FreeResourceSlots.Pop(EAllowShrinking::No) : ResourceSlots.AddDefaulted();
+
+	FResourceSlots& Slots = ResourceSlots[ResourceIndex];
+	Slots.Resource = Resource;
+	Slots.SlotMask = NumSlots == 64 ? ~0ull : ((1ull << NumSlots) - 1);
+	Slots.OccupiedBits = 0;
+	Slots.ReservedBits = 0;
+	Slots.Holders.Init(TObjectKey<ARTS_Actor>(), NumSlots);
+
+	// Evenly spaced ring just outside the node, widened until large rings (Plentiful/Mega nodes) keep MinSlotSpacing
+	const FVector Center = Resource->GetActorLocation();
+	const float Radius = FMath::Max(Resource->GetSimpleCollisionRadius() + SlotStandOffDistance, NumSlots * MinSlotSpacing / (2.f * PI));
+	Slots.Locations.Reset(NumSlots);
+	for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+	{
+		const float Angle = 2.f * PI * SlotIndex / NumSlots;
+		Slots.Locations.Add(Center + FVector(FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius, 0.f));
+	}
+
+	const double Now = GetServiceTime();
+	Slots.TrackingStartTime = Now;
+	Slots.LastChangeTime = Now;
+	Slots.OccupiedSlotSeconds = 0.0;
+
+	ResourceLookup.Add(Resource, ResourceIndex);
+	return ResourceIndex;
+}
+
+void USlotReservationService::UnregisterResource(ARTS_Actor* Resource)
+{
+	int32 ResourceIndex = INDEX_NONE;
+	if (!Resource || !ResourceLookup.RemoveAndCopyValue(Resource, ResourceIndex))
+	{
+		return;
+	}
+
+	FResourceSlots& Slots = ResourceSlots[ResourceIndex];
+	for (const TObjectKey<ARTS_Actor>& Holder : Slots.Holders)
+	{
+		const FSlotRef* HeldSlot = WorkerSlots.Find(Holder);
+		if (HeldSlot && HeldSlot->ResourceIndex == ResourceIndex)
+		{
+			WorkerSlots.Remove(Holder);
+		}
+	}
+
+	Slots = FResourceSlots();
+	FreeResourceSlots.Add(ResourceIndex);
+}
+
+void USlotReservationService::AccumulateUtilization(FResourceSlots& Slots, double Now) const
+{
+	Slots.OccupiedSlotSeconds += FMath::CountBits(Slots.OccupiedBits) * (Now - Slots.LastChangeTime);
+	Slots.LastChangeTime = Now;
+}
+
+int32 USlotReservationService::PickClosestSlot(const FResourceSlots& Slots, uint64 CandidateBits, const FVector& Location)
+{
+	int32 BestSlot = INDEX_NONE;
+	double BestDistanceSquared = TNumericLimits<double>::Max();
+	while (CandidateBits)
+	{
+		const int32 SlotIndex = static_cast<int32>(FMath::CountTrailingZeros64(CandidateBits));
+		CandidateBits &= CandidateBits - 1;
+
+		const double DistanceSquared = FVector::DistSquared2D(Slots.Locations[SlotIndex], Location);
+		if (DistanceSquared < BestDistanceSquared)
+		{
+			BestDistanceSquared = DistanceSquared;
+			BestSlot = SlotIndex;
+		}
+	}
+	return BestSlot;
+}
+
+void USlotReservationService::PurgeStaleHolders(FResourceSlots& Slots, double Now)
+{
+	uint64 HeldBits = (Slots.OccupiedBits | Slots.ReservedBits) & Slots.SlotMask;
+	while (HeldBits)
+	{
+		const int32 SlotIndex = static_cast<int32>(FMath::CountTrailingZeros64(HeldBits));
+		HeldBits &= HeldBits - 1;
+
+		const TObjectKey<ARTS_Actor> Holder = Slots.Holders[SlotIndex];
+		if (!Holder.ResolveObjectPtr())
+		{
+			AccumulateUtilization(Slots, Now);
+			WorkerSlots.Remove(Holder);
+			Slots.OccupiedBits &= ~(1ull << SlotIndex);
+			Slots.ReservedBits &= ~(1ull << SlotIndex);
+			Slots.Holders[SlotIndex] = TObjectKey<ARTS_Actor>();
+		}
+	}
+}
+
+int32 USlotReservationService::SelectSlot(int32 ResourceIndex, ARTS_Actor* Worker)
+{
+	// A claim that survived the deposit trip is still ours, lending it would have dropped the record
+	const FSlotRef* HeldSlot = WorkerSlots.Find(Worker);
+	if (HeldSlot && HeldSlot->ResourceIndex == ResourceIndex)
+	{
+		return HeldSlot->SlotIndex;
+	}
+
+	const FResourceSlots& Slots = ResourceSlots[ResourceIndex];
+	const FVector WorkerLocation = Worker->GetActorLocation();
+
+	const uint64 FreeBits = Slots.SlotMask & ~(Slots.OccupiedBits | Slots.ReservedBits);
+	if (FreeBits)
+	{
+		return PickClosestSlot(Slots, FreeBits, WorkerLocation);
+	}
+
+	const uint64 LendableBits = Slots.ReservedBits & ~Slots.OccupiedBits;
+	return PickClosestSlot(Slots, LendableBits, WorkerLocation);
+}
+
+void USlotReservationService::ClaimSlot(int32 ResourceIndex, int32 SlotIndex, ARTS_Actor* Worker)
+{
+	const double Now = GetServiceTime();
+	const uint64 SlotBit = 1ull << SlotIndex;
+
+	if (const FSlotRef* HeldSlot = WorkerSlots.Find(Worker))
+	{
+		if (HeldSlot->ResourceIndex == ResourceIndex && HeldSlot->SlotIndex == SlotIndex)
+		{
+			// Back from a deposit trip or simply gathering again
+			FResourceSlots& Slots = ResourceSlots[ResourceIndex];
+			if (!(Slots.OccupiedBits & SlotBit))
+			{
+				AccumulateUtilization(Slots, Now);
+				Slots.OccupiedBits |= SlotBit;
+				Slots.ReservedBits &= ~SlotBit;
+			}
+			return;
+		}
+
+		// Moving to another node
+		ClearSlot(*HeldSlot);
+		Releases++;
+	}
+
+	FResourceSlots& Slots = ResourceSlots[ResourceIndex];
+	AccumulateUtilization(Slots, Now);
+
+	if (Slots.ReservedBits & SlotBit)
+	{
+		// Lend: the away holder loses its claim and picks a slot like everyone else when it returns
+		WorkerSlots.Remove(Slots.Holders[SlotIndex]);
+		Lends++;
+	}
+
+	Slots.OccupiedBits |= SlotBit;
+	Slots.ReservedBits &= ~SlotBit;
+	Slots.Holders[SlotIndex] = Worker;
+
+	FSlotRef& SlotRef = WorkerSlots.Add(Worker);
+	SlotRef.ResourceIndex = ResourceIndex;
+	SlotRef.SlotIndex = SlotIndex;
+	Reservations++;
+}
+
+void USlotReservationService::ClearSlot(const FSlotRef& SlotRef)
+{
+	if (!ResourceSlots.IsValidIndex(SlotRef.ResourceIndex))
+	{
+		return;
+	}
+
+	FResourceSlots& Slots = ResourceSlots[SlotRef.ResourceIndex];
+	AccumulateUtilization(Slots, GetServiceTime());
+
+	const uint64 SlotBit = 1ull << SlotRef.SlotIndex;
+	Slots.OccupiedBits &= ~SlotBit;
+	Slots.ReservedBits &= ~SlotBit;
+	Slots.Holders[SlotRef.SlotIndex] = TObjectKey<ARTS_Actor>();
+}
+
+bool USlotReservationService::ReserveSlot(ARTS_Actor* Worker, ARTS_Actor* Resource, FVector& OutLocation)
+{
+	OutLocation = FVector::ZeroVector;
+	if (!Worker || !Resource || Resource->IsInPool())
+	{
+		return false;
+	}
+
+	const int32 ResourceIndex = FindOrAddResource(Resource);
+	if (ResourceIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	PurgeStaleHolders(ResourceSlots[ResourceIndex], GetServiceTime());
+
+	const int32 SlotIndex = SelectSlot(ResourceIndex, Worker);
+	if (SlotIndex == INDEX_NONE)
+	{
+		Failures++;
+		return false;
+	}
+
+	ClaimSlot(ResourceIndex, SlotIndex, Worker);
+	OutLocation = ResourceSlots[ResourceIndex].Locations[SlotIndex];
+	return true;
+}
+
+int32 USlotReservationService::ReserveSlots(ARTS_Actor* Resource, const TArray<ARTS_Actor*>& Workers, TArray<FVector>& OutLocations, TArray<bool>& OutReserved)
+{
+	OutLocations.Init(FVector::ZeroVector, Workers.Num());
+	OutReserved.Init(false, Workers.Num());
+	if (!Resource || Resource->IsInPool())
+	{
+		return 0;
+	}
+
+	const int32 ResourceIndex = FindOrAddResource(Resource);
+	if (ResourceIndex == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	// One lookup and purge for the whole group, each claim updates the bitsets the next worker selects from
+	PurgeStaleHolders(ResourceSlots[ResourceIndex], GetServiceTime());
+
+	int32 NumReserved = 0;
+	for (int32 WorkerIndex = 0; WorkerIndex < Workers.Num(); ++WorkerIndex)
+	{
+		ARTS_Actor* Worker = Workers[WorkerIndex];
+		const int32 SlotIndex = Worker ? SelectSlot(ResourceIndex, Worker) : INDEX_NONE;
+		if (SlotIndex == INDEX_NONE)
+		{
+			Failures += Worker ? 1 : 0;
+			continue;
+		}
+
+		ClaimSlot(ResourceIndex, SlotIndex, Worker);
+		OutLocations[WorkerIndex] = ResourceSlots[ResourceIndex].Locations[SlotIndex];
+		OutReserved[WorkerIndex] = true;
+		NumReserved++;
+	}
+	return NumReserved;
+}
+
+void USlotReservationService::SuspendSlot(ARTS_Actor* Worker)
+{
+	const FSlotRef* HeldSlot = WorkerSlots.Find(Worker);
+	if (!HeldSlot)
+	{
+		return;
+	}
+
+	FResourceSlots& Slots = ResourceSlots[HeldSlot->ResourceIndex];
+	AccumulateUtilization(Slots, GetServiceTime());
+
+	const uint64 SlotBit = 1ull << HeldSlot->SlotIndex;
+	Slots.OccupiedBits &= ~SlotBit;
+	Slots.ReservedBits |= SlotBit;
+}
+
+void USlotReservationService::ReleaseSlot(ARTS_Actor* Worker)
+{
+	FSlotRef HeldSlot;
+	if (Worker && WorkerSlots.RemoveAndCopyValue(Worker, HeldSlot))
+	{
+		ClearSlot(HeldSlot);
+		Releases++;
+	}
+}
+
+bool USlotReservationService::GetHeldSlot(const ARTS_Actor* Worker, ARTS_Actor*& OutResource, int32& OutSlotIndex) const
+{
+	const FSlotRef* HeldSlot = WorkerSlots.Find(Worker);
+	OutResource = HeldSlot ? ResourceSlots[HeldSlot->ResourceIndex].Resource.Get() : nullptr;
+	OutSlotIndex = HeldSlot ? HeldSlot->SlotIndex : INDEX_NONE;
+	return OutResource != nullptr;
+}
+
+bool USlotReservationService::GetSlotLocation(const ARTS_Actor* Resource, int32 SlotIndex, FVector& OutLocation) const
+{
+	const int32* ResourceIndex = ResourceLookup.Find(Resource);
+	if (!ResourceIndex || !ResourceSlots[*ResourceIndex].Locations.IsValidIndex(SlotIndex))
+	{
+		return false;
+	}
+
+	OutLocation = ResourceSlots[*ResourceIndex].Locations[SlotIndex];
+	return true;
+}
+
+int32 USlotReservationService::GetAvailableSlots(ARTS_Actor* Resource) const
+{
+	const int32* ResourceIndex = ResourceLookup.Find(Resource);
+	if (!ResourceIndex)
+	{
+		// Not touched yet, every slot is free
+		const UGatherableModule* Gatherable = Resource ? Resource->GetModule<UGatherableModule>() : nullptr;
+		return Gatherable ? FMath::Clamp(Gatherable->GetMaxGatherers(), 1, MaxSlotsPerResource) : 0;
+	}
+
+	const FResourceSlots& Slots = ResourceSlots[*ResourceIndex];
+	return FMath::CountBits(Slots.SlotMask & ~Slots.OccupiedBits);
+}
+
+float USlotReservationService::GetResourceUtilization(ARTS_Actor* Resource) const
+{
+	const int32* ResourceIndex = ResourceLookup.Find(Resource);
+	if (!ResourceIndex)
+	{
+		return 0.f;
+	}
+
+	const FResourceSlots& Slots = ResourceSlots[*ResourceIndex];
+	const double Now = GetServiceTime();
+	const double Available = FMath::CountBits(Slots.SlotMask) * (Now - Slots.TrackingStartTime);
+	const double Occupied = Slots.OccupiedSlotSeconds + FMath::CountBits(Slots.OccupiedBits) * (Now - Slots.LastChangeTime);
+	return Available > 0.0 ? static_cast<float>(Occupied / Available) : 0.f;
+}
+
+FSlotReservationStats USlotReservationService::GetStats() const
+{
+	FSlotReservationStats Stats;
+	Stats.Reservations = Reservations;
+	Stats.Lends = Lends;
+	Stats.Failures = Failures;
+	Stats.Releases = Releases;
+
+	const double Now = GetServiceTime();
+	double AvailableSlotSeconds = 0.0;
+	double OccupiedSlotSeconds = 0.0;
+	for (const TPair<TObjectKey<ARTS_Actor>, int32>& Pair : ResourceLookup)
+	{
+		const FResourceSlots& Slots = ResourceSlots[Pair.Value];
+		const int32 NumSlots = FMath::CountBits(Slots.SlotMask);
+		Stats.Resources++;
+		Stats.TotalSlots += NumSlots;
+		Stats.OccupiedSlots += FMath::CountBits(Slots.OccupiedBits);
+		Stats.ReservedSlots += FMath::CountBits(Slots.ReservedBits);
+
+		AvailableSlotSeconds += NumSlots * (Now - Slots.TrackingStartTime);
+		OccupiedSlotSeconds += Slots.OccupiedSlotSeconds + FMath::CountBits(Slots.OccupiedBits) * (Now - Slots.LastChangeTime);
+	}
+	Stats.Utilization = AvailableSlotSeconds > 0.0 ? static_cast<float>(OccupiedSlotSeconds / AvailableSlotSeconds) : 0.f;
+	return Stats;
+}
+
+void USlotReservationService::DumpStats() const
+{
+	const FSlotReservationStats Stats = GetStats();
+	UE_LOG(LogTemp, Log, TEXT("USlotReservationService - %d resources, %d slots, %d occupied, %d reserved, utilization %.1f%%"),
+		Stats.Resources, Stats.TotalSlots, Stats.OccupiedSlots, Stats.ReservedSlots, Stats.Utilization * 100.f);
+	UE_LOG(LogTemp, Log, TEXT("  reservations %d, lends %d, failures %d, releases %d"), Stats.Reservations, Stats.Lends, Stats.Failures, Stats.Releases);
+}
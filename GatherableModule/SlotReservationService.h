@@ -0,0 +1,163 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SlotReservationService.generated.h"
+
+class ARTS_Actor;
+
+USTRUCT(BlueprintType)
+struct FSlotReservationStats
+{
+	GENERATED_BODY()
+
+	/** Resources with a slot layout */
+	UPROPERTY(BlueprintReadOnly, Category = "Slot Reservation")
+	int32 Resources = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Slot Reservation")
+	int32 TotalSlots = 0;
+
+	/** Slots whose holder stands at or walks to them */
+	UPROPERTY(BlueprintReadOnly, Category = "Slot Reservation")
+	int32 OccupiedSlots = 0;
+
+	/** Slots whose holder is away on a deposit trip, these can be lent out */
+	UPROPERTY(BlueprintReadOnly, Category = "Slot Reservation")
+	int32 ReservedSlots = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Slot Reservation")
+	int32 Reservations = 0;
+
+	/** Reservations served by taking over the slot of a worker on a deposit trip */
+	UPROPERTY(BlueprintReadOnly, Category = "Slot Reservation")
+	int32 Lends = 0;
+
+	/** Reservations that found neither a free nor a lendable slot */
+	UPROPERTY(BlueprintReadOnly, Category = "Slot Reservation")
+	int32 Failures = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Slot Reservation")
+	int32 Releases = 0;
+
+	/** Occupied slot-seconds over available slot-seconds of the active resources, 0..1 */
+	UPROPERTY(BlueprintReadOnly, Category = "Slot Reservation")
+	float Utilization = 0.f;
+};
+
+/**
+ * World level owner of every gathering slot around resource nodes.
+ * Slot state is two packed bitsets per resource: Occupied (holder is there or on its way) and Reserved (holder is
+ * away on a deposit trip). A reservation takes the free slot closest to the worker and falls back to lending a
+ * Reserved slot, so a node keeps its gatherers busy while some of them walk to a drop-off.
+ * The layout is a ring of UGatherableModule::GetMaxGatherers() slots around the node, up to MaxSlotsPerResource.
+ */
+UCLASS()
+class FINALRTS_API USlotReservationService : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static USlotReservationService* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	/** Hard limit of one 64 bit word per bitset */
+	static constexpr int32 MaxSlotsPerResource = 64;
+
+	/**
+	 * Gives Worker a slot on Resource and returns where to stand. A worker that already holds a slot there gets
+	 * the same one back unless it was lent out meanwhile. Any slot the worker holds elsewhere is released
+	 */
+	bool ReserveSlot(ARTS_Actor* Worker, ARTS_Actor* Resource, FVector& OutLocation);
+
+	/**
+	 * Reserves slots for several workers on one resource in a single pass. OutLocations matches Workers,
+	 * OutReserved flags who got a slot. Returns the number of workers that got one
+	 */
+	int32 ReserveSlots(ARTS_Actor* Resource, const TArray<ARTS_Actor*>& Workers, TArray<FVector>& OutLocations, TArray<bool>& OutReserved);
+
+	/** Keeps the worker's claim while it is away, the slot may be lent to another worker until it returns */
+	void SuspendSlot(ARTS_Actor* Worker);
+
+	void ReleaseSlot(ARTS_Actor* Worker);
+
+	/** Drops the layout of a depleted or pooled resource and every claim on it */
+	void UnregisterResource(ARTS_Actor* Resource);
+
+	/** Resource and slot index the worker holds, false without a claim */
+	bool GetHeldSlot(const ARTS_Actor* Worker, ARTS_Actor*& OutResource, int32& OutSlotIndex) const;
+
+	/** World position of a slot, false when the resource has no layout or the index is out of range */
+	bool GetSlotLocation(const ARTS_Actor* Resource, int32 SlotIndex, FVector& OutLocation) const;
+
+	/** Slots a reservation on Resource could be served from right now, free plus lendable */
+	UFUNCTION(BlueprintPure, Category = "Slot Reservation")
+	int32 GetAvailableSlots(ARTS_Actor* Resource) const;
+
+	UFUNCTION(BlueprintPure, Category = "Slot Reservation")
+	float GetResourceUtilization(ARTS_Actor* Resource) const;
+
+	UFUNCTION(BlueprintPure, Category = "Slot Reservation")
+	FSlotReservationStats GetStats() const;
+
+	void DumpStats() const;
+
+	/** Distance between the node's collision radius and the slot ring */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Slot Reservation")
+	float SlotStandOffDistance = 60.f;
+
+	/** Smallest distance between neighbouring slots, large rings move out to keep it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Slot Reservation")
+	float MinSlotSpacing = 80.f;
+
+private:
+	struct FResourceSlots
+	{
+		TWeakObjectPtr<ARTS_Actor> Resource;
+		uint64 SlotMask = 0;
+		uint64 OccupiedBits = 0;
+		uint64 ReservedBits = 0;
+		TArray<TObjectKey<ARTS_Actor>, TInlineAllocator<8>> Holders;
+		TArray<FVector, TInlineAllocator<8>> Locations;
+
+		/** Utilization bookkeeping, occupied slot-seconds are integrated on every state change */
+		double TrackingStartTime = 0.0;
+		double LastChangeTime = 0.0;
+		double OccupiedSlotSeconds = 0.0;
+	};
+
+	struct FSlotRef
+	{
+		int32 ResourceIndex = INDEX_NONE;
+		int32 SlotIndex = INDEX_NONE;
+	};
+
+	int32 FindOrAddResource(ARTS_Actor* Resource);
+	double GetServiceTime() const;
+	void AccumulateUtilization(FResourceSlots& Slots, double Now) const;
+
+	/** Closest slot in CandidateBits to Location, INDEX_NONE when the set is empty */
+	static int32 PickClosestSlot(const FResourceSlots& Slots, uint64 CandidateBits, const FVector& Location);
+
+	/** Claims the slot for Worker, taking it over from a holder on a deposit trip if needed */
+	void ClaimSlot(int32 ResourceIndex, int32 SlotIndex, ARTS_Actor* Worker);
+	void ClearSlot(const FSlotRef& SlotRef);
+
+	/** Best slot for Worker on the resource honouring its previous claim, INDEX_NONE if the node is full */
+	int32 SelectSlot(int32 ResourceIndex, ARTS_Actor* Worker);
+
+	/** Frees slots whose holder was destroyed without releasing them */
+	void PurgeStaleHolders(FResourceSlots& Slots, double Now);
+
+	TArray<FResourceSlots> ResourceSlots;
+	TArray<int32> FreeResourceSlots;
+	TMap<TObjectKey<ARTS_Actor>, int32> ResourceLookup;
+	TMap<TObjectKey<ARTS_Actor>, FSlotRef> WorkerSlots;
+
+	int32 Reservations = 0;
+	int32 Lends = 0;
+	int32 Failures = 0;
+	int32 Releases = 0;
+};
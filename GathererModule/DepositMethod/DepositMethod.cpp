@@ -1,33 +1,83 @@
-﻿// DepositMethod.cpp
-#include "DepositMethod.h"
-
-void UDepositMethod::InitializeDepositMethod(UGathererModule* Gatherer)
-{
-	GathererModule = Gatherer;
-}
-
-void UDepositMethod::Deposit()
-{
-	// Intentionally left empty in base class
-}
-
-FVector UDepositMethod::GetDepositLocation()
-{
-	// Base implementation - return zero vector
-	return FVector::ZeroVector;
-	// This will use DepositModule later which will be different modules returning different locations (from building, from slot, etc.)
-}
-
-void UDepositMethod::CompleteDepositing()
-{
-	// Base implementation - empty
-}
-
-void UDepositMethod::StopDeposit()
-{
-	// Clear any active timers
-	if (GathererModule && GathererModule->GetWorld())
-	{
-		GathererModule->GetWorld()->GetTimerManager().ClearTimer(DepositTimer);
-	}
+﻿// DepositMethod.cpp
+#include "DepositMethod.h"
+#include "DepositModule/DepositPointIndex.h"
+#include "TeamComponent/TeamComponent.h"
+#include "GathererModule/Economy/TeamResourceLedger.h"
+
+void UDepositMethod::InitializeDepositMethod(UGathererModule* Gatherer)
+{
+	GathererModule = Gatherer;
+}
+
+void UDepositMethod::Deposit()
+{
+	// Intentionally left empty in base class
+}
+
+FVector UDepositMethod::GetDepositLocation()
+{
+	if (!GathererModule || !GathererModule->Owner)
+	{
+		return FVector::ZeroVector;
+	}
+
+	// Drop-off point of the worker's team for what it carries by travel and queue time, kept between trips
+	UDepositPointIndex* PointIndex = UDepositPointIndex::Get(GathererModule->Owner);
+	if (!PointIndex)
+	{
+		return FVector::ZeroVector;
+	}
+
+	const UTeamComponent* TeamComponent = GathererModule->Owner->FindComponentByClass<UTeamComponent>();
+	const int32 Team = TeamComponent ? TeamComponent->GetTeamIndex() : 0;
+
+	FVector DepositLocation;
+	ARTS_Actor* DepositBuilding;
+	if (!PointIndex->AcquireDeposit(GathererModule->Owner, Team, GathererModule->CurrentResourceType, GathererModule->Owner->GetActorLocation(), DepositLocation, DepositBuilding))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UDepositMethod::GetDepositLocation - No drop-off for team %d on %s"), Team, *GathererModule->Owner->GetName());
+		return FVector::ZeroVector;
+	}
+	return DepositLocation;
+}
+
+bool UDepositMethod::DepositCarriedResources()
+{
+	ReleaseDepositPoint();
+
+	UTeamResourceLedger* Ledger = GathererModule ? UTeamResourceLedger::Get(GathererModule) : nullptr;
+	if (!Ledger || !Ledger->AddDeposit(GathererModule->Owner, GathererModule->CurrentResourceType, GathererModule->CurrentResourceAmount))
+	{
+		return false;
+	}
+
+	if (GathererModule->CurrentResourceAmount > 0)
+	{
+		GathererModule->ResourceDeposited(GathererModule->CurrentResourceAmount, GathererModule->CurrentResourceType);
+	}
+	return true;
+}
+
+void UDepositMethod::CompleteDepositing()
+{
+	// Base implementation - empty
+}
+
+void UDepositMethod::ReleaseDepositPoint()
+{
+	if (UDepositPointIndex* PointIndex = GathererModule ? UDepositPointIndex::Get(GathererModule) : nullptr)
+	{
+		PointIndex->ReleaseInbound(GathererModule->Owner);
+	}
+}
+
+void UDepositMethod::StopDeposit()
+{
+	ReleaseDepositPoint();
+
+	// Clear any active timers
+	if (URTS_ModuleScheduler* Scheduler = URTS_ModuleScheduler::Get(GathererModule))
+	{
+		Scheduler->Cancel(DepositTimer);
+	}
 }
\ No newline at end of file
@@ -1,32 +1,41 @@
-﻿// DepositMethod.h
-#pragma once
-
-#include "AIController.h"
-#include "RTS_Actor.h"
-#include "GathererModule/GathererModule.h"
-#include "Navigation/PathFollowingComponent.h"
-#include "TimerManager.h"
-#include "DepositMethod.generated.h"
-
-UCLASS(Abstract, Blueprintable, EditInlineNew)
-class DRAKTHYSPROJECT_API UDepositMethod : public UObject
-{
-	GENERATED_BODY()
-
-public:
-	void InitializeDepositMethod(UGathererModule* Gatherer);
-
-	UPROPERTY()
-	UGathererModule* GathererModule;
-	
-	virtual void Deposit();
-	virtual void StopDeposit();
-	virtual void CompleteDepositing();
-	
-	virtual FVector GetDepositLocation();
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	bool bDrawDebugPath;
-
-	FTimerHandle DepositTimer;
-};
+﻿// DepositMethod.h
+#pragma once
+
+#include "AIController.h"
+#include "RTS_Actor.h"
+#include "GathererModule/GathererModule.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "RTS_ModuleScheduler.h"
+#include "DepositMethod.generated.h"
+
+UCLASS(Abstract, Blueprintable, EditInlineNew)
+class DRAKTHYSPROJECT_API UDepositMethod : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void InitializeDepositMethod(UGathererModule* Gatherer);
+
+	UPROPERTY()
+	UGathererModule* GathererModule;
+	
+	virtual void Deposit();
+	virtual void StopDeposit();
+	virtual void CompleteDepositing();
+	
+	virtual FVector GetDepositLocation();
+
+	/**
+	 * Hands what the worker carries to the team resource ledger, which commits it at the end of the frame.
+	 * Returns false if the worker has no player resources to deposit into.
+	 */
+	bool DepositCarriedResources();
+
+	/** Stops counting the worker as inbound to its drop-off point */
+	void ReleaseDepositPoint();
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bDrawDebugPath;
+
+	FRTSScheduleHandle DepositTimer;
+};
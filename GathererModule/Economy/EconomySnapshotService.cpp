@@ -0,0 +1,377 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "EconomySnapshotService.h"
+#include "GathererEconomyLOD.h"
+#include "TeamResourceLedger.h"
+#include "RTS_Actor.h"
+#include "RTS_Stats.h"
+#include "GathererModule/GathererModule.h"
+#include "GathererModule/GatherMethod/GatherMethod_001.h"
+#include "GathererModule/GatherMethod/GatherMethod_002.h"
+#include "GatherableModule/GatherableModule.h"
+#include "RecruitmentModule/RecruitmentModule.h"
+#include "DepositModule/DepositDistanceField.h"
+#include "TeamComponent/TeamComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Tasks/Task.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// Capture, then play the unchanged economy forward on the task graph and log what each team would bank
+static FAutoConsoleCommandWithWorldAndArgs GEconomySnapshotCommand(
+	TEXT("RTS.Economy.Snapshot"),
+	TEXT("Captures the economy, simulates it ahead on a background task and logs deposits per team. Usage: RTS.Economy.Snapshot [Seconds]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UEconomySnapshotService* SnapshotService = UEconomySnapshotService::Get(World);
+		if (!SnapshotService) return;
+
+		const float Horizon = Args.Num() > 0 ? FMath::Max(1.f, FCString::Atof(*Args[0])) : 60.f;
+		const TSharedRef<const FEconomyWorldSnapshot> Source = SnapshotService->Capture();
+
+		TArray<FEconomyBranchSetup> Setups;
+		Setups.Add([](const FEconomyWorldSnapshot&, RTSEconomy::FEconomySnapshot&) {});
+		SnapshotService->SimulateBranchesAsync(Source, MoveTemp(Setups), Horizon, [Source, Horizon](TArray<RTSEconomy::FEconomySnapshot>&& Branches)
+		{
+			const RTSEconomy::FEconomySnapshot& Branch = Branches[0];
+			UE_LOG(LogTemp, Log, TEXT("UEconomySnapshotService - %.0fs ahead: %lld harvests, %lld deposits, %lld pages copied"),
+				Horizon, Branch.GetHarvests(), Branch.GetDeposits(), Branch.GetPagesCopied());
+
+			TSet<int32> Teams;
+			for (int32 Index = 0; Index < Branch.NumGatherers(); ++Index)
+			{
+				Teams.Add(Branch.GetGatherer(Index).Team);
+			}
+
+			const UEnum* ResourceEnum = StaticEnum<EResourceType>();
+			const int32 NumResourceTypes = ResourceEnum ? ResourceEnum->NumEnums() - 1 : 0;
+			for (const int32 Team : Teams)
+			{
+				for (int32 TypeIndex = 0; TypeIndex < NumResourceTypes; ++TypeIndex)
+				{
+					const uint8 ResourceType = static_cast<uint8>(ResourceEnum->GetValueByIndex(TypeIndex));
+					const int64 Before = Source->Snapshot.GetDeposited(Team, ResourceType);
+					const int64 After = Branch.GetDeposited(Team, ResourceType);
+					if (After != Before)
+					{
+						UE_LOG(LogTemp, Log, TEXT("  Team %d %s: %lld -> %lld"), Team, *ResourceEnum->GetNameStringByIndex(TypeIndex), Before, After);
+					}
+				}
+			}
+		});
+	}));
+
+namespace EconomySnapshot
+{
+	static int32 GetTeam(const ARTS_Actor* Actor)
+	{
+		const UTeamComponent* TeamComponent = Actor ? Actor->FindComponentByClass<UTeamComponent>() : nullptr;
+		return TeamComponent ? TeamComponent->GetTeamIndex() : 0;
+	}
+}
+
+int32 FEconomyWorldSnapshot::FindGatherer(const UGathererModule* Gatherer) const
+{
+	return Gatherers.IndexOfByPredicate([Gatherer](const TWeakObjectPtr<UGathererModule>& Entry) { return Entry.Get() == Gatherer; });
+}
+
+int32 FEconomyWorldSnapshot::FindNode(const UGatherableModule* Node) const
+{
+	return Nodes.IndexOfByPredicate([Node](const TWeakObjectPtr<UGatherableModule>& Entry) { return Entry.Get() == Node; });
+}
+
+float FEconomyWorldSnapshot::GetTravelTime(int32 GathererIndex, int32 NodeIndex) const
+{
+	if (!GathererLocations.IsValidIndex(GathererIndex) || !NodeLocations.IsValidIndex(NodeIndex))
+	{
+		return 0.f;
+	}
+	return FVector::Dist2D(GathererLocations[GathererIndex], NodeLocations[NodeIndex]) / FMath::Max(GathererMoveSpeeds[GathererIndex], 1.f);
+}
+
+UEconomySnapshotService* UEconomySnapshotService::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UEconomySnapshotService>() : nullptr;
+}
+
+void UEconomySnapshotService::Deinitialize()
+{
+	// Branches still in flight only hold their own snapshots, their completion sees the service gone
+	Stats = FEconomySnapshotServiceStats();
+	Super::Deinitialize();
+}
+
+TSharedRef<const FEconomyWorldSnapshot> UEconomySnapshotService::Capture()
+{
+	RTS_MODULE_SCOPE(STAT_RTS_EconomySnapshotCapture);
+	check(IsInGameThread());
+
+	TSharedRef<FEconomyWorldSnapshot> Result = MakeShared<FEconomyWorldSnapshot>();
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return Result;
+	}
+	Result->WorldTime = World->GetTimeSeconds();
+	Result->Snapshot.DepositTime = DepositTime;
+
+	// Nodes first, gatherers refer to them by index
+	TMap<TObjectKey<UGatherableModule>, int32> NodeLookup;
+	TArray<UGathererModule*> Gatherers;
+	for (TActorIterator<ARTS_Actor> It(World); It; ++It)
+	{
+		ARTS_Actor* Actor = *It;
+		if (Actor->IsInPool())
+		{
+			continue;
+		}
+
+		if (UGatherableModule* Gatherable = Actor->GetModule<UGatherableModule>())
+		{
+			RTSEconomy::FSnapshotNode Node;
+			Node.Amount = Gatherable->CurrentResourceAmount;
+			Node.Stack = Gatherable->ResourceStack;
+			Node.GatheringTime = Gatherable->GatheringTime;
+			Node.ResourceType = static_cast<uint8>(Gatherable->ResourceType);
+			NodeLookup.Add(Gatherable, Result->Snapshot.AddNode(Node));
+			Result->Nodes.Add(Gatherable);
+			Result->NodeLocations.Add(Actor->GetActorLocation());
+		}
+		if (URecruitmentModule* Recruitment = Actor->GetModule<URecruitmentModule>())
+		{
+			CaptureProducer(Recruitment, *Result);
+		}
+		if (UGathererModule* Gatherer = Actor->GetModule<UGathererModule>())
+		{
+			Gatherers.Add(Gatherer);
+		}
+	}
+
+	for (UGathererModule* Gatherer : Gatherers)
+	{
+		CaptureGatherer(Gatherer, NodeLookup, *Result);
+	}
+
+	if (const UTeamResourceLedger* Ledger = UTeamResourceLedger::Get(this))
+	{
+		TMap<int32, TArray<int64>> Totals;
+		Ledger->GetDepositedTotals(Totals);
+		for (const TPair<int32, TArray<int64>>& Pair : Totals)
+		{
+			for (int32 TypeIndex = 0; TypeIndex < Pair.Value.Num(); ++TypeIndex)
+			{
+				Result->Snapshot.AddDeposited(Pair.Key, static_cast<uint8>(TypeIndex), Pair.Value[TypeIndex]);
+			}
+		}
+	}
+
+	Stats.Captures++;
+	Stats.LastGatherers = Result->Snapshot.NumGatherers();
+	Stats.LastNodes = Result->Snapshot.NumNodes();
+	Stats.LastProducers = Result->Snapshot.NumProducers();
+	return Result;
+}
+
+void UEconomySnapshotService::CaptureGatherer(UGathererModule* Gatherer, const TMap<TObjectKey<UGatherableModule>, int32>& NodeLookup, FEconomyWorldSnapshot& OutSnapshot) const
+{
+	const ARTS_Actor* Worker = Gatherer->Owner;
+	if (!Worker)
+	{
+		return;
+	}
+
+	RTSEconomy::FSnapshotGatherer Snapshot;
+	Snapshot.Team = EconomySnapshot::GetTeam(Worker);
+	Snapshot.State.CarriedAmount = Gatherer->CurrentResourceAmount;
+	Snapshot.State.CarriedType = static_cast<uint8>(Gatherer->CurrentResourceType);
+
+	// Other gather methods are played back as one node stack per trip
+	if (const UGatherMethod_001* Method001 = Cast<UGatherMethod_001>(Gatherer->GatherMethod))
+	{
+		Snapshot.Policy = Method001->GetGatherPolicy();
+		Snapshot.State.Stored = Method001->CurrentGatheredStacks;
+	}
+	else if (const UGatherMethod_002* Method002 = Cast<UGatherMethod_002>(Gatherer->GatherMethod))
+	{
+		Snapshot.Policy = Method002->GetGatherPolicy();
+		Snapshot.State.Stored = Method002->CurrentStoredUnits;
+	}
+
+	const APawn* WorkerPawn = Cast<APawn>(Worker);
+	const UPawnMovementComponent* Movement = WorkerPawn ? WorkerPawn->GetMovementComponent() : nullptr;
+	const float MoveSpeed = Movement && Movement->GetMaxSpeed() > 0.f ? Movement->GetMaxSpeed() : DefaultMoveSpeed;
+	const FVector WorkerLocation = Worker->GetActorLocation();
+
+	// A fast-forwarded worker is parked at its slot, its loop position comes from the economy LOD
+	FGathererLoopPhase LoopPhase;
+	const UGathererEconomyLOD* EconomyLOD = Gatherer->IsInEconomyLOD() ? UGathererEconomyLOD::Get(this) : nullptr;
+	const bool bFastForwarded = EconomyLOD && EconomyLOD->GetLoopPhase(Gatherer, LoopPhase);
+
+	const ARTS_Actor* Target = Gatherer->TargetResource.Get();
+	const UGatherableModule* Node = bFastForwarded ? LoopPhase.Node.Get() : (Target ? Target->GetModule<UGatherableModule>() : nullptr);
+	const int32* NodeIndex = Node ? NodeLookup.Find(Node) : nullptr;
+	Snapshot.Node = NodeIndex ? *NodeIndex : INDEX_NONE;
+	const FVector NodeLocation = NodeIndex ? OutSnapshot.NodeLocations[*NodeIndex] : WorkerLocation;
+	const EResourceType NodeType = Node ? Node->ResourceType : Gatherer->CurrentResourceType;
+
+	// Measured trip timings on this node when there are any, distance field estimates otherwise
+	const FGatherLoopSample& Sample = Gatherer->GetLoopSample();
+	if (bFastForwarded)
+	{
+		Snapshot.ToDepositTime = FMath::Max(LoopPhase.OutboundTime - DepositTime, 0.f);
+		Snapshot.ToNodeTime = LoopPhase.ReturnTime;
+	}
+	else if (Node && Sample.IsMeasured() && Sample.Target.Get() == Node->Owner)
+	{
+		Snapshot.ToDepositTime = FMath::Max(Sample.OutboundTime - DepositTime, 0.f);
+		Snapshot.ToNodeTime = Sample.ReturnTime;
+	}
+	else
+	{
+		Snapshot.ToDepositTime = EstimateDepositTime(Snapshot.Team, NodeType, NodeLocation, MoveSpeed, 0.f);
+		Snapshot.ToNodeTime = Snapshot.ToDepositTime;
+	}
+
+	if (bFastForwarded)
+	{
+		// Method-local storage the same way RestoreSteadyStateProgress would rebuild it
+		Snapshot.State.CarriedAmount = LoopPhase.Carried;
+		Snapshot.State.CarriedType = static_cast<uint8>(LoopPhase.ResourceType);
+		Snapshot.State.Stored = Snapshot.Policy.Storage == RTSEconomy::EGatherStorage::Stacks ? LoopPhase.HarvestsDone : LoopPhase.Carried;
+		Snapshot.TimeLeft = LoopPhase.TimeLeft;
+		if (LoopPhase.bAtNode)
+		{
+			Snapshot.Phase = RTSEconomy::ESnapshotPhase::Gathering;
+		}
+		else if (!LoopPhase.bDeposited)
+		{
+			Snapshot.Phase = RTSEconomy::ESnapshotPhase::ToDeposit;
+			Snapshot.TimeLeft = FMath::Max(LoopPhase.TimeLeft - DepositTime, 0.f);
+		}
+		else
+		{
+			Snapshot.Phase = RTSEconomy::ESnapshotPhase::ToNode;
+		}
+	}
+	else if (Gatherer->CurrentState == EGathererState::Gathering)
+	{
+		if (Gatherer->GatherMethod && Gatherer->GatherMethod->IsGathering())
+		{
+			float CurrentTime = 0.f;
+			float RequiredTime = 0.f;
+			Gatherer->GetGatheringProgress(CurrentTime, RequiredTime);
+			Snapshot.Phase = RTSEconomy::ESnapshotPhase::Gathering;
+			Snapshot.TimeLeft = FMath::Max(RequiredTime - CurrentTime, 0.f);
+		}
+		else
+		{
+			Snapshot.Phase = RTSEconomy::ESnapshotPhase::ToNode;
+			Snapshot.TimeLeft = FVector::Dist2D(WorkerLocation, NodeLocation) / MoveSpeed;
+		}
+	}
+	else if (Gatherer->CurrentState == EGathererState::Depositing)
+	{
+		Snapshot.Phase = RTSEconomy::ESnapshotPhase::ToDeposit;
+		Snapshot.TimeLeft = EstimateDepositTime(Snapshot.Team, Gatherer->CurrentResourceType, WorkerLocation, MoveSpeed, Snapshot.ToDepositTime);
+	}
+
+	OutSnapshot.Snapshot.AddGatherer(Snapshot);
+	OutSnapshot.Gatherers.Add(Gatherer);
+	OutSnapshot.GathererLocations.Add(WorkerLocation);
+	OutSnapshot.GathererMoveSpeeds.Add(MoveSpeed);
+}
+
+void UEconomySnapshotService::CaptureProducer(URecruitmentModule* Recruitment, FEconomyWorldSnapshot& OutSnapshot) const
+{
+	RTSEconomy::FSnapshotProducer Producer;
+	Producer.Team = EconomySnapshot::GetTeam(Recruitment->Owner);
+	for (const UUnitDataAsset* Unit : Recruitment->GetProductionQueue())
+	{
+		if (Unit)
+		{
+			Producer.Queue.Enqueue(Unit->ProductionData.ProductionTime);
+		}
+	}
+
+	// The head of the queue is the unit in production, snapshot time 0 is now
+	if (Recruitment->HasActiveProgress() && Producer.Queue.Num() > 0)
+	{
+		RTSEconomy::StartProduction(Producer.Queue.State, -Recruitment->GetProductionTimeSpent(), Producer.Queue.TimesNeeded[0]);
+	}
+
+	OutSnapshot.Snapshot.AddProducer(Producer);
+	OutSnapshot.Producers.Add(Recruitment);
+}
+
+float UEconomySnapshotService::EstimateDepositTime(int32 Team, EResourceType ResourceType, const FVector& From, float MoveSpeed, float Fallback) const
+{
+	const UDepositDistanceField* DistanceField = UDepositDistanceField::Get(this);
+	FVector DepositLocation;
+	float TravelCost = 0.f;
+	ARTS_Actor* Building = nullptr;
+	if (!DistanceField || !DistanceField->FindBestDeposit(Team, ResourceType, From, DepositLocation, TravelCost, Building))
+	{
+		return Fallback;
+	}
+	return TravelCost / FMath::Max(MoveSpeed, 1.f);
+}
+
+void UEconomySnapshotService::SimulateBranchesAsync(const TSharedRef<const FEconomyWorldSnapshot>& Source, TArray<FEconomyBranchSetup> Setups, float Horizon, FOnEconomyBranchesSimulated OnComplete)
+{
+	check(IsInGameThread());
+	if (Setups.Num() == 0)
+	{
+		return;
+	}
+
+	TWeakObjectPtr<UEconomySnapshotService> WeakThis(this);
+	const float BranchStepTime = StepTime;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Source, Setups = MoveTemp(Setups), Horizon, BranchStepTime, OnComplete = MoveTemp(OnComplete)]() mutable
+	{
+		TArray<RTSEconomy::FEconomySnapshot> Branches;
+		Branches.SetNum(Setups.Num());
+
+		// Each branch owns its fork, the source pages are only read
+		ParallelFor(Branches.Num(), [&Branches, &Setups, &Source, Horizon, BranchStepTime](int32 BranchIndex)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_RTS_EconomySnapshotBranch);
+			RTSEconomy::FEconomySnapshot& Branch = Branches[BranchIndex];
+			Branch = Source->Snapshot.Fork();
+			if (Setups[BranchIndex])
+			{
+				Setups[BranchIndex](*Source, Branch);
+			}
+			Branch.Simulate(Horizon, BranchStepTime);
+		});
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Branches = MoveTemp(Branches), OnComplete = MoveTemp(OnComplete)]() mutable
+		{
+			UEconomySnapshotService* SnapshotService = WeakThis.Get();
+			if (!SnapshotService)
+			{
+				return;
+			}
+
+			SnapshotService->Stats.BranchesSimulated += Branches.Num();
+			for (const RTSEconomy::FEconomySnapshot& Branch : Branches)
+			{
+				SnapshotService->Stats.PagesCopied += Branch.GetPagesCopied();
+			}
+			if (OnComplete)
+			{
+				OnComplete(MoveTemp(Branches));
+			}
+		});
+	});
+}
+
+void UEconomySnapshotService::DumpStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("UEconomySnapshotService - %lld captures, %lld branches simulated, %lld pages copied. Last capture: %d gatherers, %d nodes, %d producers"),
+		Stats.Captures, Stats.BranchesSimulated, Stats.PagesCopied, Stats.LastGatherers, Stats.LastNodes, Stats.LastProducers);
+}
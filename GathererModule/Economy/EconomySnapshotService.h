@@ -0,0 +1,122 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ResourceType.h"
+#include "EconomyCore/EconomySnapshot.h"
+#include "EconomySnapshotService.generated.h"
+
+class ARTS_Actor;
+class UGathererModule;
+class UGatherableModule;
+class URecruitmentModule;
+
+USTRUCT(BlueprintType)
+struct FEconomySnapshotServiceStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Snapshot")
+	int64 Captures = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Snapshot")
+	int64 BranchesSimulated = 0;
+
+	/** Copy-on-write pages the simulated branches had to copy, the rest stayed shared with their capture */
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Snapshot")
+	int64 PagesCopied = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Snapshot")
+	int32 LastGatherers = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Snapshot")
+	int32 LastNodes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy Snapshot")
+	int32 LastProducers = 0;
+};
+
+/** A captured economy: the engine-independent snapshot plus what its indices stand for in the world */
+struct DRAKTHYSPROJECT_API FEconomyWorldSnapshot
+{
+	RTSEconomy::FEconomySnapshot Snapshot;
+
+	/** World time of the capture, snapshot time 0 */
+	double WorldTime = 0.0;
+
+	/** Indexed like the snapshot's gatherers, nodes and producers */
+	TArray<TWeakObjectPtr<UGathererModule>> Gatherers;
+	TArray<TWeakObjectPtr<UGatherableModule>> Nodes;
+	TArray<TWeakObjectPtr<URecruitmentModule>> Producers;
+
+	/** Positions and speeds at capture time, for the travel times of what-if orders */
+	TArray<FVector> GathererLocations;
+	TArray<float> GathererMoveSpeeds;
+	TArray<FVector> NodeLocations;
+
+	int32 FindGatherer(const UGathererModule* Gatherer) const;
+	int32 FindNode(const UGatherableModule* Node) const;
+
+	/** Straight-line travel time of a gatherer from its captured position to a node */
+	float GetTravelTime(int32 GathererIndex, int32 NodeIndex) const;
+};
+
+/** Prepares one branch, e.g. retasks workers. Runs on a worker thread, must not touch UObjects */
+using FEconomyBranchSetup = TFunction<void(const FEconomyWorldSnapshot& Source, RTSEconomy::FEconomySnapshot& Branch)>;
+
+/** Simulated branches in the order of their setups, called on the game thread */
+using FOnEconomyBranchesSimulated = TFunction<void(TArray<RTSEconomy::FEconomySnapshot>&& Branches)>;
+
+/**
+ * Economy snapshots for AI look-ahead.
+ * Capture reads gatherers (state, carried amount and type, loop timings), resource nodes, recruitment queues with
+ * the time spent on their current unit, and the team ledger into an RTSEconomy::FEconomySnapshot. Nothing in the
+ * world is written. Branches are forks of a capture that share its copy-on-write pages, they are set up and
+ * stepped on the task graph and only the pages a branch changes get copied.
+ */
+UCLASS()
+class DRAKTHYSPROJECT_API UEconomySnapshotService : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UEconomySnapshotService* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	/** Captures the current economy, game thread only */
+	TSharedRef<const FEconomyWorldSnapshot> Capture();
+
+	/**
+	 * Forks Source once per setup and simulates every branch Horizon seconds ahead on background tasks.
+	 * OnComplete is dropped if the world goes away first.
+	 */
+	void SimulateBranchesAsync(const TSharedRef<const FEconomyWorldSnapshot>& Source, TArray<FEconomyBranchSetup> Setups, float Horizon, FOnEconomyBranchesSimulated OnComplete);
+
+	UFUNCTION(BlueprintPure, Category = "Economy Snapshot")
+	FEconomySnapshotServiceStats GetStats() const { return Stats; }
+
+	void DumpStats() const;
+
+	/** Step length of branch simulations. Within a step, workers sharing a node are served in gatherer order, not by finish time */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy Snapshot", meta = (ClampMin = "0.01"))
+	float StepTime = 0.25f;
+
+	/** Time spent at the drop-off, UInstantDeposit waits 0.5s */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy Snapshot", meta = (ClampMin = "0"))
+	float DepositTime = 0.5f;
+
+	/** Used for travel estimates of workers without a movement component */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy Snapshot", meta = (ClampMin = "1"))
+	float DefaultMoveSpeed = 300.f;
+
+private:
+	void CaptureGatherer(UGathererModule* Gatherer, const TMap<TObjectKey<UGatherableModule>, int32>& NodeLookup, FEconomyWorldSnapshot& OutSnapshot) const;
+	void CaptureProducer(URecruitmentModule* Recruitment, FEconomyWorldSnapshot& OutSnapshot) const;
+
+	/** Travel time from From to the team's closest drop-off for ResourceType, Fallback without a distance field */
+	float EstimateDepositTime(int32 Team, EResourceType ResourceType, const FVector& From, float MoveSpeed, float Fallback) const;
+
+	FEconomySnapshotServiceStats Stats;
+};
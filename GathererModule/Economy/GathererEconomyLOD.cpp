@@ -0,0 +1,537 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "GathererEconomyLOD.h"
+#include "TeamResourceLedger.h"
+#include "RTS_Actor.h"
+#include "RTS_Stats.h"
+#include "RTS_UIEventSubsystem.h"
+#include "GathererModule/GathererModule.h"
+#include "GathererModule/GatherMethod/GatherMethod.h"
+#include "GatherableModule/GatherableModule.h"
+#include "TeamComponent/TeamComponent.h"
+#include "Algo/StableSort.h"
+#include "GameFramework/PlayerState.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "SceneManagement.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld GDumpGathererEconomyLODCommand(
+	TEXT("RTS.Economy.DumpLOD"),
+	TEXT("Logs fast-forwarded gatherers, their analytic income and the economy LOD counters."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UGathererEconomyLOD* EconomyLOD = UGathererEconomyLOD::Get(World))
+		{
+			EconomyLOD->DumpStats();
+		}
+	}));
+
+UGathererEconomyLOD* UGathererEconomyLOD::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGathererEconomyLOD>() : nullptr;
+}
+
+void UGathererEconomyLOD::Deinitialize()
+{
+	Workers.Empty();
+	WorkerLookup.Empty();
+	Events.Empty();
+	HarvestRequests.Empty();
+	WakeList.Empty();
+	ViewFrustums.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UGathererEconomyLOD::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGathererEconomyLOD, STATGROUP_Tickables);
+}
+
+void UGathererEconomyLOD::FFastForwardWorker::RollLoop(FLoopCursor& InOutCursor, double Time) const
+{
+	const double Period = GetPeriod();
+	while (InOutCursor.HarvestsDone >= HarvestsPerTrip && InOutCursor.bDeposited && Time >= InOutCursor.LoopStartTime + Period)
+	{
+		InOutCursor.LoopStartTime += Period;
+		InOutCursor.HarvestsDone = 0;
+		InOutCursor.bDeposited = false;
+	}
+}
+
+double UGathererEconomyLOD::FFastForwardWorker::GetNextEventTime(const FLoopCursor& InCursor, bool& bOutDeposit) const
+{
+	bOutDeposit = false;
+	if (InCursor.HarvestsDone < HarvestsPerTrip)
+	{
+		return InCursor.LoopStartTime + (InCursor.HarvestsDone + 1) * GatheringTime;
+	}
+	if (!InCursor.bDeposited)
+	{
+		bOutDeposit = true;
+		return InCursor.LoopStartTime + HarvestsPerTrip * GatheringTime + OutboundTime;
+	}
+
+	// Trip done, first harvest of the next one
+	return InCursor.LoopStartTime + GetPeriod() + GatheringTime;
+}
+
+void UGathererEconomyLOD::Tick(float DeltaTime)
+{
+	UpdateViewFrustums();
+
+	Stats.FastForwarded = Workers.Num();
+	SET_DWORD_STAT(STAT_RTS_FastForwardedGatherers, Workers.Num());
+	if (Workers.Num() == 0)
+	{
+		return;
+	}
+
+	bool bWakeDue = false;
+	for (const FFastForwardWorker& Worker : Workers)
+	{
+		if (ShouldWake(Worker))
+		{
+			bWakeDue = true;
+			break;
+		}
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (!bWakeDue && Now < NextCreditTime)
+	{
+		return;
+	}
+
+	// Bring everyone up to date first so woken workers come back at their exact phase
+	CreditEvents(Now);
+	NextCreditTime = Now + CreditInterval;
+
+	// Crediting may have stalled workers on a depleted node. Walk backwards so swap removal keeps the rest valid
+	WakeList.Reset();
+	for (int32 WorkerIndex = Workers.Num() - 1; WorkerIndex >= 0; --WorkerIndex)
+	{
+		if (ShouldWake(Workers[WorkerIndex]))
+		{
+			WakeList.Add(WorkerIndex);
+		}
+	}
+	for (const int32 WorkerIndex : WakeList)
+	{
+		RehydrateAt(WorkerIndex, true);
+	}
+	Stats.FastForwarded = Workers.Num();
+}
+
+bool UGathererEconomyLOD::TryFastForward(UGathererModule* Gatherer)
+{
+	if (!Gatherer || Gatherer->IsInEconomyLOD() || WorkerLookup.Contains(Gatherer))
+	{
+		return false;
+	}
+
+	const FGatherLoopSample& Sample = Gatherer->GetLoopSample();
+	const UGatherMethod* Method = Gatherer->GatherMethod;
+	UGatherableModule* Node = Method ? Method->GatherableModule.Get() : nullptr;
+	if (!Sample.IsMeasured() || !Node || !Node->Owner || Sample.Target.Get() != Node->Owner || !IsEligible(Gatherer->Owner))
+	{
+		return false;
+	}
+
+	FFastForwardWorker Worker;
+	if (!Method->GetSteadyStateYield(Worker.HarvestsPerTrip, Worker.AmountPerHarvest))
+	{
+		return false;
+	}
+
+	Worker.Gatherer = Gatherer;
+	Worker.GathererKey = Gatherer;
+	Worker.Node = Node;
+	Worker.SlotLocation = Gatherer->Owner->GetActorLocation();
+	Worker.DepositLocation = Sample.DepositLocation;
+	Worker.GatheringTime = Node->GatheringTime;
+	Worker.OutboundTime = Sample.OutboundTime;
+	Worker.ReturnTime = Sample.ReturnTime;
+	Worker.ResourceType = Node->ResourceType;
+	Worker.Cursor.LoopStartTime = GetWorld()->GetTimeSeconds();
+	if (Worker.GatheringTime <= 0.f || Worker.GetPeriod() < MinLoopPeriod || IsLegInView(Worker.SlotLocation, Worker.DepositLocation))
+	{
+		return false;
+	}
+
+	WorkerLookup.Add(Gatherer, Workers.Add(MoveTemp(Worker)));
+	Gatherer->SetEconomyLODActive(true);
+	Stats.Collapses++;
+	Stats.FastForwarded = Workers.Num();
+	return true;
+}
+
+void UGathererEconomyLOD::Rehydrate(UGathererModule* Gatherer, bool bResume)
+{
+	if (!WorkerLookup.Contains(Gatherer))
+	{
+		if (Gatherer)
+		{
+			Gatherer->SetEconomyLODActive(false);
+		}
+		return;
+	}
+
+	CreditEvents(GetWorld()->GetTimeSeconds());
+	RehydrateAt(WorkerLookup.FindChecked(Gatherer), bResume);
+	Stats.FastForwarded = Workers.Num();
+}
+
+bool UGathererEconomyLOD::IsEligible(const ARTS_Actor* Worker) const
+{
+	if (!bEnabled || !Worker || Worker->IsInPool() || Worker->WasRecentlyRendered(VisibilityGraceTime))
+	{
+		return false;
+	}
+
+	if (Worker->IsSelected())
+	{
+		return false;
+	}
+
+	if (bIncludeHumanPlayers)
+	{
+		return true;
+	}
+	const UTeamComponent* TeamComponent = Worker->FindComponentByClass<UTeamComponent>();
+	const APlayerState* PlayerState = TeamComponent ? TeamComponent->GetPlayerOwner() : nullptr;
+	return PlayerState && PlayerState->IsABot();
+}
+
+bool UGathererEconomyLOD::ShouldWake(const FFastForwardWorker& Worker) const
+{
+	const UGathererModule* Gatherer = Worker.Gatherer.Get();
+	const UGatherableModule* Node = Worker.Node.Get();
+	if (!Gatherer || !Node || !Node->Owner || Node->Owner->IsInPool() || Worker.bStalled)
+	{
+		return true;
+	}
+
+	// Retargeted by someone who did not go through ExecuteGathererModule
+	if (Gatherer->TargetResource.Get() != Node->Owner)
+	{
+		return true;
+	}
+	return !IsEligible(Gatherer->Owner) || IsLegInView(Worker.SlotLocation, Worker.DepositLocation);
+}
+
+bool UGathererEconomyLOD::IsLegInView(const FVector& SlotLocation, const FVector& DepositLocation) const
+{
+	if (ViewFrustums.Num() == 0)
+	{
+		return false;
+	}
+
+	FBox LegBounds(ForceInit);
+	LegBounds += SlotLocation;
+	LegBounds += DepositLocation;
+	LegBounds = LegBounds.ExpandBy(VisibilityMargin);
+
+	const FVector Center = LegBounds.GetCenter();
+	const FVector Extent = LegBounds.GetExtent();
+	for (const FConvexVolume& Frustum : ViewFrustums)
+	{
+		if (Frustum.IntersectBox(Center, Extent))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UGathererEconomyLOD::UpdateViewFrustums()
+{
+	ViewFrustums.Reset();
+
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		const ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+		if (!LocalPlayer || !LocalPlayer->ViewportClient)
+		{
+			continue;
+		}
+
+		FSceneViewProjectionData ProjectionData;
+		if (LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+		{
+			GetViewFrustumBounds(ViewFrustums.AddDefaulted_GetRef(), ProjectionData.ComputeViewProjectionMatrix(), false);
+		}
+	}
+}
+
+void UGathererEconomyLOD::CreditEvents(double Now)
+{
+	RTS_MODULE_SCOPE(STAT_RTS_EconomyLOD);
+
+	while (CreditRound(Now))
+	{
+	}
+}
+
+bool UGathererEconomyLOD::CreditRound(double Now)
+{
+	// Everything that came due since the last round, in the order the real workers would have reached it
+	bool bMoreDue = false;
+	Events.Reset();
+	for (int32 WorkerIndex = 0; WorkerIndex < Workers.Num(); ++WorkerIndex)
+	{
+		const FFastForwardWorker& Worker = Workers[WorkerIndex];
+		if (Worker.bStalled)
+		{
+			continue;
+		}
+
+		FLoopCursor Cursor = Worker.Cursor;
+		for (;;)
+		{
+			Worker.RollLoop(Cursor, Now);
+			bool bDeposit = false;
+			const double EventTime = Worker.GetNextEventTime(Cursor, bDeposit);
+			if (EventTime > Now)
+			{
+				break;
+			}
+
+			Events.Add({ WorkerIndex, EventTime, bDeposit });
+			if (!bDeposit)
+			{
+				Cursor.HarvestsDone++;
+				continue;
+			}
+
+			// The deposit may be refused, the next trip's harvests wait for the next round
+			Cursor.bDeposited = true;
+			Worker.RollLoop(Cursor, Now);
+			bMoreDue |= Worker.GetNextEventTime(Cursor, bDeposit) <= Now;
+			break;
+		}
+	}
+
+	if (Events.Num() == 0)
+	{
+		return false;
+	}
+
+	UHarvestResolver* Resolver = UHarvestResolver::Get(this);
+	if (!Resolver)
+	{
+		return false;
+	}
+
+	Algo::StableSortBy(Events, [](const FLoopEvent& Event) { return Event.Time; });
+
+	// Harvests share nodes with the real workers, so they go through the same per-node resolution
+	HarvestRequests.Reset();
+	for (FLoopEvent& Event : Events)
+	{
+		if (!Event.bDeposit)
+		{
+			const FFastForwardWorker& Worker = Workers[Event.WorkerIndex];
+			Event.RequestIndex = HarvestRequests.Num();
+			FHarvestRequest& Request = HarvestRequests.AddDefaulted_GetRef();
+			Request.Node = Worker.Node;
+			Request.Requested = Worker.AmountPerHarvest;
+		}
+	}
+	Resolver->Resolve(HarvestRequests);
+
+	UTeamResourceLedger* Ledger = UTeamResourceLedger::Get(this);
+	for (const FLoopEvent& Event : Events)
+	{
+		FFastForwardWorker& Worker = Workers[Event.WorkerIndex];
+		if (Worker.bStalled)
+		{
+			continue;
+		}
+
+		Worker.RollLoop(Worker.Cursor, Event.Time);
+		if (Event.bDeposit)
+		{
+			const UGathererModule* Gatherer = Worker.Gatherer.Get();
+			if (Worker.Carried > 0 && (!Gatherer || !Ledger || !Ledger->AddDeposit(Gatherer->Owner, Worker.ResourceType, Worker.Carried)))
+			{
+				Worker.bStalled = true;
+				continue;
+			}
+			Worker.Cursor.bDeposited = true;
+			Worker.Carried = 0;
+			Stats.AnalyticDeposits++;
+		}
+		else
+		{
+			const FHarvestRequest& Request = HarvestRequests[Event.RequestIndex];
+			if (!Request.bHarvested)
+			{
+				Worker.bStalled = true;
+				continue;
+			}
+			Worker.Cursor.HarvestsDone++;
+			Worker.Carried += Request.Granted;
+			Worker.ResourceType = Request.ResourceType;
+			Stats.AnalyticHarvests++;
+		}
+	}
+	return bMoreDue;
+}
+
+void UGathererEconomyLOD::RehydrateAt(int32 WorkerIndex, bool bResume)
+{
+	const FFastForwardWorker Worker = Workers[WorkerIndex];
+	RemoveWorkerAt(WorkerIndex);
+
+	UGathererModule* Gatherer = Worker.Gatherer.Get();
+	if (!Gatherer || !Gatherer->Owner)
+	{
+		return;
+	}
+
+	Gatherer->SetEconomyLODActive(false);
+	Stats.Rehydrations++;
+
+	FLoopCursor Cursor = Worker.Cursor;
+	const double Now = GetWorld()->GetTimeSeconds();
+	Worker.RollLoop(Cursor, Now);
+	const float Phase = static_cast<float>(Now - Cursor.LoopStartTime);
+	const float GatherSpan = Worker.HarvestsPerTrip * Worker.GatheringTime;
+	const bool bAtNode = Cursor.HarvestsDone < Worker.HarvestsPerTrip;
+
+	// Away legs are placed along the straight line between slot and drop-off, the real path takes over from there
+	FVector Location = Worker.SlotLocation;
+	if (!bAtNode && !Cursor.bDeposited)
+	{
+		const float Alpha = FMath::Clamp((Phase - GatherSpan) / FMath::Max(Worker.OutboundTime, KINDA_SMALL_NUMBER), 0.f, 1.f);
+		Location = FMath::Lerp(Worker.SlotLocation, Worker.DepositLocation, Alpha);
+	}
+	else if (!bAtNode)
+	{
+		const float Alpha = FMath::Clamp((Phase - GatherSpan - Worker.OutboundTime) / FMath::Max(Worker.ReturnTime, KINDA_SMALL_NUMBER), 0.f, 1.f);
+		Location = FMath::Lerp(Worker.DepositLocation, Worker.SlotLocation, Alpha);
+	}
+	Gatherer->Owner->SetActorLocation(Location, false, nullptr, ETeleportType::TeleportPhysics);
+
+	Gatherer->CurrentResourceAmount = Worker.Carried;
+	Gatherer->CurrentResourceType = Worker.ResourceType;
+	if (Gatherer->GatherMethod)
+	{
+		Gatherer->GatherMethod->RestoreSteadyStateProgress(Cursor.HarvestsDone, Worker.Carried);
+	}
+	URTS_UIEventSubsystem::PostEvent(Gatherer->Owner, ERTSUIEvent::CarriedResourcesChanged);
+
+	if (!bResume)
+	{
+		return;
+	}
+
+	// A stalled worker re-enters through Gather(), which finds a new node or retries the deposit
+	if (Worker.bStalled || !Gatherer->GatherMethod)
+	{
+		Gatherer->RequestContinueGather();
+	}
+	else if (bAtNode)
+	{
+		Gatherer->GatherMethod->ResumeGathering(FMath::Max(Phase - Cursor.HarvestsDone * Worker.GatheringTime, KINDA_SMALL_NUMBER));
+	}
+	else if (!Cursor.bDeposited)
+	{
+		Gatherer->RequestDeposit();
+	}
+	else
+	{
+		Gatherer->RequestContinueGather();
+	}
+}
+
+void UGathererEconomyLOD::RemoveWorkerAt(int32 WorkerIndex)
+{
+	WorkerLookup.Remove(Workers[WorkerIndex].GathererKey);
+	Workers.RemoveAtSwap(WorkerIndex, 1, EAllowShrinking::No);
+	if (Workers.IsValidIndex(WorkerIndex))
+	{
+		WorkerLookup.Add(Workers[WorkerIndex].GathererKey, WorkerIndex);
+	}
+}
+
+bool UGathererEconomyLOD::GetLoopPhase(const UGathererModule* Gatherer, FGathererLoopPhase& OutPhase) const
+{
+	const int32* WorkerIndex = WorkerLookup.Find(Gatherer);
+	if (!WorkerIndex)
+	{
+		return false;
+	}
+
+	// Same cursor math as RehydrateAt, on a copy
+	const FFastForwardWorker& Worker = Workers[*WorkerIndex];
+	FLoopCursor Cursor = Worker.Cursor;
+	const double Now = GetWorld()->GetTimeSeconds();
+	Worker.RollLoop(Cursor, Now);
+	const float Phase = static_cast<float>(Now - Cursor.LoopStartTime);
+	const float GatherSpan = Worker.HarvestsPerTrip * Worker.GatheringTime;
+
+	OutPhase.Node = Worker.Node;
+	OutPhase.Carried = Worker.Carried;
+	OutPhase.ResourceType = Worker.ResourceType;
+	OutPhase.HarvestsDone = Cursor.HarvestsDone;
+	OutPhase.bAtNode = Cursor.HarvestsDone < Worker.HarvestsPerTrip;
+	OutPhase.bDeposited = Cursor.bDeposited;
+	OutPhase.OutboundTime = Worker.OutboundTime;
+	OutPhase.ReturnTime = Worker.ReturnTime;
+
+	float PhaseEnd = GatherSpan + Worker.OutboundTime + Worker.ReturnTime;
+	if (OutPhase.bAtNode)
+	{
+		PhaseEnd = (Cursor.HarvestsDone + 1) * Worker.GatheringTime;
+	}
+	else if (!Cursor.bDeposited)
+	{
+		PhaseEnd = GatherSpan + Worker.OutboundTime;
+	}
+	OutPhase.TimeLeft = FMath::Max(PhaseEnd - Phase, 0.f);
+	return true;
+}
+
+float UGathererEconomyLOD::GetIncomeRate(const UGathererModule* Gatherer) const
+{
+	const int32* WorkerIndex = WorkerLookup.Find(Gatherer);
+	if (!WorkerIndex)
+	{
+		return 0.f;
+	}
+
+	const FFastForwardWorker& Worker = Workers[*WorkerIndex];
+	return Worker.HarvestsPerTrip * Worker.AmountPerHarvest / FMath::Max(Worker.GetPeriod(), KINDA_SMALL_NUMBER);
+}
+
+void UGathererEconomyLOD::DumpStats() const
+{
+	float TotalIncome = 0.f;
+	for (const FFastForwardWorker& Worker : Workers)
+	{
+		TotalIncome += Worker.HarvestsPerTrip * Worker.AmountPerHarvest / FMath::Max(Worker.GetPeriod(), KINDA_SMALL_NUMBER);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UGathererEconomyLOD - %d fast-forwarded (%.2f units/s), %lld collapses, %lld rehydrations, %lld analytic harvests, %lld analytic deposits"),
+		Workers.Num(), TotalIncome, Stats.Collapses, Stats.Rehydrations, Stats.AnalyticHarvests, Stats.AnalyticDeposits);
+	for (const FFastForwardWorker& Worker : Workers)
+	{
+		const UGathererModule* Gatherer = Worker.Gatherer.Get();
+		UE_LOG(LogTemp, Log, TEXT("  %s: %d x %d per trip, gather %.2fs, out %.2fs, back %.2fs, carrying %d"),
+			Gatherer ? *GetNameSafe(Gatherer->Owner) : TEXT("None"), Worker.HarvestsPerTrip, Worker.AmountPerHarvest,
+			Worker.GatheringTime, Worker.OutboundTime, Worker.ReturnTime, Worker.Carried);
+	}
+}
@@ -0,0 +1,200 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ConvexVolume.h"
+#include "ResourceType.h"
+#include "GatherableModule/HarvestResolver.h"
+#include "GathererEconomyLOD.generated.h"
+
+class ARTS_Actor;
+class UGathererModule;
+class UGatherableModule;
+
+/** Where a fast-forwarded worker is in its loop, read without handing it back */
+struct FGathererLoopPhase
+{
+	TWeakObjectPtr<UGatherableModule> Node;
+	int32 Carried = 0;
+	EResourceType ResourceType = EResourceType::Wood;
+
+	/** Harvests done in the current trip */
+	int32 HarvestsDone = 0;
+	bool bAtNode = true;
+	bool bDeposited = false;
+
+	/** Seconds until the current harvest, outbound leg or return leg ends */
+	float TimeLeft = 0.f;
+
+	/** Measured node -> drop-off (including the deposit) and drop-off -> node times */
+	float OutboundTime = 0.f;
+	float ReturnTime = 0.f;
+};
+
+USTRUCT(BlueprintType)
+struct FGathererEconomyLODStats
+{
+	GENERATED_BODY()
+
+	/** Workers currently running their loop analytically */
+	UPROPERTY(BlueprintReadOnly, Category = "Economy LOD")
+	int32 FastForwarded = 0;
+
+	/** Workers handed over at the start of a loop */
+	UPROPERTY(BlueprintReadOnly, Category = "Economy LOD")
+	int64 Collapses = 0;
+
+	/** Workers handed back to the real simulation */
+	UPROPERTY(BlueprintReadOnly, Category = "Economy LOD")
+	int64 Rehydrations = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy LOD")
+	int64 AnalyticHarvests = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Economy LOD")
+	int64 AnalyticDeposits = 0;
+};
+
+/**
+ * Economy LOD for gatherers.
+ * Once a worker has done one real node -> deposit -> node trip, its loop is fully described by GatheringTime, the
+ * yield of its gather method and the measured outbound and return times. Unselected workers of AI players whose
+ * slot <-> drop-off leg is entirely off-screen are parked at their slot at the start of the next loop and the loop is
+ * played back on a clock: node harvests go through UHarvestResolver and deposits through UTeamResourceLedger at the
+ * times the real worker would have reached them, with no timers, path following or movement ticks. The worker is rehydrated to the exact phase
+ * of its loop when it becomes visible, gets selected, receives an order or its node goes away.
+ */
+UCLASS()
+class DRAKTHYSPROJECT_API UGathererEconomyLOD : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGathererEconomyLOD* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Takes the worker over if its loop is measured and it qualifies, called at the start of a gathering cycle */
+	bool TryFastForward(UGathererModule* Gatherer);
+
+	/** Hands the worker back at the current phase of its loop. Without bResume the worker is only restored, not restarted */
+	void Rehydrate(UGathererModule* Gatherer, bool bResume);
+
+	/** Loop position of a fast-forwarded worker at the current time, false if it runs the real simulation */
+	bool GetLoopPhase(const UGathererModule* Gatherer, FGathererLoopPhase& OutPhase) const;
+
+	/** Closed-form income of a fast-forwarded worker in units per second, 0 if it runs the real simulation */
+	UFUNCTION(BlueprintPure, Category = "Economy LOD")
+	float GetIncomeRate(const UGathererModule* Gatherer) const;
+
+	UFUNCTION(BlueprintPure, Category = "Economy LOD")
+	FGathererEconomyLODStats GetStats() const { return Stats; }
+
+	void DumpStats() const;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy LOD")
+	bool bEnabled = true;
+
+	/** Fast-forward human players' workers too, off by default so a player's own economy stays fully simulated */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy LOD")
+	bool bIncludeHumanPlayers = false;
+
+	/** A worker rendered within this many seconds counts as visible */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy LOD", meta = (ClampMin = "0"))
+	float VisibilityGraceTime = 0.5f;
+
+	/** Slot <-> drop-off bounds are grown by this before the view test, so a worker at the edge of its leg still counts */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy LOD", meta = (ClampMin = "0"))
+	float VisibilityMargin = 300.f;
+
+	/** How often analytic harvests and deposits are credited, events are credited late but never lost */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy LOD", meta = (ClampMin = "0"))
+	float CreditInterval = 0.25f;
+
+	/** Loops shorter than this stay in the real simulation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Economy LOD", meta = (ClampMin = "0.1"))
+	float MinLoopPeriod = 1.f;
+
+private:
+	/** Position inside a worker's loop, phase 0 is the start of the first harvest of a trip */
+	struct FLoopCursor
+	{
+		double LoopStartTime = 0.0;
+		int32 HarvestsDone = 0;
+		bool bDeposited = false;
+	};
+
+	struct FFastForwardWorker
+	{
+		TWeakObjectPtr<UGathererModule> Gatherer;
+		TObjectKey<UGathererModule> GathererKey;
+		TWeakObjectPtr<UGatherableModule> Node;
+		FVector SlotLocation = FVector::ZeroVector;
+		FVector DepositLocation = FVector::ZeroVector;
+		float GatheringTime = 0.f;
+		float OutboundTime = 0.f;
+		float ReturnTime = 0.f;
+		int32 HarvestsPerTrip = 0;
+		int32 AmountPerHarvest = 0;
+		FLoopCursor Cursor;
+		int32 Carried = 0;
+		EResourceType ResourceType = EResourceType::Wood;
+
+		/** Node ran dry or the deposit was refused, the real simulation takes it from here */
+		bool bStalled = false;
+
+		float GetPeriod() const { return HarvestsPerTrip * GatheringTime + OutboundTime + ReturnTime; }
+
+		/** Moves the cursor to the next trip once Time has passed the end of the current one */
+		void RollLoop(FLoopCursor& InOutCursor, double Time) const;
+
+		/** Time of the next harvest or deposit after Cursor */
+		double GetNextEventTime(const FLoopCursor& InCursor, bool& bOutDeposit) const;
+	};
+
+	/** A harvest or deposit due in the current credit pass */
+	struct FLoopEvent
+	{
+		int32 WorkerIndex = INDEX_NONE;
+		double Time = 0.0;
+		bool bDeposit = false;
+
+		/** Index into HarvestRequests for a harvest */
+		int32 RequestIndex = INDEX_NONE;
+	};
+
+	bool IsEligible(const ARTS_Actor* Worker) const;
+	bool ShouldWake(const FFastForwardWorker& Worker) const;
+
+	/** Parked workers are not where they would be, so visibility is tested on the whole leg they walk */
+	bool IsLegInView(const FVector& SlotLocation, const FVector& DepositLocation) const;
+	void UpdateViewFrustums();
+
+	void CreditEvents(double Now);
+
+	/**
+	 * Credits due events, each worker up to and including its next deposit. A refused deposit stalls the worker,
+	 * harvests past it must not be taken from the node yet. Returns true if a worker has more events due
+	 */
+	bool CreditRound(double Now);
+	void RehydrateAt(int32 WorkerIndex, bool bResume);
+	void RemoveWorkerAt(int32 WorkerIndex);
+
+	TArray<FFastForwardWorker> Workers;
+	TMap<TObjectKey<UGathererModule>, int32> WorkerLookup;
+
+	/** Scratch for CreditEvents, kept to avoid reallocating every pass */
+	TArray<FLoopEvent> Events;
+	TArray<FHarvestRequest> HarvestRequests;
+	TArray<int32> WakeList;
+
+	/** View frustums of the local players, refreshed every tick */
+	TArray<FConvexVolume> ViewFrustums;
+
+	double NextCreditTime = 0.0;
+
+	FGathererEconomyLODStats Stats;
+};
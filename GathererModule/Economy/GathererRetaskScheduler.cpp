@@ -0,0 +1,441 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "GathererRetaskScheduler.h"
+#include "RTS_Actor.h"
+#include "RTS_Stats.h"
+#include "GathererModule/GathererModule.h"
+#include "GathererModule/GatherMethod/GatherMethod.h"
+#include "GathererModule/DepositMethod/DepositMethod.h"
+#include "GatherableModule/GatherableModule.h"
+#include "GatherableModule/ResourceSpatialIndex.h"
+#include "GatherableModule/SlotReservationService.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld GDumpGathererRetaskCommand(
+	TEXT("RTS.Economy.DumpRetask"),
+	TEXT("Logs gatherers waiting for a retask, their backoff and the idle time counters."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UGathererRetaskScheduler* RetaskScheduler = UGathererRetaskScheduler::Get(World))
+		{
+			RetaskScheduler->DumpStats();
+		}
+	}));
+
+UGathererRetaskScheduler* UGathererRetaskScheduler::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGathererRetaskScheduler>() : nullptr;
+}
+
+void UGathererRetaskScheduler::Deinitialize()
+{
+	Workers.Empty();
+	WorkerLookup.Empty();
+	DueWorkers.Empty();
+	Batch.Empty();
+	Assignments.Empty();
+	Candidates.Empty();
+	CandidateNodes.Empty();
+	NodeCapacity.Empty();
+	NodeLookup.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UGathererRetaskScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGathererRetaskScheduler, STATGROUP_Tickables);
+}
+
+void UGathererRetaskScheduler::ReportIdle(UGathererModule* Gatherer, EGathererIdleReason Reason)
+{
+	if (!Gatherer || !Gatherer->Owner)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	FGathererRetaskState& RetaskState = Gatherer->RetaskState;
+	if (RetaskState.IdleSince < 0.0)
+	{
+		RetaskState.IdleSince = Now;
+	}
+	Stats.Reports++;
+
+	// First report goes into the next batch, a worker whose last retask came to nothing waits its backoff
+	const double NextAttemptTime = RetaskState.Attempts > 0 ? Now + GetBackoff(Gatherer) : Now;
+	UE_LOG(LogTemp, Verbose, TEXT("UGathererRetaskScheduler::ReportIdle() - %s, %s, attempt %d, due in %.2fs"),
+		*GetNameSafe(Gatherer->Owner), Reason == EGathererIdleReason::MoveFailed ? TEXT("move failed") : TEXT("no resource"),
+		RetaskState.Attempts, NextAttemptTime - Now);
+	Enqueue(Gatherer, Reason, NextAttemptTime);
+}
+
+void UGathererRetaskScheduler::Remove(UGathererModule* Gatherer)
+{
+	if (const int32* WorkerIndex = WorkerLookup.Find(Gatherer))
+	{
+		RemoveWorkerAt(*WorkerIndex);
+	}
+}
+
+void UGathererRetaskScheduler::EndIdlePeriod(UGathererModule* Gatherer)
+{
+	if (!Gatherer)
+	{
+		return;
+	}
+
+	FGathererRetaskState& RetaskState = Gatherer->RetaskState;
+	RetaskState.Attempts = 0;
+	if (RetaskState.IdleSince < 0.0)
+	{
+		return;
+	}
+
+	const float IdleSeconds = static_cast<float>(GetWorld()->GetTimeSeconds() - RetaskState.IdleSince);
+	RetaskState.IdleSince = -1.0;
+	Stats.IdlePeriods++;
+	Stats.TotalIdleSeconds += IdleSeconds;
+	Stats.LongestIdleSeconds = FMath::Max(Stats.LongestIdleSeconds, IdleSeconds);
+}
+
+float UGathererRetaskScheduler::GetIdleTime(const UGathererModule* Gatherer) const
+{
+	if (!Gatherer || Gatherer->RetaskState.IdleSince < 0.0)
+	{
+		return 0.f;
+	}
+	return static_cast<float>(GetWorld()->GetTimeSeconds() - Gatherer->RetaskState.IdleSince);
+}
+
+void UGathererRetaskScheduler::Enqueue(UGathererModule* Gatherer, EGathererIdleReason Reason, double NextAttemptTime)
+{
+	// Already waiting, a second report does not reset its place
+	if (const int32* WorkerIndex = WorkerLookup.Find(Gatherer))
+	{
+		Workers[*WorkerIndex].Reason = Reason;
+		return;
+	}
+
+	FIdleWorker& Worker = Workers.AddDefaulted_GetRef();
+	Worker.Gatherer = Gatherer;
+	Worker.GathererKey = Gatherer;
+	Worker.NextAttemptTime = NextAttemptTime;
+	Worker.Reason = Reason;
+	WorkerLookup.Add(Worker.GathererKey, Workers.Num() - 1);
+	Gatherer->RetaskState.bQueued = true;
+	NextDueTime = FMath::Min(NextDueTime, NextAttemptTime);
+}
+
+void UGathererRetaskScheduler::RemoveWorkerAt(int32 WorkerIndex)
+{
+	if (UGathererModule* Gatherer = Workers[WorkerIndex].Gatherer.Get())
+	{
+		Gatherer->RetaskState.bQueued = false;
+	}
+	WorkerLookup.Remove(Workers[WorkerIndex].GathererKey);
+
+	Workers.RemoveAtSwap(WorkerIndex, 1, EAllowShrinking::No);
+	if (Workers.IsValidIndex(WorkerIndex))
+	{
+		WorkerLookup.Add(Workers[WorkerIndex].GathererKey, WorkerIndex);
+	}
+}
+
+float UGathererRetaskScheduler::GetBackoff(const UGathererModule* Gatherer) const
+{
+	const float BaseDelay = Gatherer->GatherMethod ? Gatherer->GatherMethod->FindResourceRetryDelay : 1.f;
+	const int32 Doublings = FMath::Clamp(Gatherer->RetaskState.Attempts - 1, 0, 16);
+	return FMath::Min(BaseDelay * static_cast<float>(1 << Doublings), MaxRetryDelay);
+}
+
+void UGathererRetaskScheduler::Tick(float DeltaTime)
+{
+	Stats.IdleWorkers = Workers.Num();
+	SET_DWORD_STAT(STAT_RTS_IdleGatherers, Workers.Num());
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Workers.Num() == 0 || Now < NextDueTime)
+	{
+		return;
+	}
+
+	RTS_MODULE_SCOPE(STAT_RTS_RetaskScheduler);
+
+	// Take everyone who is due out of the queue, backwards so swap removal keeps the rest valid
+	DueWorkers.Reset();
+	NextDueTime = TNumericLimits<double>::Max();
+	for (int32 WorkerIndex = Workers.Num() - 1; WorkerIndex >= 0; --WorkerIndex)
+	{
+		if (Workers[WorkerIndex].NextAttemptTime <= Now)
+		{
+			DueWorkers.Add(Workers[WorkerIndex]);
+			RemoveWorkerAt(WorkerIndex);
+		}
+		else
+		{
+			NextDueTime = FMath::Min(NextDueTime, Workers[WorkerIndex].NextAttemptTime);
+		}
+	}
+
+	// Workers stuck on the way to a drop-off try the deposit again, everyone else goes into the node batch
+	Batch.Reset();
+	for (const FIdleWorker& Worker : DueWorkers)
+	{
+		UGathererModule* Gatherer = Worker.Gatherer.Get();
+		if (!Gatherer || !Gatherer->Owner || Gatherer->Owner->IsInPool() || !Gatherer->GatherMethod)
+		{
+			continue;
+		}
+
+		if (Worker.Reason == EGathererIdleReason::MoveFailed && Gatherer->CurrentState == EGathererState::Depositing && Gatherer->DepositMethod)
+		{
+			Gatherer->RetaskState.Attempts++;
+			Stats.DepositRetries++;
+			Gatherer->DepositMethod->Deposit();
+			continue;
+		}
+		Batch.Add(Gatherer);
+	}
+	if (Batch.Num() == 0)
+	{
+		return;
+	}
+
+	Stats.Batches++;
+	AssignBatch(Batch, Assignments);
+
+	// Orders go out last, a worker whose order fails right away reports back with its attempt already counted
+	for (int32 WorkerIndex = 0; WorkerIndex < Batch.Num(); ++WorkerIndex)
+	{
+		UGathererModule* Gatherer = Batch[WorkerIndex];
+		Gatherer->RetaskState.Attempts++;
+		if (ARTS_Actor* Node = Assignments[WorkerIndex])
+		{
+			Stats.Assignments++;
+			Gatherer->ExecuteGathererModule(Node);
+		}
+		else
+		{
+			Stats.Backoffs++;
+			Enqueue(Gatherer, EGathererIdleReason::NoResource, Now + GetBackoff(Gatherer));
+		}
+	}
+	Stats.IdleWorkers = Workers.Num();
+}
+
+void UGathererRetaskScheduler::AssignBatch(const TArray<UGathererModule*>& InBatch, TArray<ARTS_Actor*>& OutAssignments)
+{
+	OutAssignments.Reset();
+	OutAssignments.SetNumZeroed(InBatch.Num());
+	Candidates.Reset();
+	CandidateNodes.Reset();
+	NodeCapacity.Reset();
+	NodeLookup.Reset();
+
+	const UResourceSpatialIndex* SpatialIndex = UResourceSpatialIndex::Get(this);
+	if (!SpatialIndex)
+	{
+		return;
+	}
+	const USlotReservationService* SlotService = USlotReservationService::Get(this);
+
+	// Candidates: each worker's nearest nodes of its type that still have a slot, capacity looked up once per node
+	TArray<ARTS_Actor*> Found;
+	for (int32 WorkerIndex = 0; WorkerIndex < InBatch.Num(); ++WorkerIndex)
+	{
+		const UGathererModule* Gatherer = InBatch[WorkerIndex];
+		const UGatherMethod* Method = Gatherer->GatherMethod;
+		const FVector Origin = Gatherer->Owner->GetActorLocation();
+
+		Found.Reset();
+		SpatialIndex->FindNearest(Method->ResourceTypePriority, Origin, CandidatesPerWorker, Method->FindResourceRadius, true, Found);
+		for (ARTS_Actor* Node : Found)
+		{
+			int32 NodeIndex;
+			if (const int32* ExistingIndex = NodeLookup.Find(Node))
+			{
+				NodeIndex = *ExistingIndex;
+			}
+			else
+			{
+				NodeIndex = CandidateNodes.Add(Node);
+				NodeCapacity.Add(SlotService ? SlotService->GetAvailableSlots(Node) : 1);
+				NodeLookup.Add(Node, NodeIndex);
+			}
+
+			FCandidate& Candidate = Candidates.AddDefaulted_GetRef();
+			Candidate.Cost = static_cast<float>(FVector::DistSquared2D(Origin, Node->GetActorLocation()));
+			Candidate.WorkerIndex = WorkerIndex;
+			Candidate.NodeIndex = NodeIndex;
+		}
+	}
+
+	// Greedy: shortest pairs first, so a crowded node goes to its closest workers and the rest spill to their next pick
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.Cost < B.Cost; });
+	for (const FCandidate& Candidate : Candidates)
+	{
+		if (OutAssignments[Candidate.WorkerIndex] || NodeCapacity[Candidate.NodeIndex] <= 0)
+		{
+			continue;
+		}
+		OutAssignments[Candidate.WorkerIndex] = CandidateNodes[Candidate.NodeIndex];
+		NodeCapacity[Candidate.NodeIndex]--;
+	}
+}
+
+int32 UGathererRetaskScheduler::IssueGroupGather(const TArray<ARTS_Actor*>& Workers, ARTS_Actor* Target)
+{
+	RTS_MODULE_SCOPE(STAT_RTS_RetaskScheduler);
+
+	const UGatherableModule* TargetNode = Target && !Target->IsInPool() ? Target->GetModule<UGatherableModule>() : nullptr;
+	if (!TargetNode)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UGathererRetaskScheduler::IssueGroupGather() - %s is not a gatherable resource"), *GetNameSafe(Target));
+		return 0;
+	}
+
+	TArray<UGathererModule*> Group;
+	Group.Reserve(Workers.Num());
+	for (ARTS_Actor* Worker : Workers)
+	{
+		UGathererModule* Gatherer = Worker && !Worker->IsInPool() ? Worker->GetModule<UGathererModule>() : nullptr;
+		if (Gatherer && Gatherer->GatherMethod && !Group.Contains(Gatherer))
+		{
+			// Claims from the previous order go first, so the group can take back the slots it stands on
+			Gatherer->GatherMethod->ReleaseGatheringSlot();
+			Group.Add(Gatherer);
+		}
+	}
+
+	USlotReservationService* SlotService = USlotReservationService::Get(this);
+	if (Group.Num() == 0 || !SlotService)
+	{
+		for (UGathererModule* Gatherer : Group)
+		{
+			Gatherer->ExecuteGathererModule(Target);
+		}
+		return 0;
+	}
+	Stats.GroupOrders++;
+
+	// Node 0 is Target, then the closest nodes of its type until the group has a slot for everyone
+	const FVector TargetLocation = Target->GetActorLocation();
+	TArray<ARTS_Actor*> Nodes = { Target };
+	TArray<int32> Capacity = { SlotService->GetAvailableSlots(Target) };
+	int32 TotalCapacity = Capacity[0];
+	const UResourceSpatialIndex* SpatialIndex = UResourceSpatialIndex::Get(this);
+	if (SpatialIndex && TotalCapacity < Group.Num())
+	{
+		TArray<ARTS_Actor*> Found;
+		SpatialIndex->FindInRadius(TargetNode->ResourceType, TargetLocation, GroupSpreadRadius, true, Found);
+		Found.Sort([&TargetLocation](const ARTS_Actor& A, const ARTS_Actor& B)
+		{
+			return FVector::DistSquared2D(A.GetActorLocation(), TargetLocation) < FVector::DistSquared2D(B.GetActorLocation(), TargetLocation);
+		});
+		for (ARTS_Actor* Node : Found)
+		{
+			if (TotalCapacity >= Group.Num())
+			{
+				break;
+			}
+			const int32 NodeCapacity = Node != Target ? SlotService->GetAvailableSlots(Node) : 0;
+			if (NodeCapacity > 0)
+			{
+				Nodes.Add(Node);
+				Capacity.Add(NodeCapacity);
+				TotalCapacity += NodeCapacity;
+			}
+		}
+	}
+
+	// Cost is the walk to the node plus how far the node is from Target. Target is always a worker's cheapest
+	// pick, so taking the cheapest pairs first fills it with its closest workers and spills the rest next to it
+	TArray<FCandidate> GroupCandidates;
+	GroupCandidates.Reserve(Group.Num() * Nodes.Num());
+	for (int32 WorkerIndex = 0; WorkerIndex < Group.Num(); ++WorkerIndex)
+	{
+		const FVector WorkerLocation = Group[WorkerIndex]->Owner->GetActorLocation();
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+		{
+			const FVector NodeLocation = Nodes[NodeIndex]->GetActorLocation();
+			FCandidate& Candidate = GroupCandidates.AddDefaulted_GetRef();
+			Candidate.Cost = static_cast<float>(FVector::Dist2D(WorkerLocation, NodeLocation) + FVector::Dist2D(NodeLocation, TargetLocation));
+			Candidate.WorkerIndex = WorkerIndex;
+			Candidate.NodeIndex = NodeIndex;
+		}
+	}
+	GroupCandidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.Cost < B.Cost; });
+
+	TArray<int32> WorkerNode;
+	WorkerNode.Init(INDEX_NONE, Group.Num());
+	TArray<TArray<int32>> NodeWorkers;
+	NodeWorkers.SetNum(Nodes.Num());
+	for (const FCandidate& Candidate : GroupCandidates)
+	{
+		if (WorkerNode[Candidate.WorkerIndex] != INDEX_NONE || Capacity[Candidate.NodeIndex] <= 0)
+		{
+			continue;
+		}
+		WorkerNode[Candidate.WorkerIndex] = Candidate.NodeIndex;
+		NodeWorkers[Candidate.NodeIndex].Add(Candidate.WorkerIndex);
+		Capacity[Candidate.NodeIndex]--;
+	}
+
+	// One reservation pass per node, closest workers pick their slot first
+	int32 NumReserved = 0;
+	TArray<ARTS_Actor*> NodeActors;
+	TArray<FVector> SlotLocations;
+	TArray<bool> Reserved;
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		TArray<int32>& Assigned = NodeWorkers[NodeIndex];
+		if (Assigned.Num() == 0)
+		{
+			continue;
+		}
+
+		const FVector NodeLocation = Nodes[NodeIndex]->GetActorLocation();
+		Assigned.Sort([&Group, &NodeLocation](int32 A, int32 B)
+		{
+			return FVector::DistSquared2D(Group[A]->Owner->GetActorLocation(), NodeLocation) < FVector::DistSquared2D(Group[B]->Owner->GetActorLocation(), NodeLocation);
+		});
+		NodeActors.Reset();
+		for (const int32 WorkerIndex : Assigned)
+		{
+			NodeActors.Add(Group[WorkerIndex]->Owner);
+		}
+		NumReserved += SlotService->ReserveSlots(Nodes[NodeIndex], NodeActors, SlotLocations, Reserved);
+	}
+
+	// Orders go out once every slot is settled. Gather finds its slot already held and requests the move
+	for (int32 WorkerIndex = 0; WorkerIndex < Group.Num(); ++WorkerIndex)
+	{
+		const int32 NodeIndex = WorkerNode[WorkerIndex];
+		Stats.GroupSpills += NodeIndex > 0 ? 1 : 0;
+		Group[WorkerIndex]->ExecuteGathererModule(NodeIndex != INDEX_NONE ? Nodes[NodeIndex] : Target);
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("UGathererRetaskScheduler::IssueGroupGather() - %d workers on %s, %d slots over %d nodes"),
+		Group.Num(), *Target->GetName(), NumReserved, Nodes.Num());
+	return NumReserved;
+}
+
+void UGathererRetaskScheduler::DumpStats() const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double AverageIdle = Stats.IdlePeriods > 0 ? Stats.TotalIdleSeconds / Stats.IdlePeriods : 0.0;
+	UE_LOG(LogTemp, Log, TEXT("UGathererRetaskScheduler - %d idle, %lld reports, %lld batches, %lld assignments, %lld deposit retries, %lld backoffs, %lld group orders (%lld spilled), %lld idle periods (avg %.2fs, longest %.2fs)"),
+		Workers.Num(), Stats.Reports, Stats.Batches, Stats.Assignments, Stats.DepositRetries, Stats.Backoffs,
+		Stats.GroupOrders, Stats.GroupSpills, Stats.IdlePeriods, AverageIdle, Stats.LongestIdleSeconds);
+	for (const FIdleWorker& Worker : Workers)
+	{
+		const UGathererModule* Gatherer = Worker.Gatherer.Get();
+		UE_LOG(LogTemp, Log, TEXT("  %s: %s, attempt %d, idle %.2fs, due in %.2fs"),
+			Gatherer ? *GetNameSafe(Gatherer->Owner) : TEXT("None"),
+			Worker.Reason == EGathererIdleReason::MoveFailed ? TEXT("move failed") : TEXT("no resource"),
+			Gatherer ? Gatherer->RetaskState.Attempts : 0, GetIdleTime(Gatherer), FMath::Max(Worker.NextAttemptTime - Now, 0.0));
+	}
+}
@@ -0,0 +1,169 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GathererRetaskScheduler.generated.h"
+
+class ARTS_Actor;
+class UGathererModule;
+
+UENUM(BlueprintType)
+enum class EGathererIdleReason : uint8
+{
+	/** Node depleted or gone, or no slot to be had on it */
+	NoResource,
+	/** Path request or path following failed */
+	MoveFailed
+};
+
+USTRUCT(BlueprintType)
+struct FGathererRetaskStats
+{
+	GENERATED_BODY()
+
+	/** Workers waiting for a retask right now */
+	UPROPERTY(BlueprintReadOnly, Category = "Retask Scheduler")
+	int32 IdleWorkers = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Retask Scheduler")
+	int64 Reports = 0;
+
+	/** Batch passes that had anything due */
+	UPROPERTY(BlueprintReadOnly, Category = "Retask Scheduler")
+	int64 Batches = 0;
+
+	/** Workers sent to a node with a free slot */
+	UPROPERTY(BlueprintReadOnly, Category = "Retask Scheduler")
+	int64 Assignments = 0;
+
+	/** Workers sent back to a drop-off after a failed deposit trip */
+	UPROPERTY(BlueprintReadOnly, Category = "Retask Scheduler")
+	int64 DepositRetries = 0;
+
+	/** Due workers that found nothing and backed off */
+	UPROPERTY(BlueprintReadOnly, Category = "Retask Scheduler")
+	int64 Backoffs = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Retask Scheduler")
+	int64 GroupOrders = 0;
+
+	/** Group order workers sent to a nearby node because the clicked one was full */
+	UPROPERTY(BlueprintReadOnly, Category = "Retask Scheduler")
+	int64 GroupSpills = 0;
+
+	/** Idle periods that ended with a harvest, a deposit or a stop */
+	UPROPERTY(BlueprintReadOnly, Category = "Retask Scheduler")
+	int64 IdlePeriods = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Retask Scheduler")
+	double TotalIdleSeconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Retask Scheduler")
+	float LongestIdleSeconds = 0.f;
+};
+
+/**
+ * World level retasking of gatherers that ran out of work.
+ * Workers whose node is gone, who found no slot, or whose move failed are reported here instead of each running
+ * its own retry timer. Once per frame every worker that is due is assigned in one batch: candidates are the
+ * nearest nodes with free slots from UResourceSpatialIndex, capacities come from USlotReservationService, and
+ * the shortest (worker, node) pairs are taken greedily until workers or slots run out. Workers left over back off
+ * exponentially from their gather method's FindResourceRetryDelay. A worker's idle period lasts from its first
+ * report until it harvests or deposits again.
+ * Group gather orders use the same kind of pass for a whole selection, see IssueGroupGather.
+ */
+UCLASS()
+class DRAKTHYSPROJECT_API UGathererRetaskScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGathererRetaskScheduler* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Queues the worker for the next batch, or after its backoff if its last retask did not lead anywhere */
+	void ReportIdle(UGathererModule* Gatherer, EGathererIdleReason Reason);
+
+	/** Drops a queued worker that received another order, its idle period keeps running */
+	void Remove(UGathererModule* Gatherer);
+
+	/** Closes the worker's idle period, called when it harvests, deposits or is stopped */
+	void EndIdlePeriod(UGathererModule* Gatherer);
+
+	/**
+	 * Gather order for a selection. Slots of Target and of nodes of its type within GroupSpreadRadius are handed
+	 * out in one greedy pass over the workers' detour via Target, so the closest workers fill Target and the rest
+	 * spill to the nodes next to it. Each node reserves its workers' slots in one ReserveSlots call before any
+	 * order goes out, the resulting moves land in the same UGathererMovementQueue batch. Workers left without a
+	 * slot are sent to Target and retasked from there. Returns the number of workers that got a slot.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Retask Scheduler")
+	int32 IssueGroupGather(const TArray<ARTS_Actor*>& Workers, ARTS_Actor* Target);
+
+	/** Seconds the worker has been idle, 0 if it is working */
+	UFUNCTION(BlueprintPure, Category = "Retask Scheduler")
+	float GetIdleTime(const UGathererModule* Gatherer) const;
+
+	UFUNCTION(BlueprintPure, Category = "Retask Scheduler")
+	FGathererRetaskStats GetStats() const { return Stats; }
+
+	void DumpStats() const;
+
+	/** Nearest nodes considered per worker, more gives the greedy pass room to spread workers out */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Retask Scheduler", meta = (ClampMin = "1"))
+	int32 CandidatesPerWorker = 4;
+
+	/** How far from the clicked node a group order may spread workers */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Retask Scheduler", meta = (ClampMin = "0"))
+	float GroupSpreadRadius = 1500.f;
+
+	/** Upper bound of the exponential backoff */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Retask Scheduler", meta = (ClampMin = "0.1"))
+	float MaxRetryDelay = 16.f;
+
+private:
+	struct FIdleWorker
+	{
+		TWeakObjectPtr<UGathererModule> Gatherer;
+		TObjectKey<UGathererModule> GathererKey;
+		double NextAttemptTime = 0.0;
+		EGathererIdleReason Reason = EGathererIdleReason::NoResource;
+	};
+
+	/** A node candidate of one worker, cheapest pairs are assigned first */
+	struct FCandidate
+	{
+		float Cost = 0.f;
+		int32 WorkerIndex = INDEX_NONE;
+		int32 NodeIndex = INDEX_NONE;
+	};
+
+	void Enqueue(UGathererModule* Gatherer, EGathererIdleReason Reason, double NextAttemptTime);
+	void RemoveWorkerAt(int32 WorkerIndex);
+
+	/** Greedy assignment of Batch to free slots, returns per worker the node it got or nullptr */
+	void AssignBatch(const TArray<UGathererModule*>& Batch, TArray<ARTS_Actor*>& OutAssignments);
+
+	float GetBackoff(const UGathererModule* Gatherer) const;
+
+	TArray<FIdleWorker> Workers;
+	TMap<TObjectKey<UGathererModule>, int32> WorkerLookup;
+
+	/** Earliest NextAttemptTime in Workers, nothing is looked at before it */
+	double NextDueTime = TNumericLimits<double>::Max();
+
+	/** Scratch for the batch pass, kept to avoid reallocating every frame */
+	TArray<FIdleWorker> DueWorkers;
+	TArray<UGathererModule*> Batch;
+	TArray<ARTS_Actor*> Assignments;
+	TArray<FCandidate> Candidates;
+	TArray<ARTS_Actor*> CandidateNodes;
+	TArray<int32> NodeCapacity;
+	TMap<ARTS_Actor*, int32> NodeLookup;
+
+	FGathererRetaskStats Stats;
+};
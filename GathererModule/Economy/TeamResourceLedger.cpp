@@ -0,0 +1,306 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "TeamResourceLedger.h"
+#include "RTS_Actor.h"
+#include "RTS_Stats.h"
+#include "TeamComponent/TeamComponent.h"
+#include "Utilis/Libraries/RTSModuleFunctionLibrary.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld GDumpTeamResourceLedgerCommand(
+	TEXT("RTS.Economy.DumpLedger"),
+	TEXT("Logs deposited totals and income rates per team and the ledger commit counters."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UTeamResourceLedger* Ledger = UTeamResourceLedger::Get(World))
+		{
+			Ledger->DumpLedger();
+		}
+	}));
+
+UTeamResourceLedger* UTeamResourceLedger::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UTeamResourceLedger>() : nullptr;
+}
+
+void UTeamResourceLedger::Deinitialize()
+{
+	// Anything still buffered belongs to a world that is going away
+	Teams.Empty();
+	DepositTargets.Empty();
+	PendingPlayers.Empty();
+	PendingPlayerLookup.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UTeamResourceLedger::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTeamResourceLedger, STATGROUP_Tickables);
+}
+
+bool UTeamResourceLedger::AddDeposit(ARTS_Actor* Depositor, EResourceType ResourceType, int32 Amount)
+{
+	if (!Depositor)
+	{
+		return false;
+	}
+
+	const FDepositTarget* Target = ResolveTarget(Depositor);
+	UPlayerResourcesModule* PlayerResources = Target ? Target->PlayerResources.Get() : nullptr;
+	if (!PlayerResources)
+	{
+		return false;
+	}
+
+	if (Amount <= 0)
+	{
+		return true;
+	}
+
+	const int32 TypeIndex = static_cast<int32>(ResourceType);
+
+	int32& PlayerIndex = PendingPlayerLookup.FindOrAdd(PlayerResources, INDEX_NONE);
+	if (PlayerIndex == INDEX_NONE)
+	{
+		PlayerIndex = PendingPlayers.AddDefaulted();
+		PendingPlayers[PlayerIndex].PlayerResources = PlayerResources;
+	}
+	TArray<int32>& PlayerAmounts = PendingPlayers[PlayerIndex].Amounts;
+	if (!PlayerAmounts.IsValidIndex(TypeIndex))
+	{
+		PlayerAmounts.SetNumZeroed(TypeIndex + 1);
+	}
+	PlayerAmounts[TypeIndex] += Amount;
+
+	FTeamAccounts& Team = Teams.FindOrAdd(Target->Team);
+	if (!Team.Accounts.IsValidIndex(TypeIndex))
+	{
+		Team.Accounts.SetNum(TypeIndex + 1);
+	}
+	Team.Accounts[TypeIndex].Pending += Amount;
+	Team.bHasPending = true;
+
+	Stats.Deposits++;
+	return true;
+}
+
+const UTeamResourceLedger::FDepositTarget* UTeamResourceLedger::ResolveTarget(ARTS_Actor* Depositor)
+{
+	// A cached target holds while the team component reports the team and player it was resolved for
+	if (FDepositTarget* Cached = DepositTargets.Find(Depositor))
+	{
+		const UTeamComponent* TeamComponent = Cached->TeamComponent.Get();
+		const int32 Team = TeamComponent ? TeamComponent->GetTeamIndex() : 0;
+		APlayerState* PlayerState = TeamComponent ? TeamComponent->GetPlayerOwner() : nullptr;
+		if (Cached->PlayerResources.IsValid() && Team == Cached->Team && PlayerState == Cached->PlayerState.Get())
+		{
+			return Cached;
+		}
+	}
+
+	UPlayerResourcesModule* PlayerResources = URTSModuleFunctionLibrary::GetPlayerResources(Depositor);
+	if (!PlayerResources)
+	{
+		DepositTargets.Remove(Depositor);
+		return nullptr;
+	}
+
+	const UTeamComponent* TeamComponent = Depositor->FindComponentByClass<UTeamComponent>();
+	FDepositTarget& Target = DepositTargets.Add(Depositor);
+	Target.PlayerResources = PlayerResources;
+	Target.TeamComponent = TeamComponent;
+	Target.PlayerState = TeamComponent ? TeamComponent->GetPlayerOwner() : nullptr;
+	Target.Team = TeamComponent ? TeamComponent->GetTeamIndex() : 0;
+	return &Target;
+}
+
+void UTeamResourceLedger::Tick(float DeltaTime)
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	const int64 NowSecond = FMath::FloorToInt64(World->GetTimeSeconds());
+	for (TPair<int32, FTeamAccounts>& Pair : Teams)
+	{
+		AdvanceIncomeWindow(Pair.Value, NowSecond);
+	}
+
+	// Destroyed depositors leave their entry behind, sweep once a second
+	if (NowSecond != TargetsPrunedSecond)
+	{
+		TargetsPrunedSecond = NowSecond;
+		for (auto It = DepositTargets.CreateIterator(); It; ++It)
+		{
+			if (!It->Key.ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	Commit();
+}
+
+void UTeamResourceLedger::Commit()
+{
+	if (PendingPlayers.Num() == 0)
+	{
+		return;
+	}
+
+	RTS_MODULE_SCOPE(STAT_RTS_LedgerCommit);
+	Stats.CommitFrames++;
+
+	for (FPendingPlayer& Pending : PendingPlayers)
+	{
+		UPlayerResourcesModule* PlayerResources = Pending.PlayerResources.Get();
+		if (!PlayerResources)
+		{
+			continue;
+		}
+
+		for (int32 TypeIndex = 0; TypeIndex < Pending.Amounts.Num(); ++TypeIndex)
+		{
+			if (Pending.Amounts[TypeIndex] > 0)
+			{
+				PlayerResources->AddResource(static_cast<EResourceType>(TypeIndex), Pending.Amounts[TypeIndex]);
+				Stats.PlayerCommits++;
+				INC_DWORD_STAT(STAT_RTS_LedgerPlayerCommits);
+			}
+		}
+	}
+	PendingPlayers.Reset();
+	PendingPlayerLookup.Reset();
+
+	for (TPair<int32, FTeamAccounts>& Pair : Teams)
+	{
+		FTeamAccounts& Team = Pair.Value;
+		if (!Team.bHasPending)
+		{
+			continue;
+		}
+
+		const int32 Bucket = static_cast<int32>(Team.CurrentSecond % IncomeWindow);
+		for (FAccount& Account : Team.Accounts)
+		{
+			if (Account.Pending == 0)
+			{
+				continue;
+			}
+
+			Account.Total += Account.Pending;
+			Account.SecondBuckets[Bucket] += Account.Pending;
+			Account.ShortIncome += Account.Pending;
+			Account.WindowIncome += Account.Pending;
+			Account.Pending = 0;
+		}
+		Team.bHasPending = false;
+
+		if (OnTeamResourcesCommitted.IsBound())
+		{
+			OnTeamResourcesCommitted.Broadcast(Pair.Key);
+		}
+	}
+}
+
+void UTeamResourceLedger::AdvanceIncomeWindow(FTeamAccounts& Team, int64 NowSecond) const
+{
+	if (NowSecond <= Team.CurrentSecond)
+	{
+		return;
+	}
+
+	// Nothing in the window survives a gap this long
+	if (NowSecond - Team.CurrentSecond >= IncomeWindow)
+	{
+		for (FAccount& Account : Team.Accounts)
+		{
+			Account.SecondBuckets = TStaticArray<int32, IncomeWindow>(InPlace, 0);
+			Account.ShortIncome = 0;
+			Account.WindowIncome = 0;
+		}
+		Team.CurrentSecond = NowSecond;
+		return;
+	}
+
+	while (Team.CurrentSecond < NowSecond)
+	{
+		const int64 NextSecond = ++Team.CurrentSecond;
+		const int32 LeavingShort = static_cast<int32>((NextSecond - IncomeShortWindow) % IncomeWindow);
+		const int32 LeavingWindow = static_cast<int32>(NextSecond % IncomeWindow);
+		for (FAccount& Account : Team.Accounts)
+		{
+			if (NextSecond >= IncomeShortWindow)
+			{
+				Account.ShortIncome -= Account.SecondBuckets[LeavingShort];
+			}
+			Account.WindowIncome -= Account.SecondBuckets[LeavingWindow];
+			Account.SecondBuckets[LeavingWindow] = 0;
+		}
+	}
+}
+
+const UTeamResourceLedger::FAccount* UTeamResourceLedger::FindAccount(int32 Team, EResourceType ResourceType) const
+{
+	const FTeamAccounts* Accounts = Teams.Find(Team);
+	const int32 TypeIndex = static_cast<int32>(ResourceType);
+	return Accounts && Accounts->Accounts.IsValidIndex(TypeIndex) ? &Accounts->Accounts[TypeIndex] : nullptr;
+}
+
+int64 UTeamResourceLedger::GetDepositedTotal(int32 Team, EResourceType ResourceType) const
+{
+	const FAccount* Account = FindAccount(Team, ResourceType);
+	return Account ? Account->Total : 0;
+}
+
+void UTeamResourceLedger::GetDepositedTotals(TMap<int32, TArray<int64>>& OutTotals) const
+{
+	OutTotals.Reset();
+	for (const TPair<int32, FTeamAccounts>& Pair : Teams)
+	{
+		TArray<int64>& Totals = OutTotals.Add(Pair.Key);
+		Totals.SetNumZeroed(Pair.Value.Accounts.Num());
+		for (int32 TypeIndex = 0; TypeIndex < Pair.Value.Accounts.Num(); ++TypeIndex)
+		{
+			const FAccount& Account = Pair.Value.Accounts[TypeIndex];
+			Totals[TypeIndex] = Account.Total + Account.Pending;
+		}
+	}
+}
+
+float UTeamResourceLedger::GetIncomePerSecond(int32 Team, EResourceType ResourceType) const
+{
+	const FAccount* Account = FindAccount(Team, ResourceType);
+	return Account ? static_cast<float>(Account->ShortIncome) / IncomeShortWindow : 0.f;
+}
+
+int32 UTeamResourceLedger::GetIncomePerMinute(int32 Team, EResourceType ResourceType) const
+{
+	const FAccount* Account = FindAccount(Team, ResourceType);
+	return Account ? Account->WindowIncome : 0;
+}
+
+void UTeamResourceLedger::DumpLedger() const
+{
+	UE_LOG(LogTemp, Log, TEXT("UTeamResourceLedger - %lld deposits, %lld player commits over %lld frames"),
+		Stats.Deposits, Stats.PlayerCommits, Stats.CommitFrames);
+	for (const TPair<int32, FTeamAccounts>& Pair : Teams)
+	{
+		for (int32 TypeIndex = 0; TypeIndex < Pair.Value.Accounts.Num(); ++TypeIndex)
+		{
+			const FAccount& Account = Pair.Value.Accounts[TypeIndex];
+			if (Account.Total == 0)
+			{
+				continue;
+			}
+			UE_LOG(LogTemp, Log, TEXT("  Team %d, type %d: total %lld, %.1f/s, %d/min"),
+				Pair.Key, TypeIndex, Account.Total, static_cast<float>(Account.ShortIncome) / IncomeShortWindow, Account.WindowIncome);
+		}
+	}
+}
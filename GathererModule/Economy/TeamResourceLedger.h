@@ -0,0 +1,140 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ResourceType.h"
+#include "TeamResourceLedger.generated.h"
+
+class ARTS_Actor;
+class APlayerState;
+class UPlayerResourcesModule;
+class UTeamComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTeamResourcesCommitted, int32, Team);
+
+USTRUCT(BlueprintType)
+struct FTeamResourceLedgerStats
+{
+	GENERATED_BODY()
+
+	/** Deposits taken into the accumulation buffer */
+	UPROPERTY(BlueprintReadOnly, Category = "Resource Ledger")
+	int64 Deposits = 0;
+
+	/** AddResource calls made on player resources, at most one per player and type per frame */
+	UPROPERTY(BlueprintReadOnly, Category = "Resource Ledger")
+	int64 PlayerCommits = 0;
+
+	/** Frames that committed anything */
+	UPROPERTY(BlueprintReadOnly, Category = "Resource Ledger")
+	int64 CommitFrames = 0;
+};
+
+/**
+ * Per-team resource ledger.
+ * Deposits are added to a per-frame buffer and committed once per frame: one AddResource per player and
+ * resource type, then one OnTeamResourcesCommitted per team that received anything. The player resources of
+ * a depositor are resolved once and cached until its team or owning player changes. Every team keeps its
+ * deposited totals and rolling income counters in a dense array indexed by EResourceType.
+ */
+UCLASS()
+class DRAKTHYSPROJECT_API UTeamResourceLedger : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UTeamResourceLedger* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Buffers Amount of ResourceType for the player and team of Depositor, applied at the end of the frame.
+	 * Returns false if Depositor has no player resources to receive it.
+	 */
+	bool AddDeposit(ARTS_Actor* Depositor, EResourceType ResourceType, int32 Amount);
+
+	/** Total committed through the ledger for Team since the world started */
+	UFUNCTION(BlueprintPure, Category = "Resource Ledger")
+	int64 GetDepositedTotal(int32 Team, EResourceType ResourceType) const;
+
+	/** Committed plus pending totals of every team, indexed by EResourceType */
+	void GetDepositedTotals(TMap<int32, TArray<int64>>& OutTotals) const;
+
+	/** Average income over the last IncomeShortWindow seconds */
+	UFUNCTION(BlueprintPure, Category = "Resource Ledger")
+	float GetIncomePerSecond(int32 Team, EResourceType ResourceType) const;
+
+	/** Income over the last minute */
+	UFUNCTION(BlueprintPure, Category = "Resource Ledger")
+	int32 GetIncomePerMinute(int32 Team, EResourceType ResourceType) const;
+
+	UFUNCTION(BlueprintPure, Category = "Resource Ledger")
+	FTeamResourceLedgerStats GetStats() const { return Stats; }
+
+	void DumpLedger() const;
+
+	/** Fired once per frame for every team that had deposits committed */
+	UPROPERTY(BlueprintAssignable, Category = "Resource Ledger")
+	FOnTeamResourcesCommitted OnTeamResourcesCommitted;
+
+	/** Seconds averaged by GetIncomePerSecond */
+	static constexpr int32 IncomeShortWindow = 5;
+
+	/** Seconds covered by GetIncomePerMinute, one bucket each */
+	static constexpr int32 IncomeWindow = 60;
+
+private:
+	/** One resource type of a team */
+	struct FAccount
+	{
+		int64 Total = 0;
+		int32 Pending = 0;
+		int32 ShortIncome = 0;
+		int32 WindowIncome = 0;
+		TStaticArray<int32, IncomeWindow> SecondBuckets{InPlace, 0};
+	};
+
+	struct FTeamAccounts
+	{
+		/** Indexed by EResourceType, grown on first deposit of a type */
+		TArray<FAccount> Accounts;
+		int64 CurrentSecond = 0;
+		bool bHasPending = false;
+	};
+
+	/** Where a depositor's resources go, valid while its team component still reports the same team and player */
+	struct FDepositTarget
+	{
+		TWeakObjectPtr<UPlayerResourcesModule> PlayerResources;
+		TWeakObjectPtr<const UTeamComponent> TeamComponent;
+		TWeakObjectPtr<APlayerState> PlayerState;
+		int32 Team = 0;
+	};
+
+	/** Deltas owed to one player's resources this frame, indexed by EResourceType */
+	struct FPendingPlayer
+	{
+		TWeakObjectPtr<UPlayerResourcesModule> PlayerResources;
+		TArray<int32> Amounts;
+	};
+
+	const FDepositTarget* ResolveTarget(ARTS_Actor* Depositor);
+	void Commit();
+	void AdvanceIncomeWindow(FTeamAccounts& Team, int64 NowSecond) const;
+	const FAccount* FindAccount(int32 Team, EResourceType ResourceType) const;
+
+	TMap<int32, FTeamAccounts> Teams;
+
+	TMap<TObjectKey<ARTS_Actor>, FDepositTarget> DepositTargets;
+
+	/** Second dead depositors were last dropped from DepositTargets */
+	int64 TargetsPrunedSecond = 0;
+
+	TArray<FPendingPlayer> PendingPlayers;
+	TMap<TObjectKey<UPlayerResourcesModule>, int32> PendingPlayerLookup;
+
+	FTeamResourceLedgerStats Stats;
+};
@@ -1,103 +1,269 @@
-﻿#include "GatherMethod.h"
-#include "GameFramework/Controller.h"
-#include "AIController.h"
-#include "DrawDebugHelpers.h"
-#include "TimerManager.h"
-#include "GathererModule/GathererModule.h"
-#include "RTS_Actor.h"
-#include "GatherableModule/GatherableModule.h"
-#include "SlotModule/SlotModule.h"
-#include "Utilis/Libraries/RTSModuleFunctionLibrary.h"
-
-void UGatherMethod::InitializeGatherMethod(UGathererModule* Gatherer)
-{
-	GathererModule = Gatherer;
-	SetResourceTypePriority(EResourceType::Wood);
-}
-
-void UGatherMethod::Gather(ARTS_Actor* TargetResource)
-{
-	if (!TargetResource)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("UGatherMethod::Gather() - TargetResource is null!"));
-		FindNewResource();
-		return;
-	}
-
-	// Ensure gatherable module is available for this target
-	if (!GatherableModule || CurrentGatheringTarget.Get() != TargetResource)
-	{
-		// Clear any active gathering timer when switching to a new resource
-		if (GathererModule && GathererModule->GetWorld())
-		{
-			GathererModule->GetWorld()->GetTimerManager().ClearTimer(GatheringTimer);
-		}
-		
-		GatherableModule = URTSModuleFunctionLibrary::GetGatherableModule(TargetResource);
-		CurrentGatheringTarget = TargetResource;
-	}
-
-	if (!GatherableModule)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("UGatherMethod::Gather() - GatherableModule is null!"));
-		return;
-	}
-
-	SetResourceTypePriority(GatherableModule->ResourceType);
-}
-
-
-void UGatherMethod::StartGathering()
-{
-	// Base implementation - empty
-}
-
-void UGatherMethod::TickGathering()
-{
-	// Base implementation - empty
-}
-
-void UGatherMethod::CompleteGathering()
-{
-	// Base implementation - empty
-}
-
-void UGatherMethod::StopGather()
-{
-	// Clear any active timers
-	if (GathererModule && GathererModule->GetWorld())
-	{
-		GathererModule->GetWorld()->GetTimerManager().ClearTimer(GatheringTimer);
-	}
-	
-	// Reset gathering state
-	CurrentGatheringTime = 0.f;
-	CurrentGatheringTarget = nullptr;
-	GatherableModule = nullptr;
-	CurrentGatheringTarget = nullptr;
-	
-	// Reset progress immediately when gathering completes
-	GathererModule->OnGatheringProgress.Broadcast(0.0f, 0.0f);
-}
-
-bool UGatherMethod::GetGatheringLocation(FVector& OutLocation)
-{	
-
-	return false;
-}
-
-void UGatherMethod::SetResourceTypePriority(EResourceType ResourceType)
-{
-	ResourceTypePriority = ResourceType;
-}
-
-void UGatherMethod::FindNewResource()
-{
-	// NOTE: THIS WILL REQUIRE DELAY OR SET TIMER BY EVENT TO NOT GET INTO INFINITY LOOP
-	//  (basically it's a retry every 0.1s or something like that)
-	// TODO: implementing finding new resource and t hen call to gather method
-	UE_LOG(LogTemp, Warning, TEXT("UGatherMethod::FindNewResource() - Finding new resource"));
-
-	//ARTS_Actor* FoundResourceTarget = nullptr;
-	//GathererModule->ExecuteGathererModule(FoundResourceTarget);
+﻿#include "GatherMethod.h"
+#include "GameFramework/Controller.h"
+#include "AIController.h"
+#include "DrawDebugHelpers.h"
+#include "RTS_ModuleScheduler.h"
+#include "RTS_Stats.h"
+#include "RTS_UIEventSubsystem.h"
+#include "GathererModule/GathererModule.h"
+#include "RTS_Actor.h"
+#include "GatherableModule/GatherableModule.h"
+#include "GatherableModule/ResourceSpatialIndex.h"
+#include "GatherableModule/SlotReservationService.h"
+#include "GathererModule/Economy/GathererRetaskScheduler.h"
+
+void UGatherMethod::InitializeGatherMethod(UGathererModule* Gatherer)
+{
+	GathererModule = Gatherer;
+	SetResourceTypePriority(EResourceType::Wood);
+}
+
+void UGatherMethod::Gather(ARTS_Actor* TargetResource)
+{
+	if (!TargetResource || TargetResource->IsInPool())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UGatherMethod::Gather() - TargetResource is null or depleted!"));
+		FindNewResource();
+		return;
+	}
+
+	// Ensure gatherable module is available for this target
+	if (!GatherableModule || CurrentGatheringTarget.Get() != TargetResource)
+	{
+		// Clear any active gathering cycle when switching to a new resource
+		EndGatheringCycle();
+		
+		GatherableModule = TargetResource->GetModule<UGatherableModule>();
+		CurrentGatheringTarget = TargetResource;
+	}
+
+	if (!GatherableModule)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UGatherMethod::Gather() - GatherableModule is null!"));
+		return;
+	}
+
+	SetResourceTypePriority(GatherableModule->ResourceType);
+}
+
+
+void UGatherMethod::StartGathering()
+{
+	// Base implementation - empty
+}
+
+void UGatherMethod::TickGathering()
+{
+	// Progress only, completion is driven by the scheduled CompleteGathering()
+	if (!GathererModule || !IsGathering()) return;
+
+	GathererModule->OnGatheringProgress.Broadcast(GetCurrentGatheringTime(), RequiredGatheringTime);
+}
+
+void UGatherMethod::BeginGatheringCycle(float ElapsedTime)
+{
+	RTS_MODULE_SCOPE(STAT_RTS_GatherStart);
+	INC_DWORD_STAT(STAT_RTS_GatherStarts);
+
+	URTS_ModuleScheduler* Scheduler = URTS_ModuleScheduler::Get(GathererModule);
+	if (!Scheduler) return;
+
+	EndGatheringCycle();
+
+	// Off-screen steady loops continue analytically from here
+	if (ElapsedTime <= 0.f && GathererModule->TryEnterEconomyLOD())
+	{
+		return;
+	}
+
+	ElapsedTime = FMath::Clamp(ElapsedTime, 0.f, RequiredGatheringTime);
+	GatheringStartTime = GathererModule->GetWorld()->GetTimeSeconds() - ElapsedTime;
+	Scheduler->ScheduleUObject(GatheringTimer, this, &UGatherMethod::CompleteGathering, RequiredGatheringTime - ElapsedTime);
+	RefreshGatheringProgressBroadcast();
+	URTS_UIEventSubsystem::PostEvent(GathererModule->Owner, ERTSUIEvent::GatheringStateChanged);
+}
+
+void UGatherMethod::ResumeGathering(float ElapsedTime)
+{
+	if (!GathererModule || !GatherableModule)
+	{
+		return;
+	}
+
+	RequiredGatheringTime = GatherableModule->GatheringTime;
+	BeginGatheringCycle(ElapsedTime);
+}
+
+void UGatherMethod::EndGatheringCycle()
+{
+	if (URTS_ModuleScheduler* Scheduler = URTS_ModuleScheduler::Get(GathererModule))
+	{
+		Scheduler->Cancel(GatheringTimer);
+		Scheduler->Cancel(GatheringProgressTimer);
+	}
+
+	if (IsGathering() && GathererModule)
+	{
+		URTS_UIEventSubsystem::PostEvent(GathererModule->Owner, ERTSUIEvent::GatheringStateChanged);
+	}
+	GatheringStartTime = -1.0;
+}
+
+void UGatherMethod::RefreshGatheringProgressBroadcast()
+{
+	URTS_ModuleScheduler* Scheduler = URTS_ModuleScheduler::Get(GathererModule);
+	if (!Scheduler) return;
+
+	const bool bWantsProgress = IsGathering() && GathererModule->bBroadcastGatheringProgress;
+	if (bWantsProgress && !Scheduler->IsScheduled(GatheringProgressTimer))
+	{
+		Scheduler->ScheduleUObject(GatheringProgressTimer, this, &UGatherMethod::TickGathering, GathererModule->GatheringProgressInterval, true);
+	}
+	else if (!bWantsProgress)
+	{
+		Scheduler->Cancel(GatheringProgressTimer);
+	}
+}
+
+float UGatherMethod::GetCurrentGatheringTime() const
+{
+	if (!IsGathering() || !GathererModule || !GathererModule->GetWorld())
+	{
+		return 0.f;
+	}
+	const double Elapsed = GathererModule->GetWorld()->GetTimeSeconds() - GatheringStartTime;
+	return FMath::Clamp(static_cast<float>(Elapsed), 0.f, RequiredGatheringTime);
+}
+
+void UGatherMethod::CompleteGathering()
+{
+	// Base implementation - empty
+}
+
+RTSEconomy::FGathererState UGatherMethod::GetCoreState(int32 Stored) const
+{
+	RTSEconomy::FGathererState State;
+	State.CarriedAmount = GathererModule ? GathererModule->CurrentResourceAmount : 0;
+	State.CarriedType = GathererModule ? static_cast<uint8>(GathererModule->CurrentResourceType) : 0;
+	State.Stored = Stored;
+	return State;
+}
+
+void UGatherMethod::RequestHarvest(int32 Amount)
+{
+	if (GatherableModule)
+	{
+		GatherableModule->RequestHarvest(Amount, FOnHarvestResolved::CreateUObject(this, &UGatherMethod::HandleHarvestResolved, HarvestSerial));
+	}
+}
+
+void UGatherMethod::HandleHarvestResolved(bool bHarvested, int32 Amount, EResourceType ResourceType, uint32 Serial)
+{
+	if (Serial == HarvestSerial && GathererModule)
+	{
+		OnHarvestResolved(bHarvested, Amount, ResourceType);
+	}
+}
+
+void UGatherMethod::StopGather()
+{
+	// Clear any active gathering cycle and drop a harvest still waiting to resolve
+	EndGatheringCycle();
+	HarvestSerial++;
+	ReleaseGatheringSlot();
+	
+	// Reset gathering state
+	CurrentGatheringTarget = nullptr;
+	GatherableModule = nullptr;
+	CurrentGatheringTarget = nullptr;
+	
+	// Reset progress immediately when gathering completes
+	GathererModule->OnGatheringProgress.Broadcast(0.0f, 0.0f);
+}
+
+bool UGatherMethod::GetGatheringLocation(FVector& OutLocation)
+{	
+
+	return false;
+}
+
+void UGatherMethod::SetResourceTypePriority(EResourceType ResourceType)
+{
+	ResourceTypePriority = ResourceType;
+}
+
+void UGatherMethod::FindNewResource()
+{
+	if (!GathererModule || !GathererModule->Owner)
+	{
+		return;
+	}
+
+	// Leaving the old node, its slot is no longer ours
+	ReleaseGatheringSlot();
+
+	// Idle workers are matched to free slots in one batch per frame, with backoff while there are none
+	if (UGathererRetaskScheduler* RetaskScheduler = UGathererRetaskScheduler::Get(GathererModule))
+	{
+		RetaskScheduler->ReportIdle(GathererModule, EGathererIdleReason::NoResource);
+	}
+}
+
+bool UGatherMethod::ReserveGatheringSlot(ARTS_Actor* Resource, FVector& OutLocation)
+{
+	USlotReservationService* SlotService = USlotReservationService::Get(GathererModule);
+	if (!SlotService || !GathererModule->Owner || !SlotService->ReserveSlot(GathererModule->Owner, Resource, OutLocation))
+	{
+		return false;
+	}
+
+	MarkSlotTaken(Resource);
+	return true;
+}
+
+void UGatherMethod::ReleaseGatheringSlot()
+{
+	if (USlotReservationService* SlotService = GathererModule ? USlotReservationService::Get(GathererModule) : nullptr)
+	{
+		SlotService->ReleaseSlot(GathererModule->Owner);
+	}
+	MarkSlotFreed();
+}
+
+void UGatherMethod::LendGatheringSlot()
+{
+	if (USlotReservationService* SlotService = GathererModule ? USlotReservationService::Get(GathererModule) : nullptr)
+	{
+		SlotService->SuspendSlot(GathererModule->Owner);
+	}
+
+	// A lendable slot counts as free for resource searches
+	MarkSlotFreed();
+}
+
+void UGatherMethod::MarkSlotTaken(ARTS_Actor* Resource)
+{
+	if (OccupiedResource.Get() == Resource)
+	{
+		return;
+	}
+
+	MarkSlotFreed();
+	if (UResourceSpatialIndex* SpatialIndex = UResourceSpatialIndex::Get(GathererModule))
+	{
+		SpatialIndex->AddOccupant(Resource);
+	}
+	OccupiedResource = Resource;
+}
+
+void UGatherMethod::MarkSlotFreed()
+{
+	if (ARTS_Actor* Resource = OccupiedResource.Get())
+	{
+		if (UResourceSpatialIndex* SpatialIndex = UResourceSpatialIndex::Get(GathererModule))
+		{
+			SpatialIndex->RemoveOccupant(Resource);
+		}
+	}
+	OccupiedResource = nullptr;
 }
\ No newline at end of file
@@ -1,51 +1,119 @@
-﻿// GatherMethod.h
-#pragma once
-
-#include "AIController.h"
-#include "RTS_Actor.h"
-#include "GatherableModule/GatherableModule.h"
-#include "GathererModule/GathererModule.h"
-#include "Navigation/PathFollowingComponent.h"
-#include "SlotModule/SlotModule.h"
-#include "GatherMethod.generated.h"
-
-UCLASS(Abstract, Blueprintable, EditInlineNew)
-class DRAKTHYSPROJECT_API UGatherMethod : public UObject
-{
-	GENERATED_BODY()
-
-public:
-	void InitializeGatherMethod(UGathererModule* Gatherer);
-	
-	UPROPERTY()
-	UGathererModule* GathererModule;
-	
-	virtual void Gather(ARTS_Actor* ResourceTarget);
-	virtual void StopGather();
-	
-	FTimerHandle GatheringTimer;
-	
-	UPROPERTY()
-	TObjectPtr<UGatherableModule> GatherableModule;
-	
-	UPROPERTY()
-	TWeakObjectPtr<ARTS_Actor> CurrentGatheringTarget;
-
-	virtual bool GetGatheringLocation(FVector& OutLocation);
-	
-	float CurrentGatheringTime = 0.f;
-	float RequiredGatheringTime = 0.f;
-
-	void virtual StartGathering();
-	void virtual TickGathering();
-	void virtual CompleteGathering();
-	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gather Method")
-	bool bDrawDebugPath;
-
-	EResourceType ResourceTypePriority;
-
-	void virtual FindNewResource();
-	void virtual SetResourceTypePriority(EResourceType ResourceType);
-	// add FindNewResource
-};
+﻿// GatherMethod.h
+#pragma once
+
+#include "AIController.h"
+#include "RTS_Actor.h"
+#include "GatherableModule/GatherableModule.h"
+#include "GathererModule/GathererModule.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "RTS_ModuleScheduler.h"
+#include "EconomyCore/GatherPolicy.h"
+#include "GatherMethod.generated.h"
+
+UCLASS(Abstract, Blueprintable, EditInlineNew)
+class DRAKTHYSPROJECT_API UGatherMethod : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void InitializeGatherMethod(UGathererModule* Gatherer);
+	
+	UPROPERTY()
+	UGathererModule* GathererModule;
+	
+	virtual void Gather(ARTS_Actor* ResourceTarget);
+	virtual void StopGather();
+	
+	/** Single completion event for the current gathering cycle */
+	FRTSScheduleHandle GatheringTimer;
+
+	/** Optional progress ticker, only scheduled when the gatherer opted into progress broadcasts */
+	FRTSScheduleHandle GatheringProgressTimer;
+	
+	UPROPERTY()
+	TObjectPtr<UGatherableModule> GatherableModule;
+	
+	UPROPERTY()
+	TWeakObjectPtr<ARTS_Actor> CurrentGatheringTarget;
+
+	virtual bool GetGatheringLocation(FVector& OutLocation);
+	
+	/** World time the current cycle started at, negative while not gathering */
+	double GatheringStartTime = -1.0;
+	float RequiredGatheringTime = 0.f;
+
+	/** Elapsed time of the current cycle, derived from the start timestamp */
+	float GetCurrentGatheringTime() const;
+	bool IsGathering() const { return GatheringStartTime >= 0.0; }
+
+	/** Starts or stops the progress ticker to match UGathererModule::bBroadcastGatheringProgress */
+	void RefreshGatheringProgressBroadcast();
+
+	void virtual StartGathering();
+	void virtual TickGathering();
+	void virtual CompleteGathering();
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gather Method")
+	bool bDrawDebugPath;
+
+	EResourceType ResourceTypePriority;
+
+	/** Gives up the current slot and hands the gatherer to UGathererRetaskScheduler to be sent to a node with a free slot */
+	void virtual FindNewResource();
+	void virtual SetResourceTypePriority(EResourceType ResourceType);
+
+	/** How far the retask scheduler looks from the gatherer, 0 searches the whole map */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gather Method")
+	float FindResourceRadius = 5000.f;
+
+	/** First retask backoff when nothing was found, doubles with every further attempt up to the scheduler's MaxRetryDelay */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gather Method", meta = (ClampMin = "0.1"))
+	float FindResourceRetryDelay = 1.f;
+
+	/** Deposit trip: keeps the slot claim but lets USlotReservationService lend it out until the worker returns */
+	void LendGatheringSlot();
+	void ReleaseGatheringSlot();
+
+	/** Economy LOD: harvests per trip and units per harvest of this method's steady loop, false if it has none */
+	virtual bool GetSteadyStateYield(int32& OutHarvestsPerTrip, int32& OutAmountPerHarvest) const { return false; }
+
+	/** Economy LOD: restores method-local storage after HarvestsDone analytic harvests worth CarriedAmount */
+	virtual void RestoreSteadyStateProgress(int32 HarvestsDone, int32 CarriedAmount) {}
+
+	/** Economy LOD: continues a cycle on the current node that started ElapsedTime seconds ago */
+	void ResumeGathering(float ElapsedTime);
+
+protected:
+	/**
+	 * Stamps the start time and schedules exactly one CompleteGathering() after RequiredGatheringTime.
+	 * A fresh cycle may be handed to UGathererEconomyLOD instead, ElapsedTime > 0 resumes a cycle already under way.
+	 */
+	void BeginGatheringCycle(float ElapsedTime = 0.f);
+	
+	/** Cancels the completion event and progress ticker of the current cycle */
+	void EndGatheringCycle();
+
+	/** Claims a slot on Resource from USlotReservationService, OutLocation is where to stand */
+	bool ReserveGatheringSlot(ARTS_Actor* Resource, FVector& OutLocation);
+
+	/** Keeps UResourceSpatialIndex slot occupancy in sync with the slot this gatherer holds */
+	void MarkSlotTaken(ARTS_Actor* Resource);
+	void MarkSlotFreed();
+
+	/** Queues a harvest on the current node with UHarvestResolver, the result arrives in OnHarvestResolved */
+	void RequestHarvest(int32 Amount);
+
+	/** Result of the last RequestHarvest, not called if the gatherer was stopped in between */
+	virtual void OnHarvestResolved(bool bHarvested, int32 Amount, EResourceType ResourceType) {}
+
+	/** What the gatherer carries in EconomyCore terms, Stored is the method-local fill level */
+	RTSEconomy::FGathererState GetCoreState(int32 Stored) const;
+
+	TWeakObjectPtr<ARTS_Actor> OccupiedResource;
+
+private:
+	void HandleHarvestResolved(bool bHarvested, int32 Amount, EResourceType ResourceType, uint32 Serial);
+
+	/** Bumped by StopGather so a harvest resolved after the stop is dropped */
+	uint32 HarvestSerial = 0;
+};
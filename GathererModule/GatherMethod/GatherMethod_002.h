@@ -1,39 +1,41 @@
-// Copyright AmberleafCotton 2025. All Rights Reserved.
-#pragma once
-
-#include "GatherMethod.h"
-#include "SlotModule/SlotModule.h"
-#include "GatherMethod_002.generated.h"
-
-UCLASS(Blueprintable, EditInlineNew)
-class DRAKTHYSPROJECT_API UGatherMethod_002 : public UGatherMethod
-{
-	GENERATED_BODY()
-
-public:
-	virtual void Gather(ARTS_Actor* ResourceTarget) override;
-	virtual void StopGather() override;
-
-	virtual void StartGathering() override;
-	virtual void TickGathering() override;
-	virtual void CompleteGathering() override;
-	
-	// Method-specific gathering location logic
-	virtual bool GetGatheringLocation(FVector& OutLocation) override;
-
-	UPROPERTY()
-	TObjectPtr<USlotModule> SlotModule;
-
-	// Configurable power values
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gather Method")
-	int32 HarvestPower = 1; // units per cycle
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gather Method")
-	int32 StoragePower = 5; // max units before deposit
-
-	// Internal storage tracking
-	UPROPERTY(BlueprintReadWrite, Category = "Gather Method")
-	int32 CurrentStoredUnits = 0;
-};
-
-
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "GatherMethod.h"
+#include "GatherMethod_002.generated.h"
+
+UCLASS(Blueprintable, EditInlineNew)
+class DRAKTHYSPROJECT_API UGatherMethod_002 : public UGatherMethod
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Gather(ARTS_Actor* ResourceTarget) override;
+
+	virtual void StartGathering() override;
+	virtual void CompleteGathering() override;
+
+	virtual void OnHarvestResolved(bool bHarvested, int32 Amount, EResourceType ResourceType) override;
+
+	virtual bool GetSteadyStateYield(int32& OutHarvestsPerTrip, int32& OutAmountPerHarvest) const override;
+	virtual void RestoreSteadyStateProgress(int32 HarvestsDone, int32 CarriedAmount) override;
+
+	/** Units storage policy for EconomyCore */
+	RTSEconomy::FGatherPolicy GetGatherPolicy() const;
+	
+	// Method-specific gathering location logic
+	virtual bool GetGatheringLocation(FVector& OutLocation) override;
+
+	// Configurable power values
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gather Method")
+	int32 HarvestPower = 1; // units per cycle
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gather Method")
+	int32 StoragePower = 5; // max units before deposit
+
+	// Internal storage tracking
+	UPROPERTY(BlueprintReadWrite, Category = "Gather Method")
+	int32 CurrentStoredUnits = 0;
+};
+
+
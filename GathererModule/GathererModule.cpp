@@ -1,173 +1,411 @@
-﻿// Copyright AmberleafCotton 2025. All Rights Reserved.
-#include "GathererModule.h"
-#include "GameFramework/Actor.h"
-#include "GatherMethod/GatherMethod.h"
-#include "DepositMethod/DepositMethod.h"
-#include "GatherableModule/GatherableModule.h"
-#include "DrawDebugHelpers.h"
-#include "AIController.h"
-#include "Navigation/PathFollowingComponent.h"
-#include "GameFramework/Pawn.h"
-
-UGathererModule::UGathererModule()
-{
-	// Constructor
-}
-
-void UGathererModule::InitializeModule_Implementation(ARTS_Actor* InOwner)
-{
-	Super::InitializeModule_Implementation(InOwner);
-
-	// Cache AI controller and path following component
-	if (APawn* OwnerPawn = Cast<APawn>(Owner))
-	{
-		CachedAIController = Cast<AAIController>(OwnerPawn->GetController());
-		if (CachedAIController)
-		{
-			CachedPathComp = CachedAIController->GetPathFollowingComponent();
-		}
-	}
-
-	if (GatherMethod)
-	{
-		GatherMethod->InitializeGatherMethod(this);
-	}
-	if (DepositMethod)
-	{
-		DepositMethod->InitializeDepositMethod(this);
-	}
-}
-
-void UGathererModule::ExecuteGathererModule(ARTS_Actor* InTargetResource)
-{
-	TargetResource = InTargetResource;
-
-	// Neutral coordinator: always enter Gathering; methods decide policy and transitions
-	CurrentState = EGathererState::Gathering;
-    if (GatherMethod)
-	{
-        UE_LOG(LogTemp, Verbose, TEXT("UGathererModule::ExecuteGather - forwarding to GatherMethod. Target=%s"), InTargetResource ? *InTargetResource->GetName() : TEXT("null"));
-		GatherMethod->Gather(InTargetResource);
-	}
-}
-
-void UGathererModule::StopGathererModule()
-{
-	UnbindMovementEvents();
-	CurrentState = EGathererState::Idle;
-	TargetResource = nullptr;
-
-	if (GatherMethod)
-	{
-		GatherMethod->StopGather();
-	}
-
-	if (DepositMethod)
-	{
-		DepositMethod->StopDeposit();
-	}
-}
-
-void UGathererModule::MoveToLocation(FVector Location)
-{
-	if (CachedAIController)
-	{
-        UE_LOG(LogTemp, Log, TEXT("UGathererModule::MoveToLocation() - Starting movement to: %s"), *Location.ToString());
-        
-        // Stop any current movement first to ensure clean state
-        CachedAIController->StopMovement();
-        
-        // Unbind previous events
-        UnbindMovementEvents();
-
-        // Bind new events
-        BindMovementEvents();
-
-        // Execute movement
-        FAIMoveRequest MoveRequest;
-        MoveRequest.SetGoalLocation(Location);
-        MoveRequest.SetAcceptanceRadius(1.0f); 
-		
-        CachedAIController->MoveTo(MoveRequest);
-	}
-}
-
-void UGathererModule::StopMovement()
-{
-	if (CachedAIController)
-	{
-		CachedAIController->StopMovement();
-		UnbindMovementEvents();
-	}
-}
-
-void UGathererModule::BindMovementEvents()
-{
-	if (CachedPathComp)
-	{
-		UE_LOG(LogTemp, Log, TEXT("UGathererModule::BindMovementEvents() - Binding movement completion event"));
-		CachedPathComp->OnRequestFinished.AddUObject(this, &UGathererModule::OnMovementCompleted);
-	}
-}
-
-void UGathererModule::UnbindMovementEvents()
-{
-	if (CachedPathComp)
-	{
-		UE_LOG(LogTemp, Log, TEXT("UGathererModule::UnbindMovementEvents() - Unbinding movement completion event"));
-		CachedPathComp->OnRequestFinished.RemoveAll(this);
-	}
-}
-
-void UGathererModule::OnMovementCompleted(FAIRequestID /*RequestID*/, const FPathFollowingResult& Result)
-{
-    UE_LOG(LogTemp, Log, TEXT("UGathererModule::OnMovementCompleted() - Result: %s"), 
-           Result.Code == EPathFollowingResult::Success ? TEXT("Success") : TEXT("Failed"));
-    
-    if (Result.Code == EPathFollowingResult::Success)
-	{
-		UnbindMovementEvents();
-		UE_LOG(LogTemp, Log, TEXT("UGathererModule::OnMovementCompleted() - Re-entering ExecuteGathererModule"));
-		ExecuteGathererModule(TargetResource.Get());
-	}
-    else
-    {
-        // Failure: ensure we do not leak bindings; optional retry/abort policy could be added later
-        // Maybe add delay here to retry later
-        UE_LOG(LogTemp, Warning, TEXT("UGathererModule::OnMovementCompleted() - Movement failed, unbinding events"));
-        UnbindMovementEvents();
-    }
-}
-
-void UGathererModule::ResourceGathered(int32 ResourceAmount, EResourceType ResourceType)
-{
-	// Event-only: update minimal state + broadcast
-	CurrentResourceAmount += ResourceAmount; // accumulation fix
-	CurrentResourceType = ResourceType;
-	OnResourceGathered.Broadcast(TargetResource.Get(), ResourceAmount);
-}
-
-void UGathererModule::ResourceDeposited(int32 DepositedAmount, EResourceType ResourceType)
-{
-	// Event-only: update minimal state + broadcast
-	CurrentResourceAmount = 0;
-	OnResourceDeposited.Broadcast(ResourceType, DepositedAmount);
-}
-
-void UGathererModule::RequestDeposit()
-{
-	CurrentState = EGathererState::Depositing;
-	if (DepositMethod)
-	{
-		DepositMethod->Deposit();
-	}
-}
-
-void UGathererModule::RequestContinueGather()
-{
-	CurrentState = EGathererState::Gathering;
-	if (GatherMethod)
-	{
-		GatherMethod->Gather(TargetResource.Get());
-	}
-}
\ No newline at end of file
+﻿// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "GathererModule.h"
+#include "GameFramework/Actor.h"
+#include "GatherMethod/GatherMethod.h"
+#include "DepositMethod/DepositMethod.h"
+#include "RTS_Stats.h"
+#include "RTS_UIEventSubsystem.h"
+#include "GatherableModule/GatherableModule.h"
+#include "DrawDebugHelpers.h"
+#include "AIController.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "NavigationData.h"
+#include "NavMesh/NavMeshPath.h"
+#include "GameFramework/Pawn.h"
+#include "Movement/GathererMovementQueue.h"
+#include "Movement/GathererMovementRouter.h"
+#include "Economy/GathererEconomyLOD.h"
+#include "Economy/GathererRetaskScheduler.h"
+#include "GameFramework/PawnMovementComponent.h"
+
+UGathererModule::UGathererModule()
+{
+	// Constructor
+}
+
+void UGathererModule::InitializeModule_Implementation(ARTS_Actor* InOwner)
+{
+	Super::InitializeModule_Implementation(InOwner);
+
+	// Cache AI controller and path following component
+	if (APawn* OwnerPawn = Cast<APawn>(Owner))
+	{
+		CachedAIController = Cast<AAIController>(OwnerPawn->GetController());
+		if (CachedAIController)
+		{
+			CachedPathComp = CachedAIController->GetPathFollowingComponent();
+		}
+	}
+
+	if (GatherMethod)
+	{
+		GatherMethod->InitializeGatherMethod(this);
+	}
+	if (DepositMethod)
+	{
+		DepositMethod->InitializeDepositMethod(this);
+	}
+}
+
+void UGathererModule::ResetModule_Implementation()
+{
+	Super::ResetModule_Implementation();
+
+	StopMovement();
+	StopGathererModule();
+	CurrentResourceAmount = 0;
+}
+
+void UGathererModule::ExecuteGathererModule(ARTS_Actor* InTargetResource)
+{
+	RTS_MODULE_SCOPE(STAT_RTS_GathererExecute);
+
+	WakeFromEconomyLOD();
+	if (RetaskState.bQueued)
+	{
+		// A new order overrides the pending retask, the idle period runs until the first harvest
+		if (UGathererRetaskScheduler* RetaskScheduler = UGathererRetaskScheduler::Get(this))
+		{
+			RetaskScheduler->Remove(this);
+		}
+	}
+	TargetResource = InTargetResource;
+
+	// Neutral coordinator: always enter Gathering; methods decide policy and transitions
+	CurrentState = EGathererState::Gathering;
+    if (GatherMethod)
+	{
+        UE_LOG(LogTemp, Verbose, TEXT("UGathererModule::ExecuteGather - forwarding to GatherMethod. Target=%s"), InTargetResource ? *InTargetResource->GetName() : TEXT("null"));
+		GatherMethod->Gather(InTargetResource);
+	}
+}
+
+void UGathererModule::StopGathererModule()
+{
+	WakeFromEconomyLOD();
+	UntrackMove();
+	if (UGathererMovementQueue* MovementQueue = UGathererMovementQueue::Get(this))
+	{
+		MovementQueue->CancelMove(this);
+	}
+	if (RetaskState.bQueued || RetaskState.IdleSince >= 0.0)
+	{
+		if (UGathererRetaskScheduler* RetaskScheduler = UGathererRetaskScheduler::Get(this))
+		{
+			RetaskScheduler->Remove(this);
+			RetaskScheduler->EndIdlePeriod(this);
+		}
+	}
+	CurrentState = EGathererState::Idle;
+	TargetResource = nullptr;
+
+	if (GatherMethod)
+	{
+		GatherMethod->StopGather();
+	}
+
+	if (DepositMethod)
+	{
+		DepositMethod->StopDeposit();
+	}
+}
+
+void UGathererModule::MoveToLocation(FVector Location)
+{
+	RTS_MODULE_SCOPE(STAT_RTS_GathererMoveTo);
+	INC_DWORD_STAT(STAT_RTS_MoveRequests);
+
+	if (CachedAIController)
+	{
+        UE_LOG(LogTemp, Log, TEXT("UGathererModule::MoveToLocation() - Starting movement to: %s"), *Location.ToString());
+        
+        // Forget the current leg before stopping, its abort is not ours to handle
+        UntrackMove();
+
+        // Stop any current movement first to ensure clean state
+        CachedAIController->StopMovement();
+
+        // Path finding runs batched and async, FollowPath picks up from there
+        if (UGathererMovementQueue* MovementQueue = UGathererMovementQueue::Get(this))
+        {
+            MovementQueue->RequestMove(this, Location);
+            return;
+        }
+
+        // Execute movement
+        FAIMoveRequest MoveRequest;
+        MoveRequest.SetGoalLocation(Location);
+        MoveRequest.SetAcceptanceRadius(1.0f); 
+		
+        const FPathFollowingRequestResult MoveResult = CachedAIController->MoveTo(MoveRequest);
+        if (MoveResult.Code == EPathFollowingRequestResult::AlreadyAtGoal)
+        {
+            // Finished inside MoveTo, before it could be tracked
+            HandleMovementCompleted(MoveResult.MoveId, FPathFollowingResult(EPathFollowingResult::Success, FPathFollowingResultFlags::AlreadyAtGoal));
+        }
+        else
+        {
+            TrackMove(MoveResult.MoveId);
+        }
+	}
+}
+
+void UGathererModule::StopMovement()
+{
+	if (UGathererMovementQueue* MovementQueue = UGathererMovementQueue::Get(this))
+	{
+		MovementQueue->CancelMove(this);
+	}
+
+	if (CachedAIController)
+	{
+		UntrackMove();
+		CachedAIController->StopMovement();
+	}
+}
+
+void UGathererModule::FollowPath(const FVector& Goal, FNavPathSharedPtr Path)
+{
+	if (!CachedAIController)
+	{
+		return;
+	}
+
+	if (!Path.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UGathererModule::FollowPath() - No path to %s"), *Goal.ToString());
+		ReportMoveFailed();
+		return;
+	}
+
+	FAIMoveRequest MoveRequest;
+	MoveRequest.SetGoalLocation(Goal);
+	MoveRequest.SetAcceptanceRadius(1.0f);
+
+	TrackMove(CachedAIController->RequestMove(MoveRequest, MakeOwnPath(Path)));
+}
+
+FNavPathSharedPtr UGathererModule::MakeOwnPath(const FNavPathSharedPtr& SharedPath)
+{
+	// Batched and cached paths are handed to many workers, each follows its own copy so a navmesh change
+	// recalculates that worker's path instead of aborting everyone on the shared one
+	const ANavigationData* NavData = SharedPath->GetNavigationDataUsed();
+	if (!NavData)
+	{
+		return SharedPath;
+	}
+
+	const FNavMeshPath* SharedNavMeshPath = SharedPath->CastPath<FNavMeshPath>();
+	FNavPathSharedPtr OwnPath = SharedNavMeshPath
+		? NavData->CreatePathInstance<FNavMeshPath>(SharedPath->GetQueryData())
+		: NavData->CreatePathInstance<FNavigationPath>(SharedPath->GetQueryData());
+
+	OwnPath->GetPathPoints() = SharedPath->GetPathPoints();
+	if (SharedNavMeshPath)
+	{
+		FNavMeshPath* OwnNavMeshPath = OwnPath->CastPath<FNavMeshPath>();
+		OwnNavMeshPath->PathCorridor = SharedNavMeshPath->PathCorridor;
+		OwnNavMeshPath->PathCorridorCost = SharedNavMeshPath->PathCorridorCost;
+	}
+	OwnPath->SetIsPartial(SharedPath->IsPartial());
+	OwnPath->MarkReady();
+	OwnPath->EnableRecalculationOnInvalidation(true);
+	return OwnPath;
+}
+
+void UGathererModule::TrackMove(FAIRequestID RequestID)
+{
+	if (UGathererMovementRouter* MovementRouter = UGathererMovementRouter::Get(this))
+	{
+		MovementRouter->TrackMove(this, CachedPathComp, RequestID);
+	}
+}
+
+void UGathererModule::UntrackMove()
+{
+	if (UGathererMovementRouter* MovementRouter = UGathererMovementRouter::Get(this))
+	{
+		MovementRouter->UntrackMove(this);
+	}
+}
+
+void UGathererModule::HandleMovementCompleted(FAIRequestID /*RequestID*/, const FPathFollowingResult& Result)
+{
+	RTS_MODULE_SCOPE(STAT_RTS_GathererMovementCompleted);
+
+    UE_LOG(LogTemp, Log, TEXT("UGathererModule::HandleMovementCompleted() - Result: %s"), 
+           Result.Code == EPathFollowingResult::Success ? TEXT("Success") : TEXT("Failed"));
+    
+    if (Result.Code == EPathFollowingResult::Success)
+	{
+		UE_LOG(LogTemp, Log, TEXT("UGathererModule::HandleMovementCompleted() - Re-entering ExecuteGathererModule"));
+		ExecuteGathererModule(TargetResource.Get());
+	}
+    else if (Result.Code != EPathFollowingResult::Aborted || Result.HasFlag(FPathFollowingResultFlags::InvalidPath))
+    {
+        // Plain aborts come from a newer order, anything else (a path the navmesh invalidated included) leaves the worker stranded
+        UE_LOG(LogTemp, Warning, TEXT("UGathererModule::HandleMovementCompleted() - Movement failed"));
+        ReportMoveFailed();
+    }
+}
+
+void UGathererModule::ReportMoveFailed()
+{
+	UGathererRetaskScheduler* RetaskScheduler = UGathererRetaskScheduler::Get(this);
+	if (!RetaskScheduler)
+	{
+		return;
+	}
+
+	// A worker that cannot reach its slot gives it up, deposit trips keep theirs and retry the drop-off
+	if (CurrentState != EGathererState::Depositing && GatherMethod)
+	{
+		GatherMethod->ReleaseGatheringSlot();
+	}
+	RetaskScheduler->ReportIdle(this, EGathererIdleReason::MoveFailed);
+}
+
+void UGathererModule::ResourceGathered(int32 ResourceAmount, EResourceType ResourceType)
+{
+	// Event-only: update minimal state + broadcast
+	CurrentResourceAmount += ResourceAmount; // accumulation fix
+	CurrentResourceType = ResourceType;
+	EndRetaskIdle();
+	OnResourceGathered.Broadcast(TargetResource.Get(), ResourceAmount);
+	URTS_UIEventSubsystem::PostEvent(Owner, ERTSUIEvent::CarriedResourcesChanged);
+}
+
+void UGathererModule::ResourceDeposited(int32 DepositedAmount, EResourceType ResourceType)
+{
+	// Event-only: update minimal state + broadcast
+	INC_DWORD_STAT(STAT_RTS_Deposits);
+	CurrentResourceAmount = 0;
+	EndRetaskIdle();
+	if (LoopSample.LeaveNodeTime >= 0.0 && Owner)
+	{
+		LoopSample.DepositTime = GetWorld()->GetTimeSeconds();
+		LoopSample.DepositLocation = Owner->GetActorLocation();
+	}
+	OnResourceDeposited.Broadcast(ResourceType, DepositedAmount);
+	URTS_UIEventSubsystem::PostEvent(Owner, ERTSUIEvent::CarriedResourcesChanged);
+}
+
+void UGathererModule::EndRetaskIdle()
+{
+	if (RetaskState.IdleSince < 0.0 && RetaskState.Attempts == 0)
+	{
+		return;
+	}
+
+	if (UGathererRetaskScheduler* RetaskScheduler = UGathererRetaskScheduler::Get(this))
+	{
+		RetaskScheduler->EndIdlePeriod(this);
+	}
+}
+
+void UGathererModule::RequestDeposit()
+{
+	CurrentState = EGathererState::Depositing;
+
+	// Start of the away leg of the loop sample
+	if (Owner)
+	{
+		LoopSample.Target = TargetResource;
+		LoopSample.SlotLocation = Owner->GetActorLocation();
+		LoopSample.LeaveNodeTime = GetWorld()->GetTimeSeconds();
+		LoopSample.DepositTime = -1.0;
+	}
+
+	// The gathering slot can serve another worker while this one is away
+	if (GatherMethod)
+	{
+		GatherMethod->LendGatheringSlot();
+	}
+
+	if (DepositMethod)
+	{
+		DepositMethod->Deposit();
+	}
+}
+
+void UGathererModule::RequestContinueGather()
+{
+	CurrentState = EGathererState::Gathering;
+	if (GatherMethod)
+	{
+		GatherMethod->Gather(TargetResource.Get());
+	}
+}
+
+void UGathererModule::SetBroadcastGatheringProgress(bool bEnabled)
+{
+	bBroadcastGatheringProgress = bEnabled;
+	if (GatherMethod)
+	{
+		GatherMethod->RefreshGatheringProgressBroadcast();
+	}
+}
+
+bool UGathererModule::HasActiveProgress() const
+{
+	return GatherMethod && GatherMethod->IsGathering();
+}
+
+void UGathererModule::GetGatheringProgress(float& OutCurrentGatheringTime, float& OutRequiredGatheringTime) const
+{
+	OutCurrentGatheringTime = GatherMethod ? GatherMethod->GetCurrentGatheringTime() : 0.f;
+	OutRequiredGatheringTime = GatherMethod && GatherMethod->IsGathering() ? GatherMethod->RequiredGatheringTime : 0.f;
+}
+
+bool UGathererModule::TryEnterEconomyLOD()
+{
+	if (bInEconomyLOD || !Owner || CurrentResourceAmount > 0)
+	{
+		return false;
+	}
+
+	// Back at the same slot with empty hands closes the trip that started at RequestDeposit
+	if (LoopSample.DepositTime >= 0.0)
+	{
+		const bool bSameLoop = LoopSample.Target == TargetResource
+			&& FVector::DistSquared2D(Owner->GetActorLocation(), LoopSample.SlotLocation) <= FMath::Square(50.f);
+		LoopSample.OutboundTime = bSameLoop ? static_cast<float>(LoopSample.DepositTime - LoopSample.LeaveNodeTime) : -1.f;
+		LoopSample.ReturnTime = bSameLoop ? static_cast<float>(GetWorld()->GetTimeSeconds() - LoopSample.DepositTime) : -1.f;
+		LoopSample.LeaveNodeTime = -1.0;
+		LoopSample.DepositTime = -1.0;
+	}
+
+	UGathererEconomyLOD* EconomyLOD = UGathererEconomyLOD::Get(this);
+	return EconomyLOD && EconomyLOD->TryFastForward(this);
+}
+
+void UGathererModule::SetEconomyLODActive(bool bActive)
+{
+	bInEconomyLOD = bActive;
+
+	// CharacterMovement would otherwise keep ticking a worker that is standing still on purpose
+	if (const APawn* OwnerPawn = Cast<APawn>(Owner))
+	{
+		if (UPawnMovementComponent* MovementComponent = OwnerPawn->GetMovementComponent())
+		{
+			MovementComponent->SetComponentTickEnabled(!bActive);
+		}
+	}
+}
+
+void UGathererModule::WakeFromEconomyLOD()
+{
+	if (!bInEconomyLOD)
+	{
+		return;
+	}
+
+	if (UGathererEconomyLOD* EconomyLOD = UGathererEconomyLOD::Get(this))
+	{
+		EconomyLOD->Rehydrate(this, false);
+	}
+	else
+	{
+		SetEconomyLODActive(false);
+	}
+}
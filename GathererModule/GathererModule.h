@@ -1,107 +1,193 @@
-﻿// Copyright 2025 AmberleafCotton. All rights reserved.
-#pragma once
-
-#include "ResourceTypes.h"
-#include "RTS_Actor.h"
-#include "RTS_Module.h"
-#include "Navigation/PathFollowingComponent.h"
-#include "GathererModule.generated.h"
-
-class UDepositMethod;
-class UGatherMethod;
-class AAIController;
-class UPathFollowingComponent;
-
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnResourceGathered, ARTS_Actor*, ResourceTarget, int32, ResourceAmount);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGatheringProgress, float, CurrentGatheringTime, float, RequiredGatheringTime);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnResourceDeposited, EResourceType, ResourceType, int32, DepositedAmount);
-
-UENUM(BlueprintType)
-enum class EGathererState : uint8
-{
-	Idle,
-	Gathering,
-	Depositing
-};
-
-/**
- * A module that handles gathering logic for units.
- */
-UCLASS(Abstract, Blueprintable, EditInlineNew)
-class DRAKTHYSPROJECT_API UGathererModule : public URTS_Module
-{
-	GENERATED_BODY()
-
-public:
-	UGathererModule();
-	
-	virtual void InitializeModule_Implementation(ARTS_Actor* InOwner) override;
-
-	UPROPERTY()
-	TWeakObjectPtr<ARTS_Actor> TargetResource;
-
-	UFUNCTION(BlueprintCallable, Category = "Gatherer Module")
-	void ExecuteGathererModule(ARTS_Actor* InTargetResource);
-
-	UFUNCTION(BlueprintCallable, Category = "Gatherer Module")
-	void StopGathererModule();
-	
-	void ResourceGathered(int32 ResourceAmount, EResourceType ResourceType);
-	
-	UFUNCTION(BlueprintCallable, Category = "Gatherer Module")
-	void ResourceDeposited(int32 DepositedAmount, EResourceType ResourceType);
-
-	// Task 21: Module transition API (methods drive next steps)
-	void RequestDeposit();
-	void RequestContinueGather();
-
-	// Movement functions for Task 12
-	UFUNCTION(BlueprintCallable, Category = "Gatherer Module")
-	void MoveToLocation(FVector Location);
-	
-	UFUNCTION(BlueprintCallable, Category = "Gatherer Module")
-	void StopMovement();
-
-	UPROPERTY(BlueprintAssignable, Category = "Gatherer Module")
-	FOnGatheringProgress OnGatheringProgress;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Instanced, Category = "Gatherer Module")
-	TObjectPtr<UGatherMethod> GatherMethod;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Instanced, Category = "Gatherer Module")
-	TObjectPtr<UDepositMethod> DepositMethod;
-	
-	UPROPERTY(BlueprintReadWrite, Category = "Gatherer Module")
-	int32 CurrentResourceAmount = 0;
-	
-	UPROPERTY(BlueprintReadWrite, Category = "Gatherer Module")
-	EResourceType CurrentResourceType;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Module")
-	int32 MaxResourceStorage = 1;
-	
-	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Module")
-	EGathererState CurrentState = EGathererState::Idle;
-	
-	/** Called when a resource is gathered */
-	UPROPERTY(BlueprintAssignable, Category = "Gatherer Module")
-	FOnResourceGathered OnResourceGathered;
-	
-	/** Called when a resource is deposited */
-	UPROPERTY(BlueprintAssignable, Category = "Gatherer Module")
-	FOnResourceDeposited OnResourceDeposited;
-
-private:
-	// Cached movement references
-	UPROPERTY()
-	TObjectPtr<AAIController> CachedAIController = nullptr;
-	
-	UPROPERTY()
-	TObjectPtr<UPathFollowingComponent> CachedPathComp = nullptr;
-	
-	// Movement event handling
-	void OnMovementCompleted(FAIRequestID /*RequestID*/, const FPathFollowingResult& Result);
-	void BindMovementEvents();
-	void UnbindMovementEvents();
-	
-};
+﻿// Copyright 2025 AmberleafCotton. All rights reserved.
+#pragma once
+
+#include "ResourceTypes.h"
+#include "RTS_Actor.h"
+#include "RTS_Module.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "GathererModule.generated.h"
+
+class UDepositMethod;
+class UGatherMethod;
+class AAIController;
+class UPathFollowingComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnResourceGathered, ARTS_Actor*, ResourceTarget, int32, ResourceAmount);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGatheringProgress, float, CurrentGatheringTime, float, RequiredGatheringTime);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnResourceDeposited, EResourceType, ResourceType, int32, DepositedAmount);
+
+UENUM(BlueprintType)
+enum class EGathererState : uint8
+{
+	Idle,
+	Gathering,
+	Depositing
+};
+
+/** Timings of the worker's last real node -> deposit -> node trip, measured for UGathererEconomyLOD */
+struct FGatherLoopSample
+{
+	TWeakObjectPtr<ARTS_Actor> Target;
+	FVector SlotLocation = FVector::ZeroVector;
+	FVector DepositLocation = FVector::ZeroVector;
+	double LeaveNodeTime = -1.0;
+	double DepositTime = -1.0;
+
+	/** Node to deposit, including the time spent depositing */
+	float OutboundTime = -1.f;
+
+	/** Deposit back to the slot */
+	float ReturnTime = -1.f;
+
+	bool IsMeasured() const { return OutboundTime >= 0.f && ReturnTime >= 0.f; }
+};
+
+/** Bookkeeping of UGathererRetaskScheduler on the worker */
+struct FGathererRetaskState
+{
+	/** World time the worker ran out of work, negative while it is working */
+	double IdleSince = -1.0;
+
+	/** Retasks since the last harvest or deposit, drives the backoff */
+	int32 Attempts = 0;
+
+	bool bQueued = false;
+};
+
+/**
+ * A module that handles gathering logic for units.
+ */
+UCLASS(Abstract, Blueprintable, EditInlineNew)
+class DRAKTHYSPROJECT_API UGathererModule : public URTS_Module
+{
+	GENERATED_BODY()
+
+public:
+	UGathererModule();
+	
+	virtual void InitializeModule_Implementation(ARTS_Actor* InOwner) override;
+	virtual void ResetModule_Implementation() override;
+	virtual bool SupportsSharedArchetype() const override { return true; }
+	virtual bool HasActiveProgress() const override;
+
+	UPROPERTY()
+	TWeakObjectPtr<ARTS_Actor> TargetResource;
+
+	UFUNCTION(BlueprintCallable, Category = "Gatherer Module")
+	void ExecuteGathererModule(ARTS_Actor* InTargetResource);
+
+	UFUNCTION(BlueprintCallable, Category = "Gatherer Module")
+	void StopGathererModule();
+	
+	void ResourceGathered(int32 ResourceAmount, EResourceType ResourceType);
+	
+	UFUNCTION(BlueprintCallable, Category = "Gatherer Module")
+	void ResourceDeposited(int32 DepositedAmount, EResourceType ResourceType);
+
+	// Task 21: Module transition API (methods drive next steps)
+	void RequestDeposit();
+	void RequestContinueGather();
+
+	// Movement functions for Task 12
+	UFUNCTION(BlueprintCallable, Category = "Gatherer Module")
+	void MoveToLocation(FVector Location);
+	
+	UFUNCTION(BlueprintCallable, Category = "Gatherer Module")
+	void StopMovement();
+
+	/** Starts following a path resolved by UGathererMovementQueue, a null path means no path to Goal was found */
+	void FollowPath(const FVector& Goal, FNavPathSharedPtr Path);
+
+	AAIController* GetAIController() const { return CachedAIController; }
+
+	/** Completion of the tracked move, delivered by UGathererMovementRouter */
+	void HandleMovementCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result);
+
+	/**
+	 * Called at the start of a gathering cycle. Completes the loop sample when the worker is back from a deposit
+	 * and hands the worker to UGathererEconomyLOD if it qualifies, true means the cycle runs analytically instead.
+	 */
+	bool TryEnterEconomyLOD();
+
+	bool IsInEconomyLOD() const { return bInEconomyLOD; }
+
+	/** Set by UGathererEconomyLOD, movement stops ticking while the loop is fast-forwarded */
+	void SetEconomyLODActive(bool bActive);
+
+	const FGatherLoopSample& GetLoopSample() const { return LoopSample; }
+
+	/** Owned by UGathererRetaskScheduler */
+	FGathererRetaskState RetaskState;
+
+	UPROPERTY(BlueprintAssignable, Category = "Gatherer Module")
+	FOnGatheringProgress OnGatheringProgress;
+
+	/** Broadcast OnGatheringProgress while gathering. Turn off for workers nobody listens to, progress can be polled instead */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Gatherer Module")
+	bool bBroadcastGatheringProgress = true;
+
+	/** How often OnGatheringProgress fires when enabled */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Gatherer Module", meta = (ClampMin = "0.05"))
+	float GatheringProgressInterval = 0.2f;
+
+	UFUNCTION(BlueprintCallable, Category = "Gatherer Module")
+	void SetBroadcastGatheringProgress(bool bEnabled);
+
+	/** Current/required time of the active gathering cycle, computed from world time on demand */
+	UFUNCTION(BlueprintPure, Category = "Gatherer Module")
+	void GetGatheringProgress(float& OutCurrentGatheringTime, float& OutRequiredGatheringTime) const;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Instanced, Category = "Gatherer Module")
+	TObjectPtr<UGatherMethod> GatherMethod;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Instanced, Category = "Gatherer Module")
+	TObjectPtr<UDepositMethod> DepositMethod;
+	
+	UPROPERTY(BlueprintReadWrite, Category = "Gatherer Module")
+	int32 CurrentResourceAmount = 0;
+	
+	UPROPERTY(BlueprintReadWrite, Category = "Gatherer Module")
+	EResourceType CurrentResourceType;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Module")
+	int32 MaxResourceStorage = 1;
+	
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Module")
+	EGathererState CurrentState = EGathererState::Idle;
+	
+	/** Called when a resource is gathered */
+	UPROPERTY(BlueprintAssignable, Category = "Gatherer Module")
+	FOnResourceGathered OnResourceGathered;
+	
+	/** Called when a resource is deposited */
+	UPROPERTY(BlueprintAssignable, Category = "Gatherer Module")
+	FOnResourceDeposited OnResourceDeposited;
+
+private:
+	// Cached movement references
+	UPROPERTY()
+	TObjectPtr<AAIController> CachedAIController = nullptr;
+	
+	UPROPERTY()
+	TObjectPtr<UPathFollowingComponent> CachedPathComp = nullptr;
+	
+	// Movement completion routing
+	void TrackMove(FAIRequestID RequestID);
+	void UntrackMove();
+
+	/** Copy of a path handed out by the movement queue, registered with its nav data and recalculated when invalidated */
+	static FNavPathSharedPtr MakeOwnPath(const FNavPathSharedPtr& SharedPath);
+
+	/** Hands a fast-forwarded worker back to the real simulation before it takes a new order */
+	void WakeFromEconomyLOD();
+
+	/** Hands a worker whose path failed to UGathererRetaskScheduler */
+	void ReportMoveFailed();
+
+	/** Back to work: closes the idle period and resets the retask backoff */
+	void EndRetaskIdle();
+
+	FGatherLoopSample LoopSample;
+	bool bInEconomyLOD = false;
+	
+};
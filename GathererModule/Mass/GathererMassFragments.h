@@ -0,0 +1,105 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "MassEntityTypes.h"
+#include "ResourceTypes.h"
+#include "GathererModule/GathererModule.h"
+#include "GathererMassFragments.generated.h"
+
+class ARTS_Actor;
+class URTS_DataAsset;
+class UGatherableModule;
+
+/** Which UGatherMethod policy a simulated worker runs */
+UENUM(BlueprintType)
+enum class EGathererMassPolicy : uint8
+{
+	/** UGatherMethod_001: harvests one stack per cycle, deposits after StacksStorageAmount stacks */
+	Stacks,
+	/** UGatherMethod_002: harvests HarvestPower units per cycle, deposits after StoragePower units */
+	Units
+};
+
+/** Per-worker gatherer state, the Mass counterpart of UGathererModule plus its gather method counters */
+USTRUCT()
+struct FGathererStateFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	int32 CurrentResourceAmount = 0;
+	EResourceType CarriedType = EResourceType::Wood;
+	EGathererState CurrentState = EGathererState::Idle;
+
+	/** UGatherMethod_001::CurrentGatheredStacks */
+	int32 StoredStacks = 0;
+
+	/** UGatherMethod_002::CurrentStoredUnits */
+	int32 StoredUnits = 0;
+
+	/** Ring position around the resource, stands in for a USlotReservationService slot */
+	int32 SlotIndex = INDEX_NONE;
+
+	/** World time the current gather or deposit action started, negative while moving or idle */
+	double ActionStartTime = -1.0;
+
+	/** Set by orders and completions, the processor runs the policy decision on the next update */
+	bool bNeedsDecision = false;
+};
+
+/** Resource and deposit target of a worker. Resource data is cached at order time so the processor never reads UObjects per frame */
+USTRUCT()
+struct FGathererTargetFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	TWeakObjectPtr<ARTS_Actor> Resource;
+	TWeakObjectPtr<UGatherableModule> Gatherable;
+
+	EResourceType ResourceType = EResourceType::Wood;
+	int32 ResourceStack = 1;
+	float GatheringTime = 5.f;
+
+	FVector GatherLocation = FVector::ZeroVector;
+	FVector DepositLocation = FVector::ZeroVector;
+};
+
+/** Policy and ownership shared by a group of simulated workers */
+USTRUCT()
+struct FGathererPolicyFragment : public FMassConstSharedFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EGathererMassPolicy Policy = EGathererMassPolicy::Stacks;
+
+	UPROPERTY()
+	int32 StacksStorageAmount = 1;
+
+	UPROPERTY()
+	int32 HarvestPower = 1;
+
+	UPROPERTY()
+	int32 StoragePower = 5;
+
+	UPROPERTY()
+	float MoveSpeed = 300.f;
+
+	UPROPERTY()
+	float AcceptanceRadius = 25.f;
+
+	/** Time spent at the deposit location, UInstantDeposit waits 0.5s */
+	UPROPERTY()
+	float DepositTime = 0.5f;
+
+	/** Distance of the slot ring from the resource */
+	UPROPERTY()
+	float SlotRadius = 120.f;
+
+	/** Data asset a worker is promoted with */
+	UPROPERTY()
+	TWeakObjectPtr<URTS_DataAsset> WorkerDataAsset;
+
+	/** Actor whose player receives deposits, see URTSModuleFunctionLibrary::GetPlayerResources */
+	UPROPERTY()
+	TWeakObjectPtr<ARTS_Actor> PlayerContext;
+};
@@ -0,0 +1,258 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "GathererMassProcessor.h"
+#include "GathererMassFragments.h"
+#include "GatherableModule/GatherableModule.h"
+#include "GatherableModule/HarvestResolver.h"
+#include "RTS_Actor.h"
+#include "RTS_Stats.h"
+#include "MassCommonFragments.h"
+#include "MassExecutionContext.h"
+#include "GathererModule/Economy/TeamResourceLedger.h"
+#include "EconomyCore/GatherPolicy.h"
+
+namespace GathererMass
+{
+	static bool IsResourceAvailable(const FGathererTargetFragment& Target)
+	{
+		const ARTS_Actor* Resource = Target.Resource.Get();
+		return Resource && !Resource->IsInPool() && Target.Gatherable.IsValid();
+	}
+
+	static RTSEconomy::FGatherPolicy ToCorePolicy(const FGathererPolicyFragment& Policy)
+	{
+		RTSEconomy::FGatherPolicy CorePolicy;
+		CorePolicy.Storage = Policy.Policy == EGathererMassPolicy::Stacks ? RTSEconomy::EGatherStorage::Stacks : RTSEconomy::EGatherStorage::Units;
+		CorePolicy.StacksStorageAmount = Policy.StacksStorageAmount;
+		CorePolicy.HarvestPower = Policy.HarvestPower;
+		CorePolicy.StoragePower = Policy.StoragePower;
+		return CorePolicy;
+	}
+
+	/** The method-local counter the policy fills up */
+	static int32& GetStored(FGathererStateFragment& State, const FGathererPolicyFragment& Policy)
+	{
+		return Policy.Policy == EGathererMassPolicy::Stacks ? State.StoredStacks : State.StoredUnits;
+	}
+
+	static RTSEconomy::FGathererState ToCoreState(FGathererStateFragment& State, const FGathererPolicyFragment& Policy)
+	{
+		RTSEconomy::FGathererState CoreState;
+		CoreState.CarriedAmount = State.CurrentResourceAmount;
+		CoreState.CarriedType = static_cast<uint8>(State.CarriedType);
+		CoreState.Stored = GetStored(State, Policy);
+		return CoreState;
+	}
+
+	/** Same rules as UGatherMethod_001::Gather / UGatherMethod_002::Gather, both run EconomyCore's DecideNextStep */
+	static void Decide(FGathererStateFragment& State, const FGathererTargetFragment& Target, const FGathererPolicyFragment& Policy)
+	{
+		State.bNeedsDecision = false;
+		State.ActionStartTime = -1.0;
+
+		if (!IsResourceAvailable(Target))
+		{
+			State.CurrentState = State.CurrentResourceAmount > 0 ? EGathererState::Depositing : EGathererState::Idle;
+			return;
+		}
+
+		RTSEconomy::FGathererState CoreState = ToCoreState(State, Policy);
+		const RTSEconomy::EGatherDecision Decision = RTSEconomy::DecideNextStep(ToCorePolicy(Policy), CoreState, static_cast<uint8>(Target.ResourceType));
+		GetStored(State, Policy) = CoreState.Stored;
+
+		State.CurrentState = Decision == RTSEconomy::EGatherDecision::Deposit ? EGathererState::Depositing : EGathererState::Gathering;
+	}
+
+	/** Moves toward Goal, returns true once within the acceptance radius */
+	static bool MoveTowards(FTransform& Transform, const FVector& Goal, const FGathererPolicyFragment& Policy, float DeltaTime)
+	{
+		const FVector Location = Transform.GetLocation();
+		const FVector ToGoal = FVector(Goal.X - Location.X, Goal.Y - Location.Y, 0.f);
+		const float Distance = ToGoal.Size();
+		if (Distance <= Policy.AcceptanceRadius)
+		{
+			return true;
+		}
+
+		const float Step = FMath::Min(Distance, Policy.MoveSpeed * DeltaTime);
+		Transform.SetLocation(Location + ToGoal / Distance * Step);
+		return false;
+	}
+
+	/** Gatherer waiting for its harvest, fragment memory stays put until Execute returns */
+	struct FPendingHarvest
+	{
+		FGathererStateFragment* State;
+		const FGathererPolicyFragment* Policy;
+	};
+
+	static void CompleteGathering(FGathererStateFragment& State, FGathererTargetFragment& Target, const FGathererPolicyFragment& Policy, TArray<FHarvestRequest>& Requests, TArray<FPendingHarvest>& PendingHarvests)
+	{
+		UGatherableModule* Gatherable = Target.Gatherable.Get();
+		if (!Gatherable || !IsResourceAvailable(Target))
+		{
+			State.bNeedsDecision = true;
+			return;
+		}
+
+		FHarvestRequest& Request = Requests.AddDefaulted_GetRef();
+		Request.Node = Gatherable;
+		Request.Requested = RTSEconomy::GetHarvestRequest(ToCorePolicy(Policy), Target.ResourceStack);
+		Request.ResourceType = Target.ResourceType;
+		PendingHarvests.Add({ &State, &Policy });
+		INC_DWORD_STAT(STAT_RTS_GatherCompletions);
+	}
+
+	static void ApplyHarvest(FGathererStateFragment& State, const FGathererPolicyFragment& Policy, const FHarvestRequest& Request)
+	{
+		if (Request.bHarvested)
+		{
+			RTSEconomy::FGathererState CoreState = ToCoreState(State, Policy);
+			RTSEconomy::ApplyHarvest(ToCorePolicy(Policy), CoreState, Request.Granted, static_cast<uint8>(Request.ResourceType));
+			State.CurrentResourceAmount = CoreState.CarriedAmount;
+			State.CarriedType = Request.ResourceType;
+			GetStored(State, Policy) = CoreState.Stored;
+		}
+		State.bNeedsDecision = true;
+	}
+
+	static void CompleteDepositing(FGathererStateFragment& State, const FGathererPolicyFragment& Policy, UTeamResourceLedger* Ledger)
+	{
+		if (State.CurrentResourceAmount > 0)
+		{
+			if (Ledger)
+			{
+				Ledger->AddDeposit(Policy.PlayerContext.Get(), State.CarriedType, State.CurrentResourceAmount);
+			}
+			INC_DWORD_STAT(STAT_RTS_Deposits);
+		}
+		State.CurrentResourceAmount = 0;
+		State.bNeedsDecision = true;
+	}
+}
+
+UGathererMassProcessor::UGathererMassProcessor()
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+
+	// Completions call into UGatherableModule and the player resources
+	bRequiresGameThreadExecution = true;
+}
+
+void UGathererMassProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FGathererStateFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FGathererTargetFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddConstSharedRequirement<FGathererPolicyFragment>();
+	EntityQuery.RegisterWithProcessor(*this);
+}
+
+void UGathererMassProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	RTS_MODULE_SCOPE(STAT_RTS_GathererMassProcessor);
+
+	const UWorld* World = Context.GetWorld();
+	if (!World)
+	{
+		return;
+	}
+	const double Now = World->GetTimeSeconds();
+	UTeamResourceLedger* Ledger = UTeamResourceLedger::Get(World);
+
+	// Harvests of every chunk are resolved together after the loop, once per node
+	TArray<FHarvestRequest> HarvestRequests;
+	TArray<GathererMass::FPendingHarvest> PendingHarvests;
+
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [Now, Ledger, &HarvestRequests, &PendingHarvests](FMassExecutionContext& ChunkContext)
+	{
+		const int32 NumEntities = ChunkContext.GetNumEntities();
+		const float DeltaTime = ChunkContext.GetDeltaTimeSeconds();
+		const TArrayView<FTransformFragment> Transforms = ChunkContext.GetMutableFragmentView<FTransformFragment>();
+		const TArrayView<FGathererStateFragment> States = ChunkContext.GetMutableFragmentView<FGathererStateFragment>();
+		const TArrayView<FGathererTargetFragment> Targets = ChunkContext.GetMutableFragmentView<FGathererTargetFragment>();
+		const FGathererPolicyFragment& Policy = ChunkContext.GetConstSharedFragment<FGathererPolicyFragment>();
+
+		for (int32 Index = 0; Index < NumEntities; ++Index)
+		{
+			FGathererStateFragment& State = States[Index];
+			FGathererTargetFragment& Target = Targets[Index];
+			FTransform& Transform = Transforms[Index].GetMutableTransform();
+
+			if (State.bNeedsDecision)
+			{
+				GathererMass::Decide(State, Target, Policy);
+			}
+
+			switch (State.CurrentState)
+			{
+			case EGathererState::Gathering:
+				if (!GathererMass::MoveTowards(Transform, Target.GatherLocation, Policy, DeltaTime))
+				{
+					break;
+				}
+				if (State.ActionStartTime < 0.0)
+				{
+					State.ActionStartTime = Now;
+					INC_DWORD_STAT(STAT_RTS_GatherStarts);
+				}
+				else if (Now - State.ActionStartTime >= Target.GatheringTime)
+				{
+					GathererMass::CompleteGathering(State, Target, Policy, HarvestRequests, PendingHarvests);
+				}
+				break;
+
+			case EGathererState::Depositing:
+				if (!GathererMass::MoveTowards(Transform, Target.DepositLocation, Policy, DeltaTime))
+				{
+					break;
+				}
+				if (State.ActionStartTime < 0.0)
+				{
+					State.ActionStartTime = Now;
+				}
+				else if (Now - State.ActionStartTime >= Policy.DepositTime)
+				{
+					GathererMass::CompleteDepositing(State, Policy, Ledger);
+				}
+				break;
+
+			default:
+				break;
+			}
+		}
+	});
+
+	if (HarvestRequests.Num() > 0)
+	{
+		if (UHarvestResolver* Resolver = UHarvestResolver::Get(World))
+		{
+			Resolver->Resolve(HarvestRequests);
+		}
+		else
+		{
+			// No resolver, consume on the spot in completion order like UGatherableModule::RequestHarvest
+			for (FHarvestRequest& Request : HarvestRequests)
+			{
+				UGatherableModule* Gatherable = Request.Node.Get();
+				if (!Gatherable)
+				{
+					continue;
+				}
+
+				TArray<int32> Granted = { Request.Requested };
+				const bool bDepleted = Gatherable->ConsumeHarvests(Granted);
+				Request.Granted = Granted[0];
+				Request.bHarvested = Request.Granted > 0;
+				if (bDepleted)
+				{
+					Gatherable->RecycleOwner();
+				}
+			}
+		}
+		for (int32 Index = 0; Index < HarvestRequests.Num(); ++Index)
+		{
+			GathererMass::ApplyHarvest(*PendingHarvests[Index].State, *PendingHarvests[Index].Policy, HarvestRequests[Index]);
+		}
+	}
+}
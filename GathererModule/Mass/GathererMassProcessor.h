@@ -0,0 +1,28 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "GathererMassProcessor.generated.h"
+
+/**
+ * Runs the gather -> deposit -> gather loop of simulated workers in chunked batches.
+ * Decisions follow UGatherMethod_001::Gather and UGatherMethod_002::Gather. Movement is a straight line toward
+ * the slot or deposit location and timing uses world timestamps, so the per-frame work is plain fragment math.
+ * Harvests and deposits touch UGatherableModule / UPlayerResourcesModule and run on the game thread.
+ */
+UCLASS()
+class DRAKTHYSPROJECT_API UGathererMassProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UGathererMassProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
@@ -0,0 +1,341 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "GathererMassSubsystem.h"
+#include "RTS_Actor.h"
+#include "RTS_ActorPool.h"
+#include "RTS_DataAsset.h"
+#include "GatherableModule/GatherableModule.h"
+#include "GathererModule/GathererModule.h"
+#include "GathererModule/GatherMethod/GatherMethod_001.h"
+#include "GathererModule/GatherMethod/GatherMethod_002.h"
+#include "MassCommonFragments.h"
+#include "MassEntityManager.h"
+#include "MassEntitySubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+UGathererMassSubsystem* UGathererMassSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGathererMassSubsystem>() : nullptr;
+}
+
+void UGathererMassSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Collection.InitializeDependency<UMassEntitySubsystem>();
+	Collection.InitializeDependency<URTS_ModuleScheduler>();
+
+	if (FMassEntityManager* EntityManager = GetEntityManager())
+	{
+		WorkerArchetype = EntityManager->CreateArchetype({
+			FTransformFragment::StaticStruct(),
+			FGathererStateFragment::StaticStruct(),
+			FGathererTargetFragment::StaticStruct()
+		});
+	}
+
+	if (URTS_ModuleScheduler* Scheduler = URTS_ModuleScheduler::Get(this))
+	{
+		Scheduler->ScheduleUObject(PromotionTimer, this, &UGathererMassSubsystem::UpdatePromotion, PromotionCheckInterval, true);
+	}
+}
+
+void UGathererMassSubsystem::Deinitialize()
+{
+	if (URTS_ModuleScheduler* Scheduler = URTS_ModuleScheduler::Get(this))
+	{
+		Scheduler->Cancel(PromotionTimer);
+	}
+
+	SimulatedEntities.Empty();
+	PromotedWorkers.Empty();
+
+	Super::Deinitialize();
+}
+
+FMassEntityManager* UGathererMassSubsystem::GetEntityManager() const
+{
+	UMassEntitySubsystem* EntitySubsystem = GetWorld() ? GetWorld()->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+	return EntitySubsystem ? &EntitySubsystem->GetMutableEntityManager() : nullptr;
+}
+
+TArray<FMassEntityHandle> UGathererMassSubsystem::CreateWorkerEntities(const FGathererPolicyFragment& Policy, int32 Count)
+{
+	TArray<FMassEntityHandle> Entities;
+	FMassEntityManager* EntityManager = GetEntityManager();
+	if (!EntityManager || !WorkerArchetype.IsValid() || Count <= 0)
+	{
+		return Entities;
+	}
+
+	// Workers with equal policy share one fragment instance, and with it their chunks
+	FMassArchetypeSharedFragmentValues SharedValues;
+	SharedValues.AddConstSharedFragment(EntityManager->GetOrCreateConstSharedFragment(Policy));
+	SharedValues.Sort();
+
+	EntityManager->BatchCreateEntities(WorkerArchetype, SharedValues, Count, Entities);
+	SimulatedEntities.Append(Entities);
+	return Entities;
+}
+
+TArray<FMassEntityHandle> UGathererMassSubsystem::SpawnSimulatedWorkers(const FGathererPolicyFragment& Policy, int32 Count, const FVector& Center, float Radius)
+{
+	TArray<FMassEntityHandle> Entities = CreateWorkerEntities(Policy, Count);
+	FMassEntityManager* EntityManager = GetEntityManager();
+	if (!EntityManager)
+	{
+		return Entities;
+	}
+
+	for (int32 Index = 0; Index < Entities.Num(); ++Index)
+	{
+		// Sunflower spiral, even coverage of the disc without randomness
+		const float Distance = Radius * FMath::Sqrt((Index + 0.5f) / Entities.Num());
+		const float Angle = Index * 2.39996323f;
+		EntityManager->GetFragmentDataChecked<FTransformFragment>(Entities[Index]).SetTransform(
+			FTransform(Center + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.f)));
+	}
+	return Entities;
+}
+
+void UGathererMassSubsystem::OrderGather(TConstArrayView<FMassEntityHandle> Entities, ARTS_Actor* Resource, const FVector& DepositLocation)
+{
+	FMassEntityManager* EntityManager = GetEntityManager();
+	UGatherableModule* Gatherable = Resource ? Resource->GetModule<UGatherableModule>() : nullptr;
+	if (!EntityManager || !Gatherable)
+	{
+		return;
+	}
+
+	const FVector ResourceLocation = Resource->GetActorLocation();
+	for (int32 Index = 0; Index < Entities.Num(); ++Index)
+	{
+		const FMassEntityHandle Entity = Entities[Index];
+		if (!EntityManager->IsEntityValid(Entity))
+		{
+			continue;
+		}
+
+		const FGathererPolicyFragment* Policy = EntityManager->GetConstSharedFragmentDataPtr<FGathererPolicyFragment>(Entity);
+		const float SlotRadius = Policy ? Policy->SlotRadius : 120.f;
+		const float Angle = 2.f * PI * Index / Entities.Num();
+
+		FGathererTargetFragment& Target = EntityManager->GetFragmentDataChecked<FGathererTargetFragment>(Entity);
+		Target.Resource = Resource;
+		Target.Gatherable = Gatherable;
+		Target.ResourceType = Gatherable->ResourceType;
+		Target.ResourceStack = Gatherable->ResourceStack;
+		Target.GatheringTime = Gatherable->GatheringTime;
+		Target.GatherLocation = ResourceLocation + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * SlotRadius;
+		Target.DepositLocation = DepositLocation;
+
+		FGathererStateFragment& State = EntityManager->GetFragmentDataChecked<FGathererStateFragment>(Entity);
+		State.SlotIndex = Index;
+		State.bNeedsDecision = true;
+	}
+}
+
+ARTS_Actor* UGathererMassSubsystem::PromoteToActor(FMassEntityHandle Entity)
+{
+	FMassEntityManager* EntityManager = GetEntityManager();
+	URTS_ActorPool* Pool = URTS_ActorPool::Get(this);
+	if (!EntityManager || !Pool || !EntityManager->IsEntityValid(Entity))
+	{
+		return nullptr;
+	}
+
+	const FGathererPolicyFragment* Policy = EntityManager->GetConstSharedFragmentDataPtr<FGathererPolicyFragment>(Entity);
+	if (!Policy || !Policy->WorkerDataAsset.IsValid())
+	{
+		return nullptr;
+	}
+
+	const FTransform Transform = EntityManager->GetFragmentDataChecked<FTransformFragment>(Entity).GetTransform();
+	ARTS_Actor* Worker = Pool->AcquireActor(nullptr, Policy->WorkerDataAsset.Get(), Transform);
+	if (!Worker)
+	{
+		return nullptr;
+	}
+
+	UGathererModule* Gatherer = Worker->GetModule<UGathererModule>();
+	if (!Gatherer)
+	{
+		Pool->ReleaseActor(Worker);
+		return nullptr;
+	}
+	if (!Worker->GetController())
+	{
+		// Spawned pawns are only auto possessed when their class asks for it, re-cache the new controller
+		Worker->SpawnDefaultController();
+		Gatherer->InitializeModule(Worker);
+	}
+
+	const FGathererStateFragment& State = EntityManager->GetFragmentDataChecked<FGathererStateFragment>(Entity);
+	const FGathererTargetFragment& Target = EntityManager->GetFragmentDataChecked<FGathererTargetFragment>(Entity);
+
+	Gatherer->CurrentResourceAmount = State.CurrentResourceAmount;
+	Gatherer->CurrentResourceType = State.CarriedType;
+	if (UGatherMethod_001* Method001 = Cast<UGatherMethod_001>(Gatherer->GatherMethod))
+	{
+		Method001->CurrentGatheredStacks = State.StoredStacks;
+	}
+	else if (UGatherMethod_002* Method002 = Cast<UGatherMethod_002>(Gatherer->GatherMethod))
+	{
+		Method002->CurrentStoredUnits = State.StoredUnits;
+	}
+
+	FPromotedWorker& Promoted = PromotedWorkers.AddDefaulted_GetRef();
+	Promoted.Actor = Worker;
+	Promoted.Policy = *Policy;
+	Promoted.DepositLocation = Target.DepositLocation;
+
+	// Resume where the entity was, the module runs its own policy from here
+	ARTS_Actor* Resource = Target.Resource.Get();
+	if (State.CurrentState == EGathererState::Depositing)
+	{
+		Gatherer->TargetResource = Resource;
+		Gatherer->RequestDeposit();
+	}
+	else if (State.CurrentState == EGathererState::Gathering && Resource && !Resource->IsInPool())
+	{
+		Gatherer->ExecuteGathererModule(Resource);
+	}
+
+	SimulatedEntities.Remove(Entity);
+	EntityManager->DestroyEntity(Entity);
+	return Worker;
+}
+
+FMassEntityHandle UGathererMassSubsystem::DemoteToEntity(ARTS_Actor* Actor)
+{
+	const int32 PromotedIndex = PromotedWorkers.IndexOfByPredicate([Actor](const FPromotedWorker& Worker) { return Worker.Actor.Get() == Actor; });
+	UGathererModule* Gatherer = Actor ? Actor->GetModule<UGathererModule>() : nullptr;
+	FMassEntityManager* EntityManager = GetEntityManager();
+	if (PromotedIndex == INDEX_NONE || !Gatherer || !EntityManager)
+	{
+		return FMassEntityHandle();
+	}
+
+	const FPromotedWorker Promoted = PromotedWorkers[PromotedIndex];
+	PromotedWorkers.RemoveAtSwap(PromotedIndex, 1, EAllowShrinking::No);
+
+	const TArray<FMassEntityHandle> Entities = CreateWorkerEntities(Promoted.Policy, 1);
+	if (Entities.Num() == 0)
+	{
+		return FMassEntityHandle();
+	}
+	const FMassEntityHandle Entity = Entities[0];
+
+	FGathererStateFragment& State = EntityManager->GetFragmentDataChecked<FGathererStateFragment>(Entity);
+	State.CurrentResourceAmount = Gatherer->CurrentResourceAmount;
+	State.CarriedType = Gatherer->CurrentResourceType;
+	State.CurrentState = Gatherer->CurrentState;
+	State.bNeedsDecision = Gatherer->CurrentState != EGathererState::Idle;
+	if (const UGatherMethod_001* Method001 = Cast<UGatherMethod_001>(Gatherer->GatherMethod))
+	{
+		State.StoredStacks = Method001->CurrentGatheredStacks;
+	}
+	else if (const UGatherMethod_002* Method002 = Cast<UGatherMethod_002>(Gatherer->GatherMethod))
+	{
+		State.StoredUnits = Method002->CurrentStoredUnits;
+	}
+
+	ARTS_Actor* Resource = Gatherer->TargetResource.Get();
+	if (UGatherableModule* Gatherable = Resource ? Resource->GetModule<UGatherableModule>() : nullptr)
+	{
+		FGathererTargetFragment& Target = EntityManager->GetFragmentDataChecked<FGathererTargetFragment>(Entity);
+		Target.Resource = Resource;
+		Target.Gatherable = Gatherable;
+		Target.ResourceType = Gatherable->ResourceType;
+		Target.ResourceStack = Gatherable->ResourceStack;
+		Target.GatheringTime = Gatherable->GatheringTime;
+		Target.GatherLocation = Resource->GetActorLocation() + (Actor->GetActorLocation() - Resource->GetActorLocation()).GetSafeNormal2D() * Promoted.Policy.SlotRadius;
+		Target.DepositLocation = Promoted.DepositLocation;
+	}
+
+	EntityManager->GetFragmentDataChecked<FTransformFragment>(Entity).SetTransform(Actor->GetActorTransform());
+
+	// ReleaseActor resets the modules, which stops gathering and frees the slot
+	if (URTS_ActorPool* Pool = URTS_ActorPool::Get(this))
+	{
+		Pool->ReleaseActor(Actor);
+	}
+	else
+	{
+		Actor->Destroy();
+	}
+	return Entity;
+}
+
+void UGathererMassSubsystem::SetPinned(ARTS_Actor* Actor, bool bPinned)
+{
+	for (FPromotedWorker& Worker : PromotedWorkers)
+	{
+		if (Worker.Actor.Get() == Actor)
+		{
+			Worker.bPinned = bPinned;
+			return;
+		}
+	}
+}
+
+bool UGathererMassSubsystem::GetViewLocation(FVector& OutLocation) const
+{
+	const APlayerController* PlayerController = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	if (!PlayerController)
+	{
+		return false;
+	}
+
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(OutLocation, ViewRotation);
+	return true;
+}
+
+void UGathererMassSubsystem::UpdatePromotion()
+{
+	FVector ViewLocation;
+	FMassEntityManager* EntityManager = GetEntityManager();
+	if (!EntityManager || !GetViewLocation(ViewLocation))
+	{
+		return;
+	}
+
+	// Demote first so the pool has actors to hand out to the promotions below
+	const float DemotionRadiusSquared = FMath::Square(DemotionRadius);
+	for (int32 Index = PromotedWorkers.Num() - 1; Index >= 0; --Index)
+	{
+		ARTS_Actor* Actor = PromotedWorkers[Index].Actor.Get();
+		if (!Actor || Actor->IsInPool())
+		{
+			PromotedWorkers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+		if (!PromotedWorkers[Index].bPinned && FVector::DistSquared2D(Actor->GetActorLocation(), ViewLocation) > DemotionRadiusSquared)
+		{
+			DemoteToEntity(Actor);
+		}
+	}
+
+	const float PromotionRadiusSquared = FMath::Square(PromotionRadius);
+	TArray<FMassEntityHandle, TInlineAllocator<32>> ToPromote;
+	for (const FMassEntityHandle Entity : SimulatedEntities)
+	{
+		if (ToPromote.Num() >= MaxPromotionsPerUpdate)
+		{
+			break;
+		}
+		const FTransformFragment* Transform = EntityManager->GetFragmentDataPtr<FTransformFragment>(Entity);
+		if (Transform && FVector::DistSquared2D(Transform->GetTransform().GetLocation(), ViewLocation) <= PromotionRadiusSquared)
+		{
+			ToPromote.Add(Entity);
+		}
+	}
+
+	for (const FMassEntityHandle Entity : ToPromote)
+	{
+		PromoteToActor(Entity);
+	}
+}
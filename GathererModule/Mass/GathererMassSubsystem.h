@@ -0,0 +1,86 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "MassEntityTypes.h"
+#include "MassArchetypeTypes.h"
+#include "RTS_ModuleScheduler.h"
+#include "GathererMassFragments.h"
+#include "GathererMassSubsystem.generated.h"
+
+class ARTS_Actor;
+struct FMassEntityManager;
+
+/**
+ * Optional Mass backend for gatherer workers.
+ * Workers far from the camera live as entities run by UGathererMassProcessor; they are promoted to pooled
+ * ARTS_Actors with a full UGathererModule when they come near the camera or get pinned (e.g. selected),
+ * and demoted back once they leave the demotion radius. Gatherer state and method counters carry over both ways.
+ */
+UCLASS()
+class DRAKTHYSPROJECT_API UGathererMassSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGathererMassSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Creates Count simulated workers spread over a disc, idle until ordered */
+	TArray<FMassEntityHandle> SpawnSimulatedWorkers(const FGathererPolicyFragment& Policy, int32 Count, const FVector& Center, float Radius);
+
+	/** Sends simulated workers to Resource, spreading them over its slot ring. Deposits go to DepositLocation */
+	void OrderGather(TConstArrayView<FMassEntityHandle> Entities, ARTS_Actor* Resource, const FVector& DepositLocation);
+
+	/** Replaces the entity with a pooled ARTS_Actor that continues its work */
+	ARTS_Actor* PromoteToActor(FMassEntityHandle Entity);
+
+	/** Replaces a promoted actor with an entity and hands the actor back to the pool */
+	FMassEntityHandle DemoteToEntity(ARTS_Actor* Actor);
+
+	/** Pinned workers stay actors regardless of camera distance, call this from selection */
+	UFUNCTION(BlueprintCallable, Category = "Gatherer Mass")
+	void SetPinned(ARTS_Actor* Actor, bool bPinned);
+
+	UFUNCTION(BlueprintPure, Category = "Gatherer Mass")
+	int32 GetNumSimulated() const { return SimulatedEntities.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "Gatherer Mass")
+	int32 GetNumPromoted() const { return PromotedWorkers.Num(); }
+
+	/** Simulated workers closer than this to the camera become actors */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Mass")
+	float PromotionRadius = 3000.f;
+
+	/** Promoted workers further than this from the camera go back to Mass, larger than PromotionRadius to avoid flip-flopping */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Mass")
+	float DemotionRadius = 4000.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Mass")
+	float PromotionCheckInterval = 0.25f;
+
+	/** Caps actor spawns per check so a camera jump does not spawn hundreds of actors in one frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Mass")
+	int32 MaxPromotionsPerUpdate = 32;
+
+private:
+	struct FPromotedWorker
+	{
+		TWeakObjectPtr<ARTS_Actor> Actor;
+		FGathererPolicyFragment Policy;
+		FVector DepositLocation = FVector::ZeroVector;
+		bool bPinned = false;
+	};
+
+	FMassEntityManager* GetEntityManager() const;
+	TArray<FMassEntityHandle> CreateWorkerEntities(const FGathererPolicyFragment& Policy, int32 Count);
+	void UpdatePromotion();
+	bool GetViewLocation(FVector& OutLocation) const;
+
+	FMassArchetypeHandle WorkerArchetype;
+	TSet<FMassEntityHandle> SimulatedEntities;
+	TArray<FPromotedWorker> PromotedWorkers;
+	FRTSScheduleHandle PromotionTimer;
+};
@@ -0,0 +1,353 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "GathererMovementQueue.h"
+#include "GathererModule/GathererModule.h"
+#include "GatherableModule/SlotReservationService.h"
+#include "RTS_Stats.h"
+#include "AIController.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld GDumpGathererMovementQueueCommand(
+	TEXT("RTS.Movement.Dump"),
+	TEXT("Logs queue depth, query and latency counters of the gatherer movement queue."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UGathererMovementQueue* Queue = UGathererMovementQueue::Get(World))
+		{
+			Queue->DumpStats();
+		}
+	}));
+
+UGathererMovementQueue* UGathererMovementQueue::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGathererMovementQueue>() : nullptr;
+}
+
+void UGathererMovementQueue::Deinitialize()
+{
+	// In-flight queries still call back into us, an empty InFlight map makes them no-ops
+	Pending.Empty();
+	PendingLookup.Empty();
+	InFlight.Empty();
+	InFlightLookup.Empty();
+	Finished.Empty();
+	LatestSerial.Empty();
+	PendingRequests = 0;
+	PathCache.Reset();
+
+	if (UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSystem->OnNavigationGenerationFinishedDelegate.RemoveAll(this);
+	}
+	bBoundToNavigation = false;
+
+	Super::Deinitialize();
+}
+
+TStatId UGathererMovementQueue::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGathererMovementQueue, STATGROUP_Tickables);
+}
+
+UGathererMovementQueue::FQueryKey UGathererMovementQueue::MakeKey(const FVector& Start, const FVector& Goal) const
+{
+	FQueryKey Key;
+	Key.StartCell = FIntVector(FMath::FloorToInt32(Start.X / StartCellSize), FMath::FloorToInt32(Start.Y / StartCellSize), FMath::FloorToInt32(Start.Z / StartCellSize));
+	Key.GoalCell = FIntVector(FMath::FloorToInt32(Goal.X / GoalCellSize), FMath::FloorToInt32(Goal.Y / GoalCellSize), FMath::FloorToInt32(Goal.Z / GoalCellSize));
+	return Key;
+}
+
+TOptional<FGathererPathKey> UGathererMovementQueue::MakeLegKey(const UGathererModule* Module, const FVector& Start, const FVector& Goal) const
+{
+	const USlotReservationService* SlotService = USlotReservationService::Get(Module);
+	ARTS_Actor* Resource = nullptr;
+	int32 SlotIndex = INDEX_NONE;
+	FVector SlotLocation;
+	if (!SlotService || !SlotService->GetHeldSlot(Module->Owner, Resource, SlotIndex) || !SlotService->GetSlotLocation(Resource, SlotIndex, SlotLocation))
+	{
+		return TOptional<FGathererPathKey>();
+	}
+
+	const float ToleranceSquared = FMath::Square(SlotLegTolerance);
+	const bool bToSlot = FVector::DistSquared2D(Goal, SlotLocation) <= ToleranceSquared;
+	const bool bFromSlot = FVector::DistSquared2D(Start, SlotLocation) <= ToleranceSquared;
+	if (bToSlot == bFromSlot)
+	{
+		// Not a slot leg, or a hop around the slot itself
+		return TOptional<FGathererPathKey>();
+	}
+
+	const FVector OtherEnd = bToSlot ? Start : Goal;
+	FGathererPathKey Key;
+	Key.Resource = Resource;
+	Key.SlotIndex = SlotIndex;
+	Key.OtherEndCell = FIntVector(FMath::FloorToInt32(OtherEnd.X / LegEndCellSize), FMath::FloorToInt32(OtherEnd.Y / LegEndCellSize), FMath::FloorToInt32(OtherEnd.Z / LegEndCellSize));
+	Key.bToSlot = bToSlot;
+	return Key;
+}
+
+void UGathererMovementQueue::BindNavigationEvents()
+{
+	if (bBoundToNavigation)
+	{
+		return;
+	}
+
+	if (UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSystem->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UGathererMovementQueue::HandleNavigationGenerationFinished);
+		bBoundToNavigation = true;
+	}
+}
+
+void UGathererMovementQueue::HandleNavigationGenerationFinished(ANavigationData* NavData)
+{
+	// Tiles were rebuilt somewhere, cached legs may cross them
+	PathCache.BumpNavVersion();
+}
+
+bool UGathererMovementQueue::IsCurrent(const FMoveRequest& Request) const
+{
+	const UGathererModule* Module = Request.Module.Get();
+	const uint32* Serial = Module ? LatestSerial.Find(Module) : nullptr;
+	return Serial && *Serial == Request.Serial;
+}
+
+void UGathererMovementQueue::RequestMove(UGathererModule* Module, const FVector& Goal)
+{
+	const AAIController* Controller = Module ? Module->GetAIController() : nullptr;
+	const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	if (!Pawn)
+	{
+		return;
+	}
+
+	FMoveRequest Request;
+	Request.Module = Module;
+	Request.Goal = Goal;
+	Request.RequestTime = FPlatformTime::Seconds();
+	Request.Serial = NextSerial++;
+	LatestSerial.Add(Module, Request.Serial);
+
+	const FVector Start = Pawn->GetNavAgentLocation();
+	if (bUsePathCache)
+	{
+		BindNavigationEvents();
+		Request.LegKey = MakeLegKey(Module, Start, Goal);
+		if (Request.LegKey.IsSet())
+		{
+			if (FNavPathSharedPtr CachedPath = PathCache.Find(Request.LegKey.GetValue(), GetWorld()->GetTimeSeconds()))
+			{
+				INC_DWORD_STAT(STAT_RTS_PathCacheHits);
+				LatestSerial.Remove(Module);
+				Module->FollowPath(Goal, CachedPath);
+				return;
+			}
+			INC_DWORD_STAT(STAT_RTS_PathCacheMisses);
+		}
+	}
+
+	const FQueryKey Key = MakeKey(Start, Goal);
+
+	// Someone in the same cell already asked for this goal, ride along with their query
+	if (const uint32* QueryId = InFlightLookup.Find(Key))
+	{
+		InFlight[*QueryId].Requests.Add(Request);
+		Stats.DeduplicatedTotal++;
+		return;
+	}
+
+	if (const int32* BatchIndex = PendingLookup.Find(Key))
+	{
+		Pending[*BatchIndex].Requests.Add(Request);
+		Stats.DeduplicatedTotal++;
+	}
+	else
+	{
+		FQueryBatch& Batch = Pending.AddDefaulted_GetRef();
+		Batch.Key = Key;
+		Batch.Requests.Add(Request);
+		PendingLookup.Add(Key, Pending.Num() - 1);
+	}
+	PendingRequests++;
+}
+
+void UGathererMovementQueue::CancelMove(UGathererModule* Module)
+{
+	// Queued and in-flight entries stay where they are and are skipped once they come up
+	LatestSerial.Remove(Module);
+}
+
+void UGathererMovementQueue::Tick(float DeltaTime)
+{
+	RTS_MODULE_SCOPE(STAT_RTS_MovementQueueTick);
+
+	Stats.PathsComputedLastFrame = PathsComputedThisFrame;
+	PathsComputedThisFrame = 0;
+
+	IssueQueries();
+	ApplyFinished();
+
+	Stats.QueueDepth = PendingRequests;
+	Stats.InFlightQueries = InFlight.Num();
+	Stats.CacheHits = PathCache.GetHits();
+	Stats.CacheMisses = PathCache.GetMisses();
+	Stats.CacheHitRate = PathCache.GetHitRate();
+	Stats.CachedPaths = PathCache.Num();
+	SET_DWORD_STAT(STAT_RTS_MovementQueueDepth, PendingRequests);
+	SET_DWORD_STAT(STAT_RTS_PathQueriesInFlight, InFlight.Num());
+}
+
+void UGathererMovementQueue::IssueQueries()
+{
+	if (Pending.Num() == 0)
+	{
+		return;
+	}
+
+	UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	int32 Issued = 0;
+	int32 Consumed = 0;
+	for (; Consumed < Pending.Num() && Issued < MaxQueriesPerFrame; ++Consumed)
+	{
+		FQueryBatch& Batch = Pending[Consumed];
+		PendingRequests -= Batch.Requests.Num();
+
+		// The first request that is still wanted provides the start and the agent
+		const FMoveRequest* Lead = Batch.Requests.FindByPredicate([this](const FMoveRequest& Request) { return IsCurrent(Request); });
+		const AAIController* Controller = Lead ? Lead->Module->GetAIController() : nullptr;
+		const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+		if (!Pawn)
+		{
+			Stats.SupersededTotal += Batch.Requests.Num();
+			continue;
+		}
+
+		const FNavAgentProperties& AgentProperties = Pawn->GetNavAgentPropertiesRef();
+		const FVector Start = Pawn->GetNavAgentLocation();
+		const ANavigationData* NavData = NavSystem ? NavSystem->GetNavDataForProps(AgentProperties, Start) : nullptr;
+
+		uint32 QueryId = INVALID_NAVQUERYID;
+		if (NavData)
+		{
+			FPathFindingQuery Query(Controller, *NavData, Start, Lead->Goal,
+				UNavigationQueryFilter::GetQueryFilter(*NavData, Controller, Controller->GetDefaultNavigationFilterClass()));
+			QueryId = NavSystem->FindPathAsync(AgentProperties, Query, FNavPathQueryDelegate::CreateUObject(this, &UGathererMovementQueue::HandlePathFound));
+		}
+
+		if (QueryId == INVALID_NAVQUERYID)
+		{
+			FFinishedBatch& Failed = Finished.AddDefaulted_GetRef();
+			Failed.Requests = MoveTemp(Batch.Requests);
+			continue;
+		}
+
+		Batch.LeadLegKey = Lead->LegKey;
+		InFlightLookup.Add(Batch.Key, QueryId);
+		InFlight.Add(QueryId, MoveTemp(Batch));
+		Issued++;
+	}
+
+	// Whatever did not fit waits for the next frame, keeping its order
+	Pending.RemoveAt(0, Consumed, EAllowShrinking::No);
+	PendingLookup.Reset();
+	for (int32 BatchIndex = 0; BatchIndex < Pending.Num(); ++BatchIndex)
+	{
+		PendingLookup.Add(Pending[BatchIndex].Key, BatchIndex);
+	}
+}
+
+void UGathererMovementQueue::HandlePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	FQueryBatch Batch;
+	if (!InFlight.RemoveAndCopyValue(QueryId, Batch))
+	{
+		return;
+	}
+
+	const uint32* LookupId = InFlightLookup.Find(Batch.Key);
+	if (LookupId && *LookupId == QueryId)
+	{
+		InFlightLookup.Remove(Batch.Key);
+	}
+
+	INC_DWORD_STAT(STAT_RTS_PathsComputed);
+	PathsComputedThisFrame++;
+	Stats.PathsComputedTotal++;
+
+	FFinishedBatch& Done = Finished.AddDefaulted_GetRef();
+	Done.Requests = MoveTemp(Batch.Requests);
+	Done.Path = Path;
+	Done.bSuccess = Result == ENavigationQueryResult::Success && Path.IsValid() && Path->IsValid();
+
+	// Other requests in the batch only share the start cell, the path starts where the lead stood
+	if (Done.bSuccess && bUsePathCache && Batch.LeadLegKey.IsSet())
+	{
+		const double Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+		PathCache.Add(Batch.LeadLegKey.GetValue(), Path, Now);
+	}
+}
+
+void UGathererMovementQueue::ApplyFinished()
+{
+	if (Finished.Num() == 0)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double Deadline = StartTime + ApplyBudgetMs / 1000.0;
+
+	double LatencySum = 0.0;
+	int32 Applied = 0;
+	int32 Consumed = 0;
+	for (; Consumed < Finished.Num() && (Consumed == 0 || FPlatformTime::Seconds() < Deadline); ++Consumed)
+	{
+		const FFinishedBatch& Batch = Finished[Consumed];
+		if (!Batch.bSuccess)
+		{
+			Stats.FailedTotal++;
+		}
+
+		// Everyone in the batch gets the same result, FollowPath hands each worker its own copy of the path
+		for (const FMoveRequest& Request : Batch.Requests)
+		{
+			if (!IsCurrent(Request))
+			{
+				Stats.SupersededTotal++;
+				continue;
+			}
+
+			UGathererModule* Module = Request.Module.Get();
+			LatestSerial.Remove(Module);
+			Module->FollowPath(Request.Goal, Batch.bSuccess ? Batch.Path : FNavPathSharedPtr());
+
+			LatencySum += FPlatformTime::Seconds() - Request.RequestTime;
+			Applied++;
+		}
+	}
+	Finished.RemoveAt(0, Consumed, EAllowShrinking::No);
+
+	if (Applied > 0)
+	{
+		Stats.AverageLatencyMs = static_cast<float>(LatencySum * 1000.0 / Applied);
+		SET_FLOAT_STAT(STAT_RTS_PathLatencyMs, Stats.AverageLatencyMs);
+	}
+}
+
+void UGathererMovementQueue::DumpStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("UGathererMovementQueue - depth %d, in flight %d, paths last frame %d, avg latency %.2f ms"),
+		Stats.QueueDepth, Stats.InFlightQueries, Stats.PathsComputedLastFrame, Stats.AverageLatencyMs);
+	UE_LOG(LogTemp, Log, TEXT("  computed %lld, deduplicated %lld, superseded %lld, failed %lld"),
+		Stats.PathsComputedTotal, Stats.DeduplicatedTotal, Stats.SupersededTotal, Stats.FailedTotal);
+	UE_LOG(LogTemp, Log, TEXT("  path cache: %d legs, hits %lld, misses %lld, hit rate %.1f%%"),
+		Stats.CachedPaths, Stats.CacheHits, Stats.CacheMisses, Stats.CacheHitRate * 100.f);
+}
@@ -0,0 +1,189 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "UObject/ObjectKey.h"
+#include "GathererPathCache.h"
+#include "GathererMovementQueue.generated.h"
+
+class UGathererModule;
+class ANavigationData;
+
+USTRUCT(BlueprintType)
+struct FGathererMovementQueueStats
+{
+	GENERATED_BODY()
+
+	/** Requests waiting to be issued */
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Movement Queue")
+	int32 QueueDepth = 0;
+
+	/** Path queries running on the navigation worker */
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Movement Queue")
+	int32 InFlightQueries = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Movement Queue")
+	int32 PathsComputedLastFrame = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Movement Queue")
+	int64 PathsComputedTotal = 0;
+
+	/** Requests answered by another worker's query with the same start cell and goal */
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Movement Queue")
+	int64 DeduplicatedTotal = 0;
+
+	/** Requests dropped because the worker was given a newer move or stopped */
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Movement Queue")
+	int64 SupersededTotal = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Movement Queue")
+	int64 FailedTotal = 0;
+
+	/** Request to path applied, averaged over the last frame that applied any */
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Movement Queue")
+	float AverageLatencyMs = 0.f;
+
+	/** Slot <-> deposit legs served from the path cache without a query */
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Movement Queue")
+	int64 CacheHits = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Movement Queue")
+	int64 CacheMisses = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Movement Queue")
+	float CacheHitRate = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Gatherer Movement Queue")
+	int32 CachedPaths = 0;
+};
+
+/**
+ * Batches gatherer move requests and resolves them with asynchronous path finding.
+ * UGathererModule::MoveToLocation enqueues instead of calling AAIController::MoveTo. Each frame the queue groups
+ * the requests by start cell and goal, issues one FindPathAsync per group up to MaxQueriesPerFrame, and hands
+ * finished paths back to the waiting modules within ApplyBudgetMs. A newer request from the same module
+ * supersedes its older one, whether it is still queued or already in flight.
+ * Legs between a worker's held slot and a drop-off are cached per (slot, drop-off, nav version), so the
+ * recurring round trips of a running economy skip path finding altogether.
+ */
+UCLASS()
+class DRAKTHYSPROJECT_API UGathererMovementQueue : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGathererMovementQueue* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Queues a move of Module's pawn to Goal, the module's FollowPath is called once a path exists */
+	void RequestMove(UGathererModule* Module, const FVector& Goal);
+
+	/** Drops any queued or in-flight request of Module */
+	void CancelMove(UGathererModule* Module);
+
+	UFUNCTION(BlueprintPure, Category = "Gatherer Movement Queue")
+	FGathererMovementQueueStats GetStats() const { return Stats; }
+
+	void DumpStats() const;
+
+	/** Path queries issued per frame, the rest wait for the next frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Movement Queue", meta = (ClampMin = "1"))
+	int32 MaxQueriesPerFrame = 32;
+
+	/** Game thread time spent handing finished paths to modules per frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Movement Queue", meta = (ClampMin = "0.1"))
+	float ApplyBudgetMs = 1.f;
+
+	/** Requests whose starts fall in the same cell of this size and share a goal cell share one query */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Movement Queue")
+	float StartCellSize = 150.f;
+
+	/** Goals are compared at this resolution */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Movement Queue")
+	float GoalCellSize = 10.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Movement Queue")
+	bool bUsePathCache = true;
+
+	/** How close a move endpoint has to be to the worker's slot to count as a slot leg */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Movement Queue")
+	float SlotLegTolerance = 50.f;
+
+	/** Resolution of the far end of a cached leg, drop-off approaches within a cell share a path */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gatherer Movement Queue")
+	float LegEndCellSize = 200.f;
+
+private:
+	struct FMoveRequest
+	{
+		TWeakObjectPtr<UGathererModule> Module;
+		FVector Goal = FVector::ZeroVector;
+		double RequestTime = 0.0;
+		uint32 Serial = 0;
+		TOptional<FGathererPathKey> LegKey;
+	};
+
+	struct FQueryKey
+	{
+		FIntVector StartCell;
+		FIntVector GoalCell;
+
+		bool operator==(const FQueryKey& Other) const { return StartCell == Other.StartCell && GoalCell == Other.GoalCell; }
+		friend uint32 GetTypeHash(const FQueryKey& Key) { return HashCombine(GetTypeHash(Key.StartCell), GetTypeHash(Key.GoalCell)); }
+	};
+
+	struct FQueryBatch
+	{
+		FQueryKey Key;
+		TArray<FMoveRequest> Requests;
+
+		/** Leg of the request the query was computed for, the only one the path is cached under */
+		TOptional<FGathererPathKey> LeadLegKey;
+	};
+
+	struct FFinishedBatch
+	{
+		TArray<FMoveRequest> Requests;
+		FNavPathSharedPtr Path;
+		bool bSuccess = false;
+	};
+
+	void IssueQueries();
+	void ApplyFinished();
+	void HandlePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+	bool IsCurrent(const FMoveRequest& Request) const;
+	FQueryKey MakeKey(const FVector& Start, const FVector& Goal) const;
+
+	/** Cache key when the move starts or ends at the worker's held slot */
+	TOptional<FGathererPathKey> MakeLegKey(const UGathererModule* Module, const FVector& Start, const FVector& Goal) const;
+
+	void BindNavigationEvents();
+
+	UFUNCTION()
+	void HandleNavigationGenerationFinished(ANavigationData* NavData);
+
+	/** Requests of this frame grouped by key, in issue order */
+	TArray<FQueryBatch> Pending;
+	TMap<FQueryKey, int32> PendingLookup;
+
+	/** Batches waiting for their async query, new requests with the same key join them */
+	TMap<uint32, FQueryBatch> InFlight;
+	TMap<FQueryKey, uint32> InFlightLookup;
+
+	TArray<FFinishedBatch> Finished;
+	int32 PendingRequests = 0;
+	int32 PathsComputedThisFrame = 0;
+
+	/** Latest request serial per module, anything older is stale */
+	TMap<TObjectKey<UGathererModule>, uint32> LatestSerial;
+	uint32 NextSerial = 1;
+
+	FGathererPathCache PathCache;
+	bool bBoundToNavigation = false;
+
+	FGathererMovementQueueStats Stats;
+};
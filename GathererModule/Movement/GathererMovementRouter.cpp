@@ -0,0 +1,96 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "GathererMovementRouter.h"
+#include "GathererModule/GathererModule.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld GDumpGathererMovementRouterCommand(
+	TEXT("RTS.Movement.DumpRouter"),
+	TEXT("Logs pending moves and dispatch counters of the gatherer movement router."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UGathererMovementRouter* Router = UGathererMovementRouter::Get(World))
+		{
+			Router->DumpStats();
+		}
+	}));
+
+UGathererMovementRouter* UGathererMovementRouter::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGathererMovementRouter>() : nullptr;
+}
+
+void UGathererMovementRouter::Deinitialize()
+{
+	for (const TPair<TObjectKey<UPathFollowingComponent>, TWeakObjectPtr<UPathFollowingComponent>>& Pair : BoundComponents)
+	{
+		if (UPathFollowingComponent* PathComponent = Pair.Value.Get())
+		{
+			PathComponent->OnRequestFinished.RemoveAll(this);
+		}
+	}
+
+	BoundComponents.Empty();
+	ModuleByRequest.Empty();
+	RequestByModule.Empty();
+
+	Super::Deinitialize();
+}
+
+void UGathererMovementRouter::TrackMove(UGathererModule* Module, UPathFollowingComponent* PathComponent, FAIRequestID RequestId)
+{
+	if (!Module || !PathComponent || !RequestId.IsValid())
+	{
+		return;
+	}
+
+	if (!BoundComponents.Contains(PathComponent))
+	{
+		// Pooled workers keep their controller, so this runs once per worker for the whole match
+		PathComponent->OnRequestFinished.AddUObject(this, &UGathererMovementRouter::HandleRequestFinished);
+		BoundComponents.Add(PathComponent, PathComponent);
+	}
+
+	UntrackMove(Module);
+	ModuleByRequest.Add(RequestId.GetID(), Module);
+	RequestByModule.Add(Module, RequestId.GetID());
+}
+
+void UGathererMovementRouter::UntrackMove(const UGathererModule* Module)
+{
+	uint32 RequestId = 0;
+	if (RequestByModule.RemoveAndCopyValue(Module, RequestId))
+	{
+		ModuleByRequest.Remove(RequestId);
+	}
+}
+
+void UGathererMovementRouter::HandleRequestFinished(FAIRequestID RequestId, const FPathFollowingResult& Result)
+{
+	TWeakObjectPtr<UGathererModule> WeakModule;
+	if (!ModuleByRequest.RemoveAndCopyValue(RequestId.GetID(), WeakModule))
+	{
+		// Aborted by a newer move of the same worker, or a move we never tracked
+		Ignored++;
+		return;
+	}
+
+	UGathererModule* Module = WeakModule.Get();
+	if (!Module)
+	{
+		Ignored++;
+		return;
+	}
+
+	RequestByModule.Remove(Module);
+	Dispatched++;
+	Module->HandleMovementCompleted(RequestId, Result);
+}
+
+void UGathererMovementRouter::DumpStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("UGathererMovementRouter - %d pending moves, %d bound components, dispatched %lld, ignored %lld"),
+		ModuleByRequest.Num(), BoundComponents.Num(), Dispatched, Ignored);
+}
@@ -0,0 +1,52 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "AITypes.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "UObject/ObjectKey.h"
+#include "GathererMovementRouter.generated.h"
+
+class UGathererModule;
+
+/**
+ * Routes path following completions to the gatherer module that issued the move.
+ * Every path following component is bound once for its lifetime; moves are tracked by FAIRequestID in a flat
+ * map, so starting or finishing a leg is a map insert or remove instead of a delegate add and RemoveAll.
+ * Request ids are unique across components, completions of untracked or superseded moves are ignored.
+ */
+UCLASS()
+class DRAKTHYSPROJECT_API UGathererMovementRouter : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGathererMovementRouter* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	/** Binds PathComponent if it is new, then routes the completion of RequestId to Module. Replaces Module's previous move */
+	void TrackMove(UGathererModule* Module, UPathFollowingComponent* PathComponent, FAIRequestID RequestId);
+
+	/** Forgets Module's current move, its completion will not be delivered */
+	void UntrackMove(const UGathererModule* Module);
+
+	/** Moves waiting for their completion */
+	UFUNCTION(BlueprintPure, Category = "Gatherer Movement Router")
+	int32 GetPendingMoves() const { return ModuleByRequest.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "Gatherer Movement Router")
+	int32 GetBoundComponents() const { return BoundComponents.Num(); }
+
+	void DumpStats() const;
+
+private:
+	void HandleRequestFinished(FAIRequestID RequestId, const FPathFollowingResult& Result);
+
+	TMap<uint32, TWeakObjectPtr<UGathererModule>> ModuleByRequest;
+	TMap<TObjectKey<UGathererModule>, uint32> RequestByModule;
+	TMap<TObjectKey<UPathFollowingComponent>, TWeakObjectPtr<UPathFollowingComponent>> BoundComponents;
+
+	int64 Dispatched = 0;
+	int64 Ignored = 0;
+};
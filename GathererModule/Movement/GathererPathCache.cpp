@@ -0,0 +1,70 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "GathererPathCache.h"
+#include "NavigationData.h"
+
+FNavPathSharedPtr FGathererPathCache::Find(const FGathererPathKey& Key, double Now)
+{
+	FEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		Misses++;
+		return nullptr;
+	}
+
+	if (Entry->NavVersion != NavVersion || !Entry->Path.IsValid() || !Entry->Path->IsValid() || !Entry->Path->IsUpToDate())
+	{
+		Entries.Remove(Key);
+		Misses++;
+		return nullptr;
+	}
+
+	Entry->LastUsedTime = Now;
+	Hits++;
+	return Entry->Path;
+}
+
+void FGathererPathCache::Add(const FGathererPathKey& Key, FNavPathSharedPtr Path, double Now)
+{
+	if (!Path.IsValid() || !Path->IsValid() || Path->IsPartial())
+	{
+		return;
+	}
+
+	if (!Entries.Contains(Key) && Entries.Num() >= MaxEntries)
+	{
+		EvictOldest();
+	}
+
+	FEntry& Entry = Entries.FindOrAdd(Key);
+	Entry.Path = Path;
+	Entry.NavVersion = NavVersion;
+	Entry.LastUsedTime = Now;
+}
+
+void FGathererPathCache::Reset()
+{
+	Entries.Empty();
+	Hits = 0;
+	Misses = 0;
+}
+
+void FGathererPathCache::EvictOldest()
+{
+	// Linear, only runs once the cache is full and steady-state economies reuse a fixed set of legs
+	const FGathererPathKey* OldestKey = nullptr;
+	double OldestTime = TNumericLimits<double>::Max();
+	for (const TPair<FGathererPathKey, FEntry>& Pair : Entries)
+	{
+		if (Pair.Value.LastUsedTime < OldestTime)
+		{
+			OldestTime = Pair.Value.LastUsedTime;
+			OldestKey = &Pair.Key;
+		}
+	}
+
+	if (OldestKey)
+	{
+		const FGathererPathKey KeyToRemove = *OldestKey;
+		Entries.Remove(KeyToRemove);
+	}
+}
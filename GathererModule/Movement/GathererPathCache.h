@@ -0,0 +1,72 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "UObject/ObjectKey.h"
+
+class ARTS_Actor;
+
+/** One leg of the slot <-> deposit round trip, shared by every worker that uses the same slot */
+struct FGathererPathKey
+{
+	TObjectKey<ARTS_Actor> Resource;
+	int32 SlotIndex = INDEX_NONE;
+
+	/** Quantized far end of the leg, the drop-off point in practice */
+	FIntVector OtherEndCell = FIntVector::ZeroValue;
+
+	/** Leg direction, deposit -> slot when set */
+	bool bToSlot = false;
+
+	bool operator==(const FGathererPathKey& Other) const
+	{
+		return Resource == Other.Resource && SlotIndex == Other.SlotIndex && OtherEndCell == Other.OtherEndCell && bToSlot == Other.bToSlot;
+	}
+
+	friend uint32 GetTypeHash(const FGathererPathKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.Resource), GetTypeHash(Key.SlotIndex)), HashCombine(GetTypeHash(Key.OtherEndCell), GetTypeHash(Key.bToSlot)));
+	}
+};
+
+/**
+ * Finished navigation paths of recurring gatherer legs, owned by UGathererMovementQueue.
+ * Entries are tagged with the nav version they were built against; the queue bumps the version whenever the
+ * navmesh finishes rebuilding tiles, so a path never outlives the mesh it was found on.
+ * Paths the navigation data invalidated itself are dropped on lookup as well.
+ */
+class FGathererPathCache
+{
+public:
+	FNavPathSharedPtr Find(const FGathererPathKey& Key, double Now);
+	void Add(const FGathererPathKey& Key, FNavPathSharedPtr Path, double Now);
+
+	/** Everything cached so far becomes stale */
+	void BumpNavVersion() { NavVersion++; }
+
+	void Reset();
+
+	int32 Num() const { return Entries.Num(); }
+	int64 GetHits() const { return Hits; }
+	int64 GetMisses() const { return Misses; }
+	float GetHitRate() const { return Hits + Misses > 0 ? static_cast<float>(Hits) / (Hits + Misses) : 0.f; }
+
+	/** Oldest unused entries are evicted beyond this */
+	int32 MaxEntries = 4096;
+
+private:
+	struct FEntry
+	{
+		FNavPathSharedPtr Path;
+		uint32 NavVersion = 0;
+		double LastUsedTime = 0.0;
+	};
+
+	void EvictOldest();
+
+	TMap<FGathererPathKey, FEntry> Entries;
+	uint32 NavVersion = 0;
+	int64 Hits = 0;
+	int64 Misses = 0;
+};
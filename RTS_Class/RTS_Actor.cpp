@@ -1,289 +1,494 @@
-#include "RTS_Actor.h"
-#include "RTS_DataAsset.h"
-#include "RTS_Module.h"
-#include "AI/NavigationSystemBase.h"
-#include "WidgetComponent/WidgetsComponent.h"
-#include "Components/SceneComponent.h"
-#include "Components/CapsuleComponent.h"
-#include "Components/ArrowComponent.h"
-#include "GameFramework/CharacterMovementComponent.h"
-#include "NavAreas/NavArea_Obstacle.h"
-
-ARTS_Actor::ARTS_Actor()
-{
-	// Create RTS_Actor SceneComponent
-	RTS_Actor = CreateDefaultSubobject<USceneComponent>(TEXT("RTS_Actor"));
-	RTS_Actor->SetupAttachment(RootComponent);
-
-	// Create RTS_Actor StaticMeshComponent
-	RTS_StaticMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("RTS_StaticMesh"));
-	RTS_StaticMesh->SetupAttachment(RTS_Actor);
-	// Settings for StaticMesh
-	RTS_StaticMesh->PrimaryComponentTick.bCanEverTick = false;
-	RTS_StaticMesh->SetComponentTickEnabled(false);
-	RTS_StaticMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	RTS_StaticMesh->SetGenerateOverlapEvents(false);
-	RTS_StaticMesh->CanCharacterStepUpOn = ECanBeCharacterBase::ECB_No;
-
-	// Create RTS_Actor BillboardComponent
-	RTS_Billboard = CreateDefaultSubobject<UBillboardComponent>(TEXT("RTS_Billboard"));
-	RTS_Billboard->SetupAttachment(RTS_Actor);
-	// Settings for Billboard
-	RTS_Billboard->SetHiddenInGame(false);
-	RTS_Billboard->SetVisibility(true);
-
-	// Create RTS_Navigation Box Collision 
-	RTS_NavigationBox = CreateDefaultSubobject<UBoxComponent>(TEXT("RTS_NavigationBox"));
-	RTS_NavigationBox->SetupAttachment(RTS_Actor);
-	// Settings for Navigation Effect 
-	RTS_NavigationBox->InitBoxExtent(FVector(50.f, 50.f, 50.f));
-	RTS_NavigationBox->ShapeColor = FColor(255, 180, 0);
-	RTS_NavigationBox->SetLineThickness(5.f);
-	RTS_NavigationBox->SetCanEverAffectNavigation(true);
-	RTS_NavigationBox->SetGenerateOverlapEvents(false);
-	RTS_NavigationBox->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-	RTS_NavigationBox->SetCollisionProfileName(TEXT("Navigation"));
-	RTS_NavigationBox->SetHiddenInGame(false);
-	RTS_NavigationBox->SetVisibility(true);
-	RTS_NavigationBox->CanCharacterStepUpOn = ECanBeCharacterBase::ECB_No;
-	RTS_NavigationBox->SetComponentTickEnabled(false);
-	RTS_NavigationBox->bDynamicObstacle = true;
-	RTS_NavigationBox->SetAreaClassOverride(UNavArea_Obstacle::StaticClass());
-
-	// Create RTS_Placement Box Collision for building placement
-	RTS_PlacementBox = CreateDefaultSubobject<UBoxComponent>(TEXT("RTS_PlacementBox"));
-	RTS_PlacementBox->SetupAttachment(RTS_Actor);
-	// Settings for Placement Effect 
-	RTS_PlacementBox->InitBoxExtent(FVector(100.f, 100.f, 50.f));
-	RTS_PlacementBox->ShapeColor = FColor(0, 255, 0);
-	RTS_PlacementBox->SetLineThickness(3.f);
-	RTS_PlacementBox->SetCanEverAffectNavigation(false);
-	RTS_PlacementBox->SetGenerateOverlapEvents(true);
-	RTS_PlacementBox->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-	RTS_PlacementBox->SetCollisionProfileName(TEXT("Placement"));
-	RTS_PlacementBox->SetHiddenInGame(false);
-	RTS_PlacementBox->SetVisibility(true);
-	RTS_PlacementBox->CanCharacterStepUpOn = ECanBeCharacterBase::ECB_No;
-	RTS_PlacementBox->SetComponentTickEnabled(false);
-
-	// Capsule Component Visuals
-	GetCapsuleComponent()->SetLineThickness(2.f);
-}
-
-void ARTS_Actor::Initialize_Implementation()
-{
-	// 1. Initialize modules from data asset (if available)
-	if (ActorDataAsset)
-	{
-		InitializeModules();
-	}
-
-	// 2. Setup widget components for UI feedback
-	InitializeSelectedWidget();
-	
-	// 3. Setup actor components based on movement capability
-	//    - Characters (with Movement module): Keep character components, remove static components
-	//    - Buildings (no Movement module): Keep static components, remove character components
-	SetupActorComponents();
-}
-
-void ARTS_Actor::InitializeModules()
-{
-	// Process each module from the data asset
-	for (const TPair<FGameplayTag, TObjectPtr<URTS_Module>>& Pair : ActorDataAsset->Modules)
-	{
-		const FGameplayTag& Tag = Pair.Key;
-		const TObjectPtr<URTS_Module>& Module = Pair.Value;
-
-		// Skip invalid modules
-		if (!Module)
-		{
-			continue;
-		}
-
-		// Create a copy of the module for this actor
-		URTS_Module* DuplicatedModule = DuplicateObject<URTS_Module>(Module, this);
-		if (!DuplicatedModule)
-		{
-			continue;
-		}
-
-		// Initialize the module with this actor as owner
-		DuplicatedModule->InitializeModule(this);
-
-		// Add the module to the appropriate category in this actor
-		Modules.Add(Tag, DuplicatedModule);
-	}
-}
-
-void ARTS_Actor::InitializeSelectedWidget()
-{
-	// Setup widget components for UI feedback
-	if (TObjectPtr<UWidgetsComponent> WidgetComponent = FindComponentByClass<UWidgetsComponent>())
-	{
-		// Get the widget from the component, but only if it's valid
-		UUserWidget* WidgetFromComponent = WidgetComponent->GetSelectedWidget();
-		if (WidgetFromComponent)
-		{
-			SelectedWidget = WidgetFromComponent;
-			UE_LOG(LogTemp, Log, TEXT("SelectedWidget initialized from WidgetsComponent for %s"), *GetName());
-		}
-		else
-		{
-			UE_LOG(LogTemp, Warning, TEXT("WidgetsComponent found but no SelectedWidget available for %s"), *GetName());
-		}
-	}
-	else
-	{
-		UE_LOG(LogTemp, Log, TEXT("No WidgetsComponent found for %s - SelectedWidget will remain null"), *GetName());
-	}
-}
-
-void ARTS_Actor::SetupActorComponents()
-{
-	// Determine if this actor should be a character (movable) or static building
-	bool bShouldBeCharacter = false;
-	
-	if (ActorDataAsset)
-	{
-		// Check if actor has movement module - if yes, it should be a character
-		bShouldBeCharacter = ActorDataAsset->Modules.Contains(FGameplayTag::RequestGameplayTag("Module.Movement"));
-	}
-	
-	// Setup components based on actor type
-	if (bShouldBeCharacter)
-	{
-		SetupAsCharacter();
-	}
-	else
-	{
-		SetupAsStaticBuilding();
-	}
-}
-
-void ARTS_Actor::SetupAsCharacter()
-{
-	// Character actors need movement components, remove static building components
-	
-	// Remove navigation box for movable actors (they don't need static navigation)
-	if (RTS_NavigationBox)
-	{
-		RTS_NavigationBox->DestroyComponent();
-	}
-
-	if (RTS_PlacementBox)
-	{
-		RTS_PlacementBox->DestroyComponent();
-	}
-	
-	// Initialize character-specific components
-	InitializeMesh();
-}
-
-void ARTS_Actor::SetupAsStaticBuilding()
-{
-	// Static buildings need static components, remove character components
-	
-	// Remove character movement components
-	if (GetCharacterMovement())
-	{
-		GetCharacterMovement()->DestroyComponent();
-	}
-
-	// Remove character mesh
-	if (GetMesh())
-	{
-		GetMesh()->DestroyComponent();
-	}
-	
-	// Remove arrow component if present
-	if (UArrowComponent* Arrow = FindComponentByClass<UArrowComponent>())
-	{
-		Arrow->DestroyComponent();
-	}
-	
-	// Initialize static building components
-	InitializeMesh();
-	InitializeNavigationBox();
-	InitializePlacementBox();
-}
-
-// If the RTS Actor is not Character then Initialize Mesh and Navigation Box
-void ARTS_Actor::InitializeMesh()
-{
-	if (!ActorDataAsset)
-		return;
-
-	// Might need to switch on Skeletal Mesh
-	if (ActorDataAsset->MeshData.StaticMesh && RTS_StaticMesh)
-	{
-		RTS_StaticMesh->SetStaticMesh(const_cast<UStaticMesh*>(ActorDataAsset->MeshData.StaticMesh));
-		RTS_StaticMesh->SetMaterial(0, ActorDataAsset->MeshData.Material);
-	}
-}
-
-void ARTS_Actor::InitializeNavigationBox()
-{
-	if (!ActorDataAsset || !RTS_NavigationBox)
-		return;
-
-	// Navigation Box Sizing
-	FVector NavigationExtent = ActorDataAsset->MeshData.NavigationExtent;
-	RTS_NavigationBox->SetBoxExtent(NavigationExtent);
-	RTS_NavigationBox->UpdateBounds();
-	FNavigationSystem::UpdateComponentData(*RTS_NavigationBox);
-}
-
-void ARTS_Actor::InitializePlacementBox()
-{
-	if (!ActorDataAsset || !RTS_PlacementBox)
-		return;
-
-	// Calculate placement box extent based on tile count
-	// GetDistanceFromTileCount(TileCount) / 2 + 100,100,0
-	float TileSize = 100.0f;
-	FVector2D TileCount = ActorDataAsset->MeshData.TileCount;
-	
-	// Calculate base size from tile count
-	float BaseX = TileCount.X * TileSize;
-	float BaseY = TileCount.Y * TileSize;
-	
-	// Add 100 units to each side (1 tiledfdfd than building)
-	float PlacementX = (BaseX / 2.0f) + 80.0f;	
-	float PlacementY = (BaseY / 2.0f) + 80.0f;
-	
-	FVector PlacementExtent = FVector(PlacementX, PlacementY, 25.0f);
-	RTS_PlacementBox->SetBoxExtent(PlacementExtent);
-	RTS_PlacementBox->UpdateBounds();
-	RTS_PlacementBox->ComponentTags.AddUnique(FName("PlacementBox"));
-}
-
-UInputMappingContext* ARTS_Actor::GetSelectedContext() const
-{
-	return ActorDataAsset ? ActorDataAsset->SelectedContext : nullptr;
-}
-
-UInputMappingContext* ARTS_Actor::GetHoveredContext() const
-{
-	return ActorDataAsset ? ActorDataAsset->HoveredContext : nullptr;
-}
-
-FGameplayTag ARTS_Actor::GetRTSGameplayTag() const
-{
-	return ActorDataAsset->RTS_GameplayTag;
-}
-
-FName ARTS_Actor::GetRTS_ActorTypeTag() const
-{
-	return ActorDataAsset->RTS_ActorTypeTag;
-}
-
-FGameplayTagContainer ARTS_Actor::GetRTS_Tags() const
-{
-	return ActorDataAsset->RTS_Tags;
-}
-
-UUserWidget* ARTS_Actor::GetSelectedWidget() const
-{
-	return SelectedWidget;
-}
+#include "RTS_Actor.h"
+#include "RTS_DataAsset.h"
+#include "RTS_Module.h"
+#include "RTS_Stats.h"
+#include "RTS_StaticBuilding.h"
+#include "RTS_UnitActor.h"
+#include "AI/NavigationSystemBase.h"
+#include "RTS_SelectionWidgetPool.h"
+#include "WidgetComponent/WidgetsComponent.h"
+#include "Components/SceneComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/ArrowComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Controller.h"
+#include "NavAreas/NavArea_Obstacle.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/UObjectHash.h"
+
+namespace RTSActorFootprint
+{
+	// Accumulated cost of InitializeModules, reported by RTS.Modules.ReportFootprint
+	static double InitializeModulesSeconds = 0.0;
+	static int32 InitializeModulesCount = 0;
+}
+
+static FAutoConsoleCommandWithWorld GReportRTSModuleFootprintCommand(
+	TEXT("RTS.Modules.ReportFootprint"),
+	TEXT("Logs average module bytes per RTS actor and average InitializeModules time."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (!World) return;
+
+		int32 ActorCount = 0;
+		uint64 ModuleBytes = 0;
+		for (TActorIterator<ARTS_Actor> It(World); It; ++It)
+		{
+			++ActorCount;
+			for (const TPair<FGameplayTag, TObjectPtr<URTS_Module>>& Pair : It->Modules)
+			{
+				if (!Pair.Value) continue;
+
+				// Module plus its instanced subobjects (gather/deposit methods)
+				TArray<UObject*> ModuleObjects = { Pair.Value };
+				GetObjectsWithOuter(Pair.Value, ModuleObjects, true);
+				for (UObject* Object : ModuleObjects)
+				{
+					FArchiveCountMem CountMem(Object);
+					ModuleBytes += CountMem.GetMax();
+				}
+			}
+		}
+
+		const int32 InitCount = RTSActorFootprint::InitializeModulesCount;
+		UE_LOG(LogTemp, Log, TEXT("RTS.Modules.ReportFootprint - %d actors, %.1f module bytes per actor, %.2f us per InitializeModules (%d samples)"),
+			ActorCount,
+			ActorCount > 0 ? static_cast<double>(ModuleBytes) / ActorCount : 0.0,
+			InitCount > 0 ? RTSActorFootprint::InitializeModulesSeconds * 1e6 / InitCount : 0.0,
+			InitCount);
+	}));
+
+const FName ARTS_Actor::NavigationBoxName(TEXT("RTS_NavigationBox"));
+const FName ARTS_Actor::PlacementBoxName(TEXT("RTS_PlacementBox"));
+
+ARTS_Actor::ARTS_Actor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// Create RTS_Actor SceneComponent
+	RTS_Actor = CreateDefaultSubobject<USceneComponent>(TEXT("RTS_Actor"));
+	RTS_Actor->SetupAttachment(RootComponent);
+
+	// Create RTS_Actor StaticMeshComponent
+	RTS_StaticMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("RTS_StaticMesh"));
+	RTS_StaticMesh->SetupAttachment(RTS_Actor);
+	// Settings for StaticMesh
+	RTS_StaticMesh->PrimaryComponentTick.bCanEverTick = false;
+	RTS_StaticMesh->SetComponentTickEnabled(false);
+	RTS_StaticMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	RTS_StaticMesh->SetGenerateOverlapEvents(false);
+	RTS_StaticMesh->CanCharacterStepUpOn = ECanBeCharacterBase::ECB_No;
+
+	// Create RTS_Actor BillboardComponent
+	RTS_Billboard = CreateDefaultSubobject<UBillboardComponent>(TEXT("RTS_Billboard"));
+	RTS_Billboard->SetupAttachment(RTS_Actor);
+	// Settings for Billboard
+	RTS_Billboard->SetHiddenInGame(false);
+	RTS_Billboard->SetVisibility(true);
+
+	// Create RTS_Navigation Box Collision 
+	RTS_NavigationBox = CreateOptionalDefaultSubobject<UBoxComponent>(NavigationBoxName);
+	if (RTS_NavigationBox)
+	{
+		RTS_NavigationBox->SetupAttachment(RTS_Actor);
+		// Settings for Navigation Effect 
+		RTS_NavigationBox->InitBoxExtent(FVector(50.f, 50.f, 50.f));
+		RTS_NavigationBox->ShapeColor = FColor(255, 180, 0);
+		RTS_NavigationBox->SetLineThickness(5.f);
+		RTS_NavigationBox->SetCanEverAffectNavigation(true);
+		RTS_NavigationBox->SetGenerateOverlapEvents(false);
+		RTS_NavigationBox->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		RTS_NavigationBox->SetCollisionProfileName(TEXT("Navigation"));
+		RTS_NavigationBox->SetHiddenInGame(false);
+		RTS_NavigationBox->SetVisibility(true);
+		RTS_NavigationBox->CanCharacterStepUpOn = ECanBeCharacterBase::ECB_No;
+		RTS_NavigationBox->SetComponentTickEnabled(false);
+		RTS_NavigationBox->bDynamicObstacle = true;
+		RTS_NavigationBox->SetAreaClassOverride(UNavArea_Obstacle::StaticClass());
+	}
+
+	// Create RTS_Placement Box Collision for building placement
+	RTS_PlacementBox = CreateOptionalDefaultSubobject<UBoxComponent>(PlacementBoxName);
+	if (RTS_PlacementBox)
+	{
+		RTS_PlacementBox->SetupAttachment(RTS_Actor);
+		// Settings for Placement Effect 
+		RTS_PlacementBox->InitBoxExtent(FVector(100.f, 100.f, 50.f));
+		RTS_PlacementBox->ShapeColor = FColor(0, 255, 0);
+		RTS_PlacementBox->SetLineThickness(3.f);
+		RTS_PlacementBox->SetCanEverAffectNavigation(false);
+		RTS_PlacementBox->SetGenerateOverlapEvents(true);
+		RTS_PlacementBox->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		RTS_PlacementBox->SetCollisionProfileName(TEXT("Placement"));
+		RTS_PlacementBox->SetHiddenInGame(false);
+		RTS_PlacementBox->SetVisibility(true);
+		RTS_PlacementBox->CanCharacterStepUpOn = ECanBeCharacterBase::ECB_No;
+		RTS_PlacementBox->SetComponentTickEnabled(false);
+	}
+
+	// Capsule Component Visuals
+	GetCapsuleComponent()->SetLineThickness(2.f);
+}
+
+TSubclassOf<ARTS_Actor> ARTS_Actor::GetSpawnClassFor(const URTS_DataAsset* DataAsset)
+{
+	if (!DataAsset)
+	{
+		return ARTS_Actor::StaticClass();
+	}
+
+	if (DataAsset->ActorClass)
+	{
+		return DataAsset->ActorClass;
+	}
+
+	return DataAsset->HasMovementModule() ? TSubclassOf<ARTS_Actor>(ARTS_UnitActor::StaticClass()) : TSubclassOf<ARTS_Actor>(ARTS_StaticBuilding::StaticClass());
+}
+
+void ARTS_Actor::Initialize_Implementation()
+{
+	RTS_MODULE_SCOPE(STAT_RTS_ActorInitialize);
+
+	// 1. Initialize modules from data asset (if available)
+	if (ActorDataAsset)
+	{
+		InitializeModules();
+	}
+
+	// 2. Setup widget components for UI feedback, actors without one get theirs from URTS_SelectionWidgetPool on demand
+	InitializeSelectedWidget();
+
+	// 3. Setup actor components based on movement capability
+	//    - Characters (with Movement module): Keep character components, remove static components
+	//    - Buildings (no Movement module): Keep static components, remove character components
+	SetupActorComponents();
+}
+
+void ARTS_Actor::InitializeModules()
+{
+	RTS_MODULE_SCOPE(STAT_RTS_InitializeModules);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Process each module from the data asset
+	for (const TPair<FGameplayTag, TObjectPtr<URTS_Module>>& Pair : ActorDataAsset->Modules)
+	{
+		const FGameplayTag& Tag = Pair.Key;
+		const TObjectPtr<URTS_Module>& Module = Pair.Value;
+
+		// Skip invalid modules
+		if (!Module)
+		{
+			continue;
+		}
+
+		// Create the instance for this actor. Modules that support it start from the class defaults and copy only their
+		// per-instance properties from the data asset module, the heavy config is read through the archetype.
+		// Everything else is duplicated
+		URTS_Module* DuplicatedModule = nullptr;
+		if (Module->SupportsSharedArchetype())
+		{
+			DuplicatedModule = NewObject<URTS_Module>(this, Module->GetClass());
+			DuplicatedModule->InitializeFromArchetype(Module);
+		}
+		else
+		{
+			DuplicatedModule = DuplicateObject<URTS_Module>(Module, this);
+			if (DuplicatedModule)
+			{
+				DuplicatedModule->Archetype = Module;
+			}
+		}
+
+		if (!DuplicatedModule)
+		{
+			continue;
+		}
+
+		// Initialize the module with this actor as owner
+		DuplicatedModule->InitializeModule(this);
+		INC_DWORD_STAT(STAT_RTS_ModulesInitialized);
+
+		// Add the module to the appropriate category in this actor
+		AddModule(Tag, DuplicatedModule);
+	}
+
+	RTSActorFootprint::InitializeModulesSeconds += FPlatformTime::Seconds() - StartTime;
+	RTSActorFootprint::InitializeModulesCount++;
+}
+
+void ARTS_Actor::AddModule(const FGameplayTag& Tag, URTS_Module* Module)
+{
+	if (!Module)
+	{
+		return;
+	}
+
+	Modules.Add(Tag, Module);
+	RegisterModuleSlots(Module);
+}
+
+void ARTS_Actor::RebuildModuleSlots()
+{
+	ModulePresenceMask = 0;
+	ModuleSlots.Reset();
+	for (const TPair<FGameplayTag, TObjectPtr<URTS_Module>>& Pair : Modules)
+	{
+		RegisterModuleSlots(Pair.Value);
+	}
+}
+
+void ARTS_Actor::RegisterModuleSlots(URTS_Module* Module)
+{
+	if (!Module)
+	{
+		return;
+	}
+
+	// Walk up to URTS_Module so GetModule<UGatherableModule>() also finds Blueprint subclasses, which have no index
+	for (const UClass* Class = Module->GetClass(); Class && Class != URTS_Module::StaticClass(); Class = Class->GetSuperClass())
+	{
+		const int32 TypeId = FRTSModuleTypeRegistry::GetTypeId(Class);
+		if (TypeId == INDEX_NONE || (ModulePresenceMask & (1ull << TypeId)))
+		{
+			continue;
+		}
+
+		ModuleSlots.Insert(Module, FMath::CountBits(ModulePresenceMask & ((1ull << TypeId) - 1)));
+		ModulePresenceMask |= (1ull << TypeId);
+	}
+}
+
+void ARTS_Actor::InitializeSelectedWidget()
+{
+	// Setup widget components for UI feedback
+	if (TObjectPtr<UWidgetsComponent> WidgetComponent = FindComponentByClass<UWidgetsComponent>())
+	{
+		// Get the widget from the component, but only if it's valid
+		UUserWidget* WidgetFromComponent = WidgetComponent->GetSelectedWidget();
+		if (WidgetFromComponent)
+		{
+			SelectedWidget = WidgetFromComponent;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("WidgetsComponent found but no SelectedWidget available for %s"), *GetName());
+		}
+	}
+}
+
+void ARTS_Actor::SetupActorComponents()
+{
+	// Determine if this actor should be a character (movable) or static building
+	// Check if actor has movement module - if yes, it should be a character
+	const bool bShouldBeCharacter = ActorDataAsset && ActorDataAsset->HasMovementModule();
+	
+	// Setup components based on actor type
+	if (bShouldBeCharacter)
+	{
+		SetupAsCharacter();
+	}
+	else
+	{
+		SetupAsStaticBuilding();
+	}
+}
+
+void ARTS_Actor::SetupAsCharacter()
+{
+	// Character actors need movement components, remove static building components
+	
+	// Remove navigation box for movable actors (they don't need static navigation)
+	if (RTS_NavigationBox)
+	{
+		RTS_NavigationBox->DestroyComponent();
+	}
+
+	if (RTS_PlacementBox)
+	{
+		RTS_PlacementBox->DestroyComponent();
+	}
+	
+	// Initialize character-specific components
+	InitializeMesh();
+}
+
+void ARTS_Actor::SetupAsStaticBuilding()
+{
+	// Static buildings need static components, remove character components
+	
+	// Remove character movement components
+	// ARTS_StaticBuilding never registers these, so this only does work for plain ARTS_Actor buildings
+	if (GetCharacterMovement())
+	{
+		GetCharacterMovement()->DestroyComponent();
+	}
+
+	// Remove character mesh
+	if (GetMesh())
+	{
+		GetMesh()->DestroyComponent();
+	}
+	
+	// Remove arrow component if present
+	if (UArrowComponent* Arrow = FindComponentByClass<UArrowComponent>())
+	{
+		Arrow->DestroyComponent();
+	}
+	
+	// Initialize static building components
+	InitializeMesh();
+	InitializeNavigationBox();
+	InitializePlacementBox();
+}
+
+// If the RTS Actor is not Character then Initialize Mesh and Navigation Box
+void ARTS_Actor::InitializeMesh()
+{
+	if (!ActorDataAsset)
+		return;
+
+	// Might need to switch on Skeletal Mesh
+	if (ActorDataAsset->MeshData.StaticMesh && RTS_StaticMesh)
+	{
+		RTS_StaticMesh->SetStaticMesh(const_cast<UStaticMesh*>(ActorDataAsset->MeshData.StaticMesh));
+		RTS_StaticMesh->SetMaterial(0, ActorDataAsset->MeshData.Material);
+	}
+}
+
+void ARTS_Actor::InitializeNavigationBox()
+{
+	if (!ActorDataAsset || !RTS_NavigationBox)
+		return;
+
+	// Navigation Box Sizing
+	FVector NavigationExtent = ActorDataAsset->MeshData.NavigationExtent;
+	RTS_NavigationBox->SetBoxExtent(NavigationExtent);
+	RTS_NavigationBox->UpdateBounds();
+	FNavigationSystem::UpdateComponentData(*RTS_NavigationBox);
+}
+
+void ARTS_Actor::InitializePlacementBox()
+{
+	if (!ActorDataAsset || !RTS_PlacementBox)
+		return;
+
+	// Calculate placement box extent based on tile count
+	// GetDistanceFromTileCount(TileCount) / 2 + 100,100,0
+	float TileSize = 100.0f;
+	FVector2D TileCount = ActorDataAsset->MeshData.TileCount;
+	
+	// Calculate base size from tile count
+	float BaseX = TileCount.X * TileSize;
+	float BaseY = TileCount.Y * TileSize;
+	
+	// Add 100 units to each side (1 tiledfdfd than building)
+	float PlacementX = (BaseX / 2.0f) + 80.0f;	
+	float PlacementY = (BaseY / 2.0f) + 80.0f;
+	
+	FVector PlacementExtent = FVector(PlacementX, PlacementY, 25.0f);
+	RTS_PlacementBox->SetBoxExtent(PlacementExtent);
+	RTS_PlacementBox->UpdateBounds();
+	RTS_PlacementBox->ComponentTags.AddUnique(FName("PlacementBox"));
+}
+
+UInputMappingContext* ARTS_Actor::GetSelectedContext() const
+{
+	return ActorDataAsset ? ActorDataAsset->SelectedContext : nullptr;
+}
+
+UInputMappingContext* ARTS_Actor::GetHoveredContext() const
+{
+	return ActorDataAsset ? ActorDataAsset->HoveredContext : nullptr;
+}
+
+FGameplayTag ARTS_Actor::GetRTSGameplayTag() const
+{
+	return ActorDataAsset->RTS_GameplayTag;
+}
+
+FName ARTS_Actor::GetRTS_ActorTypeTag() const
+{
+	return ActorDataAsset->RTS_ActorTypeTag;
+}
+
+FGameplayTagContainer ARTS_Actor::GetRTS_Tags() const
+{
+	return ActorDataAsset->RTS_Tags;
+}
+
+UUserWidget* ARTS_Actor::GetSelectedWidget() const
+{
+	return SelectedWidget;
+}
+
+void ARTS_Actor::ResetModules()
+{
+	for (const TPair<FGameplayTag, TObjectPtr<URTS_Module>>& Pair : Modules)
+	{
+		if (Pair.Value)
+		{
+			Pair.Value->ResetModule();
+		}
+	}
+}
+
+void ARTS_Actor::DeactivateForPool()
+{
+	bInPool = true;
+	bSelected = false;
+
+	// Stop whatever the modules were doing (timers, slots, production) before parking
+	ResetModules();
+
+	if (URTS_SelectionWidgetPool* WidgetPool = URTS_SelectionWidgetPool::Get(this))
+	{
+		WidgetPool->ReleaseWidget(this);
+	}
+
+	if (AController* OwnerController = GetController())
+	{
+		OwnerController->StopMovement();
+	}
+	if (UCharacterMovementComponent* Movement = GetCharacterMovement())
+	{
+		Movement->StopMovementImmediately();
+		Movement->Deactivate();
+	}
+
+	// Parked buildings and resources must not keep carving the navmesh
+	if (IsValid(RTS_NavigationBox))
+	{
+		RTS_NavigationBox->SetCanEverAffectNavigation(false);
+	}
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+}
+
+void ARTS_Actor::ActivateFromPool(const FTransform& Transform)
+{
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	if (IsValid(RTS_NavigationBox))
+	{
+		RTS_NavigationBox->SetCanEverAffectNavigation(true);
+	}
+	UCharacterMovementComponent* Movement = GetCharacterMovement();
+	if (IsValid(Movement) && Movement->IsRegistered())
+	{
+		Movement->Activate(true);
+	}
+
+	// Cleared first so modules see an active actor while resetting (e.g. to re-register in world indices)
+	bInPool = false;
+	ResetModules();
+
+	OnActivatedFromPool();
+}
@@ -1,99 +1,172 @@
-// Copyright AmberleafCotton 2025. All Rights Reserved.
-#pragma once
-
-#include "GameFramework/Character.h"
-#include "RTS_ActorInterface.h"
-#include "GameplayTagContainer.h"
-#include "Components/BoxComponent.h"
-#include "Components/BillboardComponent.h"
-
-#include "RTS_Actor.generated.h"
-
-class UInputMappingContext;
-class URTS_DataAsset;
-class URTS_Module;
-
-UCLASS()
-class DRAKTHYSPROJECT_API ARTS_Actor : public ACharacter, public IRTS_ActorInterface
-{
-	GENERATED_BODY()
-
-public:
-	ARTS_Actor();
-	
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "RTS Actor")
-	void Initialize();
-	virtual void Initialize_Implementation();
-
-	UFUNCTION(Category = "RTS Actor")
-	void InitializeModules();
-
-	// Component setup functions
-	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
-	void InitializeSelectedWidget();
-	
-	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
-	void SetupActorComponents();
-	
-	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
-	void SetupAsCharacter();
-	
-	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
-	void SetupAsStaticBuilding();
-
-	// Initialize Mesh, Navigation Box, 
-	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
-	void InitializeMesh();
-	
-	// Initialize Navigation Box separately
-	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
-	void InitializeNavigationBox();
-	
-	// Initialize Placement Box for building placement
-	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
-	void InitializePlacementBox();
-	
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "RTS Actor")
-	TObjectPtr<USceneComponent> RTS_Actor = nullptr;
-	
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "RTS Actor")
-	TObjectPtr<UStaticMeshComponent> RTS_StaticMesh = nullptr;
-	
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "RTS Actor")
-	TObjectPtr<UBillboardComponent> RTS_Billboard = nullptr;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "RTS Actor")
-	TObjectPtr<UBoxComponent> RTS_NavigationBox = nullptr;
-	
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "RTS Actor")
-	TObjectPtr<UBoxComponent> RTS_PlacementBox = nullptr;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTS Actor", meta = (ExposeOnSpawn = true))
-	TObjectPtr<URTS_DataAsset> ActorDataAsset = nullptr;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite,  Category = "RTS Actor")
-	TMap<FGameplayTag, TObjectPtr<URTS_Module>> Modules;
-
-	// Access to RTS_DataAsset variables
-	UFUNCTION(BlueprintCallable, Category = "RTS Input")
-	UInputMappingContext* GetSelectedContext() const;
-
-	UFUNCTION(BlueprintCallable, Category = "RTS Input")
-	UInputMappingContext* GetHoveredContext() const;
-
-	UFUNCTION(BlueprintPure, Category = "RTS Actor")
-	FGameplayTag GetRTSGameplayTag() const;
-	
-	UFUNCTION(BlueprintPure, Category = "RTS Actor")
-	FName GetRTS_ActorTypeTag() const;
-
-	UFUNCTION(BlueprintPure, Category = "RTS Actor")
-	FGameplayTagContainer GetRTS_Tags() const;
-	
-	// Selected Widget
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTS Widget")
-	TObjectPtr<UUserWidget> SelectedWidget;
-	
-	UFUNCTION(BlueprintCallable, Category = "RTS Widget")
-	UUserWidget* GetSelectedWidget() const;
-};
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "GameFramework/Character.h"
+#include "RTS_ActorInterface.h"
+#include "GameplayTagContainer.h"
+#include "Components/BoxComponent.h"
+#include "Components/BillboardComponent.h"
+#include "RTS_ModuleTypeId.h"
+
+#include "RTS_Actor.generated.h"
+
+class UInputMappingContext;
+class URTS_DataAsset;
+class URTS_Module;
+
+UCLASS()
+class DRAKTHYSPROJECT_API ARTS_Actor : public ACharacter, public IRTS_ActorInterface
+{
+	GENERATED_BODY()
+
+public:
+	ARTS_Actor(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	/** Subobject names of the building-only boxes, so subclasses can skip them with DoNotCreateDefaultSubobject */
+	static const FName NavigationBoxName;
+	static const FName PlacementBoxName;
+
+	/**
+	 * Actor class to spawn for DataAsset: its ActorClass override if set, otherwise ARTS_UnitActor when the
+	 * data asset has a movement module and ARTS_StaticBuilding when it does not.
+	 */
+	static TSubclassOf<ARTS_Actor> GetSpawnClassFor(const URTS_DataAsset* DataAsset);
+	
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "RTS Actor")
+	void Initialize();
+	virtual void Initialize_Implementation();
+
+	UFUNCTION(Category = "RTS Actor")
+	void InitializeModules();
+
+	// Component setup functions
+	/** Binds the UWidgetsComponent widget when the actor has one, otherwise URTS_SelectionWidgetPool binds one on selection */
+	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
+	void InitializeSelectedWidget();
+	
+	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
+	void SetupActorComponents();
+	
+	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
+	void SetupAsCharacter();
+	
+	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
+	void SetupAsStaticBuilding();
+
+	// Initialize Mesh, Navigation Box, 
+	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
+	void InitializeMesh();
+	
+	// Initialize Navigation Box separately
+	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
+	void InitializeNavigationBox();
+	
+	// Initialize Placement Box for building placement
+	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
+	void InitializePlacementBox();
+	
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "RTS Actor")
+	TObjectPtr<USceneComponent> RTS_Actor = nullptr;
+	
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "RTS Actor")
+	TObjectPtr<UStaticMeshComponent> RTS_StaticMesh = nullptr;
+	
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "RTS Actor")
+	TObjectPtr<UBillboardComponent> RTS_Billboard = nullptr;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "RTS Actor")
+	TObjectPtr<UBoxComponent> RTS_NavigationBox = nullptr;
+	
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "RTS Actor")
+	TObjectPtr<UBoxComponent> RTS_PlacementBox = nullptr;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTS Actor", meta = (ExposeOnSpawn = true))
+	TObjectPtr<URTS_DataAsset> ActorDataAsset = nullptr;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite,  Category = "RTS Actor")
+	TMap<FGameplayTag, TObjectPtr<URTS_Module>> Modules;
+
+	/** Adds a module under its tag and registers it in the typed module slots */
+	void AddModule(const FGameplayTag& Tag, URTS_Module* Module);
+
+	/** Rebuilds the typed module slots from Modules, call after editing Modules directly */
+	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
+	void RebuildModuleSlots();
+
+	/** Typed module access: presence mask test plus slot load, no tag hashing or Cast */
+	template<typename ModuleType>
+	ModuleType* GetModule() const
+	{
+		return static_cast<ModuleType*>(GetModuleByTypeId(TRTSModuleId<ModuleType>::Get()));
+	}
+
+	URTS_Module* GetModuleByTypeId(int32 TypeId) const
+	{
+		if (TypeId == INDEX_NONE || !(ModulePresenceMask & (1ull << TypeId)))
+		{
+			return nullptr;
+		}
+		return ModuleSlots[FMath::CountBits(ModulePresenceMask & ((1ull << TypeId) - 1))];
+	}
+
+	// Access to RTS_DataAsset variables
+	UFUNCTION(BlueprintCallable, Category = "RTS Input")
+	UInputMappingContext* GetSelectedContext() const;
+
+	UFUNCTION(BlueprintCallable, Category = "RTS Input")
+	UInputMappingContext* GetHoveredContext() const;
+
+	UFUNCTION(BlueprintPure, Category = "RTS Actor")
+	FGameplayTag GetRTSGameplayTag() const;
+	
+	UFUNCTION(BlueprintPure, Category = "RTS Actor")
+	FName GetRTS_ActorTypeTag() const;
+
+	UFUNCTION(BlueprintPure, Category = "RTS Actor")
+	FGameplayTagContainer GetRTS_Tags() const;
+	
+	// Selected Widget
+	/** Widget of the actor's UWidgetsComponent, or the one URTS_SelectionWidgetPool binds while the actor is selected or hovered */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTS Widget")
+	TObjectPtr<UUserWidget> SelectedWidget;
+	
+	UFUNCTION(BlueprintCallable, Category = "RTS Widget")
+	UUserWidget* GetSelectedWidget() const;
+
+	// Selection
+	/** Called by the selection code on select and deselect, URTS_SelectionWidgetPool::SetSelection keeps it in sync as well */
+	UFUNCTION(BlueprintCallable, Category = "RTS Actor")
+	void SetSelected(bool bInSelected) { bSelected = bInSelected; }
+
+	UFUNCTION(BlueprintPure, Category = "RTS Actor")
+	bool IsSelected() const { return bSelected; }
+
+	// Pooling (driven by URTS_ActorPool)
+	/** Hides and parks the actor, stops movement and resets every module */
+	void DeactivateForPool();
+
+	/** Re-homes a parked actor at Transform and resets its modules for a fresh life */
+	void ActivateFromPool(const FTransform& Transform);
+
+	UFUNCTION(BlueprintPure, Category = "RTS Actor")
+	bool IsInPool() const { return bInPool; }
+
+	/** Called after the actor was taken out of the pool, the Blueprint counterpart of a fresh spawn */
+	UFUNCTION(BlueprintImplementableEvent, Category = "RTS Actor")
+	void OnActivatedFromPool();
+
+private:
+	void ResetModules();
+
+	bool bInPool = false;
+	bool bSelected = false;
+
+	/** Registers Module in the slot of its class and of every native module base class above it */
+	void RegisterModuleSlots(URTS_Module* Module);
+
+	/** One bit per FRTSModuleTypeRegistry index */
+	uint64 ModulePresenceMask = 0;
+
+	/** One entry per set presence bit in bit order, a type's slot is the number of set bits below it. Kept alive by Modules */
+	TArray<URTS_Module*> ModuleSlots;
+};
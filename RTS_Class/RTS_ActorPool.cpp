@@ -0,0 +1,186 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "RTS_ActorPool.h"
+#include "RTS_Actor.h"
+#include "RTS_DataAsset.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld GDumpRTSActorPoolCommand(
+	TEXT("RTS.Pool.Dump"),
+	TEXT("Logs hit/miss/release counters of the RTS actor pool per data asset."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const URTS_ActorPool* Pool = URTS_ActorPool::Get(World))
+		{
+			Pool->DumpStats();
+		}
+	}));
+
+URTS_ActorPool* URTS_ActorPool::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<URTS_ActorPool>() : nullptr;
+}
+
+void URTS_ActorPool::Deinitialize()
+{
+	// Parked actors belong to the level and are torn down with it
+	PooledActors.Empty();
+	PoolStats.Empty();
+
+	Super::Deinitialize();
+}
+
+ARTS_Actor* URTS_ActorPool::AcquireActor(TSubclassOf<ARTS_Actor> ActorClass, URTS_DataAsset* DataAsset, const FTransform& Transform, AActor* SpawnOwner)
+{
+	if (!ActorClass)
+	{
+		// Let the data asset pick between the unit and the static building variant
+		if (!DataAsset)
+		{
+			return nullptr;
+		}
+		ActorClass = ARTS_Actor::GetSpawnClassFor(DataAsset);
+	}
+
+	if (DataAsset)
+	{
+		FRTSActorPoolStats& Stats = PoolStats.FindOrAdd(DataAsset);
+		if (FRTSActorPoolBucket* Bucket = PooledActors.Find(DataAsset))
+		{
+			// Newest first, parked actors destroyed by someone else were nulled by GC
+			for (int32 Index = Bucket->Actors.Num() - 1; Index >= 0; --Index)
+			{
+				ARTS_Actor* Candidate = Bucket->Actors[Index];
+				if (!IsValid(Candidate))
+				{
+					Bucket->Actors.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+					continue;
+				}
+				if (Candidate->GetClass() != ActorClass)
+				{
+					continue;
+				}
+
+				Bucket->Actors.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+				Stats.Hits++;
+				Stats.Available = Bucket->Actors.Num();
+
+				Candidate->SetOwner(SpawnOwner);
+				Candidate->ActivateFromPool(Transform);
+				return Candidate;
+			}
+		}
+		Stats.Misses++;
+	}
+
+	return SpawnPooledActor(ActorClass, DataAsset, Transform, SpawnOwner);
+}
+
+void URTS_ActorPool::ReleaseActor(ARTS_Actor* Actor)
+{
+	if (!IsValid(Actor) || Actor->IsInPool())
+	{
+		return;
+	}
+
+	URTS_DataAsset* DataAsset = Actor->ActorDataAsset;
+	FRTSActorPoolBucket* Bucket = DataAsset ? &PooledActors.FindOrAdd(DataAsset) : nullptr;
+	if (!Bucket || Bucket->Actors.Num() >= MaxPooledPerAsset)
+	{
+		Actor->Destroy();
+		return;
+	}
+
+	Actor->DeactivateForPool();
+	Bucket->Actors.Add(Actor);
+
+	FRTSActorPoolStats& Stats = PoolStats.FindOrAdd(DataAsset);
+	Stats.Releases++;
+	Stats.Available = Bucket->Actors.Num();
+}
+
+void URTS_ActorPool::Prewarm(TSubclassOf<ARTS_Actor> ActorClass, URTS_DataAsset* DataAsset, int32 Count)
+{
+	if (!ActorClass || !DataAsset)
+	{
+		return;
+	}
+
+	FRTSActorPoolBucket& Bucket = PooledActors.FindOrAdd(DataAsset);
+	const int32 ToSpawn = FMath::Min(Count, MaxPooledPerAsset - Bucket.Actors.Num());
+	for (int32 Index = 0; Index < ToSpawn; ++Index)
+	{
+		if (ARTS_Actor* Actor = SpawnPooledActor(ActorClass, DataAsset, FTransform::Identity, nullptr))
+		{
+			Actor->DeactivateForPool();
+			Bucket.Actors.Add(Actor);
+		}
+	}
+
+	PoolStats.FindOrAdd(DataAsset).Available = Bucket.Actors.Num();
+}
+
+ARTS_Actor* URTS_ActorPool::SpawnPooledActor(TSubclassOf<ARTS_Actor> ActorClass, URTS_DataAsset* DataAsset, const FTransform& Transform, AActor* SpawnOwner) const
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	ARTS_Actor* Actor = World->SpawnActorDeferred<ARTS_Actor>(
+		ActorClass,
+		Transform,
+		SpawnOwner,
+		nullptr,
+		ESpawnActorCollisionHandlingMethod::AlwaysSpawn
+	);
+
+	if (!Actor)
+	{
+		return nullptr;
+	}
+
+	if (DataAsset)
+	{
+		Actor->ActorDataAsset = DataAsset;
+	}
+
+	Actor->FinishSpawning(Transform);
+
+	// Nothing else initializes a pooled actor, a reused one comes back with its modules already in place
+	Actor->Initialize();
+	return Actor;
+}
+
+FRTSActorPoolStats URTS_ActorPool::GetPoolStats(URTS_DataAsset* DataAsset) const
+{
+	const FRTSActorPoolStats* Stats = PoolStats.Find(DataAsset);
+	return Stats ? *Stats : FRTSActorPoolStats();
+}
+
+FRTSActorPoolStats URTS_ActorPool::GetTotalStats() const
+{
+	FRTSActorPoolStats Total;
+	for (const TPair<TObjectPtr<URTS_DataAsset>, FRTSActorPoolStats>& Pair : PoolStats)
+	{
+		Total.Hits += Pair.Value.Hits;
+		Total.Misses += Pair.Value.Misses;
+		Total.Releases += Pair.Value.Releases;
+		Total.Available += Pair.Value.Available;
+	}
+	return Total;
+}
+
+void URTS_ActorPool::DumpStats() const
+{
+	const FRTSActorPoolStats Total = GetTotalStats();
+	UE_LOG(LogTemp, Log, TEXT("URTS_ActorPool - hits %d, misses %d, releases %d, available %d"), Total.Hits, Total.Misses, Total.Releases, Total.Available);
+	for (const TPair<TObjectPtr<URTS_DataAsset>, FRTSActorPoolStats>& Pair : PoolStats)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  %s: hits %d, misses %d, releases %d, available %d"),
+			*GetNameSafe(Pair.Key), Pair.Value.Hits, Pair.Value.Misses, Pair.Value.Releases, Pair.Value.Available);
+	}
+}
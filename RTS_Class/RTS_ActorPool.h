@@ -0,0 +1,93 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "RTS_ActorPool.generated.h"
+
+class ARTS_Actor;
+class URTS_DataAsset;
+
+USTRUCT(BlueprintType)
+struct FRTSActorPoolStats
+{
+	GENERATED_BODY()
+
+	/** Acquires served from the pool */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Actor Pool")
+	int32 Hits = 0;
+
+	/** Acquires that had to spawn a new actor */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Actor Pool")
+	int32 Misses = 0;
+
+	/** Actors handed back to the pool instead of being destroyed */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Actor Pool")
+	int32 Releases = 0;
+
+	/** Actors currently parked in the pool */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Actor Pool")
+	int32 Available = 0;
+};
+
+USTRUCT()
+struct FRTSActorPoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<ARTS_Actor>> Actors;
+};
+
+/**
+ * Per-world pool of ARTS_Actors keyed by their URTS_DataAsset.
+ * Released actors keep their components and modules; they are hidden, parked and have their modules reset,
+ * so reusing one is a teleport plus a ResetModule pass instead of a full spawn, Initialize and later GC.
+ */
+UCLASS()
+class FINALRTS_API URTS_ActorPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URTS_ActorPool* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Returns a pooled actor for DataAsset moved to Transform, or spawns a new one on a miss.
+	 * Newly spawned and prewarmed actors are spawned and initialized here, callers get a ready actor either way.
+	 * With no ActorClass the class comes from ARTS_Actor::GetSpawnClassFor(DataAsset).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "RTS Actor Pool")
+	ARTS_Actor* AcquireActor(TSubclassOf<ARTS_Actor> ActorClass, URTS_DataAsset* DataAsset, const FTransform& Transform, AActor* SpawnOwner = nullptr);
+
+	/** Parks the actor for reuse. Actors without a data asset or over the pool limit are destroyed instead */
+	UFUNCTION(BlueprintCallable, Category = "RTS Actor Pool")
+	void ReleaseActor(ARTS_Actor* Actor);
+
+	/** Spawns Count parked actors up front so the first acquires of a match are hits */
+	UFUNCTION(BlueprintCallable, Category = "RTS Actor Pool")
+	void Prewarm(TSubclassOf<ARTS_Actor> ActorClass, URTS_DataAsset* DataAsset, int32 Count);
+
+	UFUNCTION(BlueprintPure, Category = "RTS Actor Pool")
+	FRTSActorPoolStats GetPoolStats(URTS_DataAsset* DataAsset) const;
+
+	UFUNCTION(BlueprintPure, Category = "RTS Actor Pool")
+	FRTSActorPoolStats GetTotalStats() const;
+
+	void DumpStats() const;
+
+	/** Upper bound of parked actors per data asset */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTS Actor Pool")
+	int32 MaxPooledPerAsset = 256;
+
+private:
+	ARTS_Actor* SpawnPooledActor(TSubclassOf<ARTS_Actor> ActorClass, URTS_DataAsset* DataAsset, const FTransform& Transform, AActor* SpawnOwner) const;
+
+	/** Parked actors per data asset */
+	UPROPERTY()
+	TMap<TObjectPtr<URTS_DataAsset>, FRTSActorPoolBucket> PooledActors;
+
+	UPROPERTY()
+	TMap<TObjectPtr<URTS_DataAsset>, FRTSActorPoolStats> PoolStats;
+};
@@ -1,18 +1,66 @@
-﻿// Copyright AmberleafCotton 2025. All Rights Reserved.
-#include "RTS_Module.h"
-#include "RTS_Actor.h"
-
-URTS_Module::URTS_Module()
-{
-	
-}
-
-void URTS_Module::InitializeModule_Implementation(ARTS_Actor* InOwner)
-{
-	Owner = InOwner;
-}
-
-UWorld* URTS_Module::GetWorld() const
-{
-	return Owner ? Owner->GetWorld() : nullptr;
+﻿// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "RTS_Module.h"
+#include "RTS_Actor.h"
+#include "UObject/UnrealType.h"
+
+URTS_Module::URTS_Module()
+{
+	
+}
+
+void URTS_Module::InitializeModule_Implementation(ARTS_Actor* InOwner)
+{
+	Owner = InOwner;
+}
+
+void URTS_Module::ResetModule_Implementation()
+{
+	// Base implementation - nothing to reset
+}
+
+UWorld* URTS_Module::GetWorld() const
+{
+	return Owner ? Owner->GetWorld() : nullptr;
+}
+
+void URTS_Module::InitializeFromArchetype(const URTS_Module* InArchetype)
+{
+	Archetype = InArchetype;
+	if (!InArchetype)
+	{
+		return;
+	}
+
+	TArray<FName> SharedProperties;
+	GetSharedArchetypeProperties(SharedProperties);
+
+	for (TFieldIterator<FProperty> It(GetClass()); It; ++It)
+	{
+		FProperty* Property = *It;
+		const FName PropertyName = Property->GetFName();
+		if (Property->HasAnyPropertyFlags(CPF_Transient)
+			|| PropertyName == GET_MEMBER_NAME_CHECKED(URTS_Module, Archetype)
+			|| PropertyName == GET_MEMBER_NAME_CHECKED(URTS_Module, Owner))
+		{
+			continue;
+		}
+
+		// Blueprint class defaults may have filled it on construction, the instance reads the archetype's
+		if (SharedProperties.Contains(PropertyName))
+		{
+			Property->ClearValue_InContainer(this);
+			continue;
+		}
+
+		// Instanced subobjects (gather/deposit methods) carry per-worker state, never share the archetype's
+		const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property);
+		if (ObjectProperty && Property->HasAnyPropertyFlags(CPF_InstancedReference))
+		{
+			UObject* Source = ObjectProperty->GetObjectPropertyValue_InContainer(InArchetype);
+			ObjectProperty->SetObjectPropertyValue_InContainer(this, Source ? DuplicateObject<UObject>(Source, this) : nullptr);
+			continue;
+		}
+
+		Property->CopyCompleteValue_InContainer(this, InArchetype);
+	}
 }
\ No newline at end of file
@@ -1,35 +1,70 @@
-﻿// Copyright AmberleafCotton 2025. All Rights Reserved.
-#pragma once
-
-#include "UObject/Object.h"
-#include "RTS_Module.generated.h"
-
-class ARTS_Actor;
-
-/**
- * Base class for all RTS Modules.
- * Provides common behavior and structure for modular systems.
- */
-UCLASS(Blueprintable, BlueprintType)
-class FINALRTS_API URTS_Module : public UObject
-{
-	GENERATED_BODY()
-
-public:
-	URTS_Module();
-
-	// Parent class (RTS Actor or base class)
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "RTS Module")
-	void InitializeModule(ARTS_Actor* InOwner);
-	virtual void InitializeModule_Implementation(ARTS_Actor* InOwner);
-	
-	UPROPERTY()
-	ARTS_Actor* Owner = nullptr;
-
-	UFUNCTION()
-	UWorld* GetWorld() const;
-	
-	/** Returns the owner of this module */
-	UFUNCTION(BlueprintPure, Category = "Recruitment Module")
-	ARTS_Actor* GetModuleOwner() const { return Owner; }
-};
+﻿// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "UObject/Object.h"
+#include "RTS_Module.generated.h"
+
+class ARTS_Actor;
+
+/**
+ * Base class for all RTS Modules.
+ * Provides common behavior and structure for modular systems.
+ */
+UCLASS(Blueprintable, BlueprintType)
+class FINALRTS_API URTS_Module : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	URTS_Module();
+
+	// Parent class (RTS Actor or base class)
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "RTS Module")
+	void InitializeModule(ARTS_Actor* InOwner);
+	virtual void InitializeModule_Implementation(ARTS_Actor* InOwner);
+
+	/** Returns the module to its freshly initialized state, used when the owner is recycled by URTS_ActorPool */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "RTS Module")
+	void ResetModule();
+	virtual void ResetModule_Implementation();
+	
+	UPROPERTY()
+	ARTS_Actor* Owner = nullptr;
+
+	UFUNCTION()
+	UWorld* GetWorld() const;
+
+	/** Module from the data asset this instance was created from. Shared between all actors, never mutated */
+	UPROPERTY()
+	TObjectPtr<const URTS_Module> Archetype = nullptr;
+
+	/**
+	 * Whether instances are built from the class defaults plus InitializeFromArchetype instead of DuplicateObject.
+	 * Cheaper than the serialization DuplicateObject goes through, and lets heavy config stay on the archetype.
+	 */
+	virtual bool SupportsSharedArchetype() const { return false; }
+
+	/**
+	 * Called on an instance built from the class defaults. Copies every per-instance property from the archetype,
+	 * Blueprint variables included, and gives instanced subobjects their own copy. Properties named by
+	 * GetSharedArchetypeProperties are not copied and are left empty, the module reads them through GetArchetype().
+	 */
+	virtual void InitializeFromArchetype(const URTS_Module* InArchetype);
+
+	/** Heavy config that stays on the archetype instead of being copied into every instance */
+	virtual void GetSharedArchetypeProperties(TArray<FName>& OutPropertyNames) const {}
+
+	/** True while the module runs something with a progress bar, URTS_UIEventSubsystem refreshes watching widgets every frame then */
+	virtual bool HasActiveProgress() const { return false; }
+
+	/** Archetype typed as the calling module class, null for modules that were not created from one */
+	template<typename ModuleType>
+	const ModuleType* GetArchetype() const
+	{
+		return static_cast<const ModuleType*>(Archetype.Get());
+	}
+	
+	/** Returns the owner of this module */
+	UFUNCTION(BlueprintPure, Category = "Recruitment Module")
+	ARTS_Actor* GetModuleOwner() const { return Owner; }
+};
@@ -0,0 +1,236 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "RTS_ModuleScheduler.h"
+#include "RTS_Stats.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld GDumpRTSSchedulerCommand(
+	TEXT("RTS.Scheduler.Dump"),
+	TEXT("Logs how many module callbacks each category fired during the last frame."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const URTS_ModuleScheduler* Scheduler = URTS_ModuleScheduler::Get(World))
+		{
+			Scheduler->DumpStats();
+		}
+	}));
+
+URTS_ModuleScheduler* URTS_ModuleScheduler::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<URTS_ModuleScheduler>() : nullptr;
+}
+
+void URTS_ModuleScheduler::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Buckets.SetNum(WheelSize);
+	LastProcessedTick = GetTickForTime(GetSchedulerTime());
+}
+
+void URTS_ModuleScheduler::Deinitialize()
+{
+	Entries.Empty();
+	FreeEntries.Empty();
+	Buckets.Empty();
+	DueThisFrame.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId URTS_ModuleScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URTS_ModuleScheduler, STATGROUP_Tickables);
+}
+
+double URTS_ModuleScheduler::GetSchedulerTime() const
+{
+	// World time pauses and dilates the same way FTimerManager does
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+int64 URTS_ModuleScheduler::GetTickForTime(double Time) const
+{
+	return FMath::FloorToInt64(Time / WheelResolution);
+}
+
+int32 URTS_ModuleScheduler::FindOrAddCategory(FName Category)
+{
+	if (const int32* Found = CategoryLookup.Find(Category))
+	{
+		return *Found;
+	}
+
+	FRTSScheduleCategoryStats& Stats = CategoryStats.AddDefaulted_GetRef();
+	Stats.Category = Category;
+	return CategoryLookup.Add(Category, CategoryStats.Num() - 1);
+}
+
+FRTSScheduleHandle URTS_ModuleScheduler::Schedule(FName Category, FSimpleDelegate Callback, float Delay, float Interval)
+{
+	FRTSScheduleHandle Handle;
+	if (!Callback.IsBound())
+	{
+		return Handle;
+	}
+
+	const int32 EntryIndex = FreeEntries.Num() > 0 ? FreeEntries.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+
+	FScheduledEntry& Entry = Entries[EntryIndex];
+	Entry.Callback = MoveTemp(Callback);
+	Entry.DueTime = GetSchedulerTime() + FMath::Max(Delay, 0.f);
+	Entry.Interval = FMath::Max(Interval, 0.f);
+	Entry.CategoryIndex = FindOrAddCategory(Category);
+	Entry.Serial = NextSerial++;
+
+	// Serial 0 marks a free entry
+	if (NextSerial == 0)
+	{
+		NextSerial = 1;
+	}
+
+	CategoryStats[Entry.CategoryIndex].Pending++;
+	InsertIntoWheel(EntryIndex);
+
+	Handle.Index = EntryIndex;
+	Handle.Serial = Entry.Serial;
+	return Handle;
+}
+
+void URTS_ModuleScheduler::InsertIntoWheel(int32 EntryIndex)
+{
+	const FScheduledEntry& Entry = Entries[EntryIndex];
+
+	// Anything already overdue goes into the bucket that is processed next
+	const int64 Tick = FMath::Max(GetTickForTime(Entry.DueTime), LastProcessedTick);
+	Buckets[static_cast<int32>(Tick % WheelSize)].Add({ EntryIndex, Entry.Serial });
+}
+
+void URTS_ModuleScheduler::ReleaseEntry(int32 EntryIndex)
+{
+	FScheduledEntry& Entry = Entries[EntryIndex];
+	CategoryStats[Entry.CategoryIndex].Pending--;
+
+	// Stale bucket slots are detected through the serial and dropped lazily
+	Entry.Callback.Unbind();
+	Entry.Serial = 0;
+	FreeEntries.Add(EntryIndex);
+}
+
+void URTS_ModuleScheduler::Cancel(FRTSScheduleHandle& Handle)
+{
+	if (IsScheduled(Handle))
+	{
+		ReleaseEntry(Handle.Index);
+	}
+	Handle.Invalidate();
+}
+
+bool URTS_ModuleScheduler::IsScheduled(const FRTSScheduleHandle& Handle) const
+{
+	return Handle.IsValid() && Entries.IsValidIndex(Handle.Index) && Entries[Handle.Index].Serial == Handle.Serial;
+}
+
+float URTS_ModuleScheduler::GetTimeRemaining(const FRTSScheduleHandle& Handle) const
+{
+	if (!IsScheduled(Handle))
+	{
+		return -1.f;
+	}
+	return FMath::Max(0.f, static_cast<float>(Entries[Handle.Index].DueTime - GetSchedulerTime()));
+}
+
+void URTS_ModuleScheduler::Tick(float DeltaTime)
+{
+	RTS_MODULE_SCOPE(STAT_RTS_SchedulerTick);
+
+	Super::Tick(DeltaTime);
+
+	for (FRTSScheduleCategoryStats& Stats : CategoryStats)
+	{
+		Stats.FiredLastFrame = 0;
+	}
+	FiredLastFrame = 0;
+
+	const double Now = GetSchedulerTime();
+	const int64 CurrentTick = GetTickForTime(Now);
+
+	// Walk every bucket between the last processed tick and now, at most one full turn of the wheel.
+	// The last processed bucket is revisited because it may still hold entries due later in that step.
+	DueThisFrame.Reset();
+	const int64 LastTick = FMath::Min(CurrentTick, LastProcessedTick + WheelSize - 1);
+	for (int64 Tick = LastProcessedTick; Tick <= LastTick; ++Tick)
+	{
+		TArray<FBucketSlot>& Bucket = Buckets[static_cast<int32>(Tick % WheelSize)];
+		for (int32 SlotIndex = Bucket.Num() - 1; SlotIndex >= 0; --SlotIndex)
+		{
+			const FBucketSlot Slot = Bucket[SlotIndex];
+			const FScheduledEntry& Entry = Entries[Slot.Index];
+			if (Entry.Serial != Slot.Serial)
+			{
+				Bucket.RemoveAtSwap(SlotIndex, 1, EAllowShrinking::No);
+			}
+			else if (Entry.DueTime <= Now)
+			{
+				DueThisFrame.Add(Slot);
+				Bucket.RemoveAtSwap(SlotIndex, 1, EAllowShrinking::No);
+			}
+		}
+	}
+	LastProcessedTick = CurrentTick;
+
+	if (DueThisFrame.Num() == 0)
+	{
+		return;
+	}
+
+	DueThisFrame.Sort([this](const FBucketSlot& A, const FBucketSlot& B)
+	{
+		return Entries[A.Index].DueTime < Entries[B.Index].DueTime;
+	});
+
+	for (const FBucketSlot& Slot : DueThisFrame)
+	{
+		// An earlier callback this frame may have cancelled this one
+		if (Entries[Slot.Index].Serial != Slot.Serial)
+		{
+			continue;
+		}
+
+		// Copy the delegate out, the callback is allowed to schedule and grow the entry array
+		FSimpleDelegate Callback = Entries[Slot.Index].Callback;
+		FRTSScheduleCategoryStats& Stats = CategoryStats[Entries[Slot.Index].CategoryIndex];
+		Stats.FiredLastFrame++;
+		Stats.FiredTotal++;
+		FiredLastFrame++;
+		INC_DWORD_STAT(STAT_RTS_SchedulerCallbacks);
+
+		if (Entries[Slot.Index].Interval > 0.f)
+		{
+			Entries[Slot.Index].DueTime += Entries[Slot.Index].Interval;
+			InsertIntoWheel(Slot.Index);
+		}
+		else
+		{
+			ReleaseEntry(Slot.Index);
+		}
+
+		if (!Callback.ExecuteIfBound() && Entries[Slot.Index].Serial == Slot.Serial)
+		{
+			// Owner is gone, stop looping on its behalf
+			ReleaseEntry(Slot.Index);
+		}
+	}
+}
+
+void URTS_ModuleScheduler::DumpStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("URTS_ModuleScheduler - %d callbacks fired last frame, %d entries allocated"), FiredLastFrame, Entries.Num() - FreeEntries.Num());
+	for (const FRTSScheduleCategoryStats& Stats : CategoryStats)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  %s: fired %d (total %lld), pending %d"), *Stats.Category.ToString(), Stats.FiredLastFrame, Stats.FiredTotal, Stats.Pending);
+	}
+}
@@ -0,0 +1,137 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "RTS_ModuleScheduler.generated.h"
+
+/**
+ * Handle to a callback registered with URTS_ModuleScheduler.
+ * Plays the same role as FTimerHandle for module timers.
+ */
+struct FRTSScheduleHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+};
+
+/** Per-category counters, one category per scheduling class (e.g. UGatherMethod_001, URecruitmentModule) */
+USTRUCT(BlueprintType)
+struct FRTSScheduleCategoryStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Scheduler")
+	FName Category = NAME_None;
+
+	/** Callbacks fired during the last processed frame */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Scheduler")
+	int32 FiredLastFrame = 0;
+
+	/** Callbacks currently waiting in the wheel */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Scheduler")
+	int32 Pending = 0;
+
+	/** Callbacks fired since the world started */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Scheduler")
+	int64 FiredTotal = 0;
+};
+
+/**
+ * Central scheduler for RTS modules.
+ * Replaces per-module FTimerManager timers with a single timing wheel that is advanced once per frame.
+ * All callbacks due in a frame are collected in one pass over the expired buckets and fired in due-time order.
+ */
+UCLASS()
+class FINALRTS_API URTS_ModuleScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the scheduler of the world the context object lives in */
+	static URTS_ModuleScheduler* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Schedules Callback to fire after Delay seconds of world time.
+	 * If Interval > 0 the callback keeps firing every Interval seconds until cancelled.
+	 */
+	FRTSScheduleHandle Schedule(FName Category, FSimpleDelegate Callback, float Delay, float Interval = 0.f);
+
+	/**
+	 * Convenience wrapper that binds a UObject member function, category is the object's class.
+	 * Like FTimerManager::SetTimer, a callback still pending on InOutHandle is cancelled first.
+	 */
+	template<typename UserClass>
+	void ScheduleUObject(FRTSScheduleHandle& InOutHandle, UserClass* Object, void (UserClass::*Function)(), float Delay, bool bLooping = false)
+	{
+		Cancel(InOutHandle);
+		InOutHandle = Schedule(Object->GetClass()->GetFName(), FSimpleDelegate::CreateUObject(Object, Function), Delay, bLooping ? Delay : 0.f);
+	}
+
+	/** Cancels a scheduled callback and invalidates the handle */
+	void Cancel(FRTSScheduleHandle& Handle);
+
+	/** True while the handle refers to a pending callback */
+	bool IsScheduled(const FRTSScheduleHandle& Handle) const;
+
+	/** Seconds left until the callback fires, -1 if not scheduled */
+	float GetTimeRemaining(const FRTSScheduleHandle& Handle) const;
+
+	UFUNCTION(BlueprintPure, Category = "RTS Scheduler")
+	TArray<FRTSScheduleCategoryStats> GetCategoryStats() const { return CategoryStats; }
+
+	UFUNCTION(BlueprintPure, Category = "RTS Scheduler")
+	int32 GetFiredLastFrame() const { return FiredLastFrame; }
+
+	/** Writes per-category counters to the log */
+	void DumpStats() const;
+
+private:
+	struct FScheduledEntry
+	{
+		FSimpleDelegate Callback;
+		double DueTime = 0.0;
+		float Interval = 0.f;
+		int32 CategoryIndex = INDEX_NONE;
+		uint32 Serial = 0;
+	};
+
+	struct FBucketSlot
+	{
+		int32 Index = INDEX_NONE;
+		uint32 Serial = 0;
+	};
+
+	/** Wheel resolution in seconds, one bucket per step */
+	static constexpr double WheelResolution = 0.05;
+
+	/** Number of buckets, callbacks further away than the horizon stay in their bucket until due */
+	static constexpr int32 WheelSize = 256;
+
+	int32 FindOrAddCategory(FName Category);
+	void InsertIntoWheel(int32 EntryIndex);
+	void ReleaseEntry(int32 EntryIndex);
+	int64 GetTickForTime(double Time) const;
+	double GetSchedulerTime() const;
+
+	TArray<FScheduledEntry> Entries;
+	TArray<int32> FreeEntries;
+	TArray<TArray<FBucketSlot>> Buckets;
+
+	/** Entries collected during the current frame, kept around to avoid reallocating every tick */
+	TArray<FBucketSlot> DueThisFrame;
+
+	TArray<FRTSScheduleCategoryStats> CategoryStats;
+	TMap<FName, int32> CategoryLookup;
+
+	int64 LastProcessedTick = 0;
+	uint32 NextSerial = 1;
+	int32 FiredLastFrame = 0;
+};
@@ -0,0 +1,121 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "RTS_ModuleTypeId.h"
+#include "RTS_Actor.h"
+#include "RTS_Module.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace RTSModuleTypeRegistry
+{
+	static FRWLock Lock;
+	static TMap<const UClass*, int32> TypeIds;
+}
+
+int32 FRTSModuleTypeRegistry::GetTypeId(const UClass* ModuleClass)
+{
+	// Blueprint classes share the index of their native parent, they would use up the table otherwise
+	if (!ModuleClass || !ModuleClass->HasAnyClassFlags(CLASS_Native))
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 ExistingId = FindTypeId(ModuleClass);
+	if (ExistingId != INDEX_NONE)
+	{
+		return ExistingId;
+	}
+
+	FWriteScopeLock WriteLock(RTSModuleTypeRegistry::Lock);
+	if (const int32* Found = RTSModuleTypeRegistry::TypeIds.Find(ModuleClass))
+	{
+		return *Found;
+	}
+
+	if (RTSModuleTypeRegistry::TypeIds.Num() >= MaxModuleTypes)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FRTSModuleTypeRegistry - Out of module type slots, %s falls back to tag lookup"), *ModuleClass->GetName());
+		return INDEX_NONE;
+	}
+
+	return RTSModuleTypeRegistry::TypeIds.Add(ModuleClass, RTSModuleTypeRegistry::TypeIds.Num());
+}
+
+int32 FRTSModuleTypeRegistry::FindTypeId(const UClass* ModuleClass)
+{
+	FReadScopeLock ReadLock(RTSModuleTypeRegistry::Lock);
+	const int32* Found = RTSModuleTypeRegistry::TypeIds.Find(ModuleClass);
+	return Found ? *Found : INDEX_NONE;
+}
+
+// Micro-benchmark: tag map lookup + Cast (old path) against presence mask + slot load (GetModuleByTypeId)
+static FAutoConsoleCommandWithWorldAndArgs GBenchmarkRTSModuleLookupCommand(
+	TEXT("RTS.Modules.BenchmarkLookup"),
+	TEXT("Times tag based module lookup against typed slot lookup on every RTS actor. Usage: RTS.Modules.BenchmarkLookup [Iterations]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World) return;
+
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+
+		struct FLookupCase
+		{
+			ARTS_Actor* Actor;
+			FGameplayTag Tag;
+			const UClass* ModuleClass;
+			int32 TypeId;
+		};
+
+		TArray<FLookupCase> Cases;
+		for (TActorIterator<ARTS_Actor> It(World); It; ++It)
+		{
+			for (const TPair<FGameplayTag, TObjectPtr<URTS_Module>>& Pair : It->Modules)
+			{
+				if (Pair.Value)
+				{
+					// Blueprint modules are looked up through their native parent, like GetModule<T>() does
+					const UClass* NativeClass = Pair.Value->GetClass();
+					while (NativeClass && !NativeClass->HasAnyClassFlags(CLASS_Native))
+					{
+						NativeClass = NativeClass->GetSuperClass();
+					}
+					Cases.Add({ *It, Pair.Key, Pair.Value->GetClass(), FRTSModuleTypeRegistry::FindTypeId(NativeClass) });
+				}
+			}
+		}
+
+		if (Cases.Num() == 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("RTS.Modules.BenchmarkLookup - No RTS actors with modules in the world"));
+			return;
+		}
+
+		int32 TagHits = 0;
+		const double TagStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const FLookupCase& Case : Cases)
+			{
+				const TObjectPtr<URTS_Module>* Found = Case.Actor->Modules.Find(Case.Tag);
+				TagHits += (Found && *Found && (*Found)->IsA(Case.ModuleClass)) ? 1 : 0;
+			}
+		}
+		const double TagSeconds = FPlatformTime::Seconds() - TagStart;
+
+		int32 SlotHits = 0;
+		const double SlotStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const FLookupCase& Case : Cases)
+			{
+				SlotHits += Case.Actor->GetModuleByTypeId(Case.TypeId) ? 1 : 0;
+			}
+		}
+		const double SlotSeconds = FPlatformTime::Seconds() - SlotStart;
+
+		const double Lookups = static_cast<double>(Cases.Num()) * Iterations;
+		UE_LOG(LogTemp, Log, TEXT("RTS.Modules.BenchmarkLookup - %d lookups x %d iterations"), Cases.Num(), Iterations);
+		UE_LOG(LogTemp, Log, TEXT("  Tag map + Cast : %.2f ns/lookup (%d hits)"), TagSeconds * 1e9 / Lookups, TagHits);
+		UE_LOG(LogTemp, Log, TEXT("  Typed slot     : %.2f ns/lookup (%d hits)"), SlotSeconds * 1e9 / Lookups, SlotHits);
+	}));
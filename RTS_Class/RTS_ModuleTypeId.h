@@ -0,0 +1,45 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+class URTS_Module;
+
+/**
+ * Assigns a dense index to every native module class that is looked up by type.
+ * Indices back the presence mask and compact slot array on ARTS_Actor, so GetModule<T>() is a bit test, a popcount
+ * and an array load. Blueprint module classes get no index of their own, they are found through their native parent.
+ */
+struct FINALRTS_API FRTSModuleTypeRegistry
+{
+	/** Number of module type slots every actor carries, one bit each in the presence mask */
+	static constexpr int32 MaxModuleTypes = 64;
+
+	/** Returns the index of ModuleClass, assigning the next free one on first use. INDEX_NONE for non-native classes or once the table is full */
+	static int32 GetTypeId(const UClass* ModuleClass);
+
+	/** Returns the index of ModuleClass without assigning one */
+	static int32 FindTypeId(const UClass* ModuleClass);
+};
+
+/**
+ * Compile-time handle to a module type index, e.g. TRTSModuleId<UGatherableModule>::Get().
+ * The registry is only hit until the type has an index, after that it is a function-local static.
+ */
+template<typename ModuleType>
+struct TRTSModuleId
+{
+	static int32 Get()
+	{
+		static std::atomic<int32> CachedTypeId{ INDEX_NONE };
+		int32 TypeId = CachedTypeId.load(std::memory_order_relaxed);
+		if (TypeId == INDEX_NONE)
+		{
+			// A full table is not cached, a later lookup may still find an index assigned meanwhile
+			TypeId = FRTSModuleTypeRegistry::GetTypeId(ModuleType::StaticClass());
+			CachedTypeId.store(TypeId, std::memory_order_relaxed);
+		}
+		return TypeId;
+	}
+};
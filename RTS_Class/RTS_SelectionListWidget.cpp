@@ -0,0 +1,50 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "RTS_SelectionListWidget.h"
+#include "RTS_SelectionWidgetPool.h"
+#include "Components/ListView.h"
+
+void URTS_SelectionListWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	if (URTS_SelectionWidgetPool* Pool = URTS_SelectionWidgetPool::Get(this))
+	{
+		Pool->RegisterSelectionList(this);
+	}
+}
+
+void URTS_SelectionListWidget::NativeDestruct()
+{
+	if (URTS_SelectionWidgetPool* Pool = URTS_SelectionWidgetPool::Get(this))
+	{
+		Pool->UnregisterSelectionList(this);
+	}
+
+	Super::NativeDestruct();
+}
+
+void URTS_SelectionListWidget::SetSelectedActors(const TArray<ARTS_Actor*>& Actors)
+{
+	if (!SelectionList)
+	{
+		return;
+	}
+
+	SelectionList->SetListItems(Actors);
+	SetVisibility(Actors.Num() > 0 ? ESlateVisibility::SelfHitTestInvisible : ESlateVisibility::Collapsed);
+}
+
+void URTS_SelectionEntryWidget::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+	IUserObjectListEntry::NativeOnListItemObjectSet(ListItemObject);
+
+	// Entries are recycled while scrolling, rebinding also moves the UI event subscription
+	InitializeWidget(Cast<ARTS_Actor>(ListItemObject));
+}
+
+void URTS_SelectionEntryWidget::NativeOnEntryReleased()
+{
+	IUserObjectListEntry::NativeOnEntryReleased();
+
+	InitializeWidget(nullptr);
+}
@@ -0,0 +1,42 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "RTS_Widget.h"
+#include "Blueprint/IUserObjectListEntry.h"
+#include "RTS_SelectionListWidget.generated.h"
+
+class UListView;
+
+/**
+ * Selection panel for large selections.
+ * Actors are handed to a UListView as items, which only builds entry widgets for the rows on screen
+ * and recycles them while scrolling. Use URTS_SelectionEntryWidget (or a subclass) as the entry class.
+ */
+UCLASS(Abstract)
+class FINALRTS_API URTS_SelectionListWidget : public URTS_Widget
+{
+	GENERATED_BODY()
+
+public:
+	/** Replaces the listed actors, an empty array hides the panel */
+	UFUNCTION(BlueprintCallable, Category = "RTS Widget")
+	void SetSelectedActors(const TArray<ARTS_Actor*>& Actors);
+
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Widget", meta = (BindWidget))
+	TObjectPtr<UListView> SelectionList = nullptr;
+
+protected:
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+};
+
+/** One row of URTS_SelectionListWidget, bound to the actor of its list item */
+UCLASS(Abstract)
+class FINALRTS_API URTS_SelectionEntryWidget : public URTS_Widget, public IUserObjectListEntry
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+	virtual void NativeOnEntryReleased() override;
+};
@@ -0,0 +1,331 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "RTS_SelectionWidgetPool.h"
+#include "RTS_Actor.h"
+#include "RTS_DataAsset.h"
+#include "RTS_SelectionListWidget.h"
+#include "RTS_Widget.h"
+#include "WidgetComponent/WidgetsComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld GDumpRTSSelectionWidgetsCommand(
+	TEXT("RTS.UI.DumpSelectionWidgets"),
+	TEXT("Logs created/reused/active/pooled counters of the selection widget pool."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const URTS_SelectionWidgetPool* Pool = URTS_SelectionWidgetPool::Get(World))
+		{
+			Pool->DumpStats();
+		}
+	}));
+
+URTS_SelectionWidgetPool* URTS_SelectionWidgetPool::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<URTS_SelectionWidgetPool>() : nullptr;
+}
+
+void URTS_SelectionWidgetPool::Deinitialize()
+{
+	PooledWidgets.Empty();
+	ActiveWidgets.Empty();
+	BoundWidgets.Empty();
+	SelectedActors.Empty();
+	SelectedSet.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId URTS_SelectionWidgetPool::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URTS_SelectionWidgetPool, STATGROUP_Tickables);
+}
+
+void URTS_SelectionWidgetPool::Tick(float DeltaTime)
+{
+	UpdateWidgetPositions();
+}
+
+void URTS_SelectionWidgetPool::UpdateWidgetPositions()
+{
+	const UWorld* World = GetWorld();
+	APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	if (!PlayerController)
+	{
+		return;
+	}
+
+	for (const TPair<TObjectKey<ARTS_Actor>, URTS_Widget*>& Pair : BoundWidgets)
+	{
+		const ARTS_Actor* Actor = Pair.Key.ResolveObjectPtr();
+		URTS_Widget* Widget = Pair.Value;
+		if (!Actor || !Widget)
+		{
+			continue;
+		}
+
+		FVector Origin;
+		FVector Extent;
+		Actor->GetActorBounds(true, Origin, Extent);
+
+		FVector2D ScreenPosition;
+		const bool bOnScreen = UGameplayStatics::ProjectWorldToScreen(PlayerController, Origin + FVector(0.f, 0.f, Extent.Z) + WidgetWorldOffset, ScreenPosition, true);
+		if (bOnScreen)
+		{
+			Widget->SetPositionInViewport(ScreenPosition, true);
+		}
+		Widget->SetVisibility(bOnScreen ? ESlateVisibility::SelfHitTestInvisible : ESlateVisibility::Collapsed);
+	}
+}
+
+void URTS_SelectionWidgetPool::SetSelection(const TArray<ARTS_Actor*>& Actors)
+{
+	// Widgets of actors destroyed while bound would otherwise never come back
+	for (auto It = BoundWidgets.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.ResolveObjectPtr())
+		{
+			ParkWidget(It->Value);
+			It.RemoveCurrent();
+		}
+	}
+
+	TArray<TWeakObjectPtr<ARTS_Actor>> PreviousSelection = MoveTemp(SelectedActors);
+
+	SelectedActors.Reset(Actors.Num());
+	SelectedSet.Reset();
+	for (ARTS_Actor* Actor : Actors)
+	{
+		if (IsValid(Actor) && !Actor->IsInPool() && !SelectedSet.Contains(Actor))
+		{
+			SelectedActors.Add(Actor);
+			SelectedSet.Add(Actor);
+			Actor->SetSelected(true);
+		}
+	}
+
+	// Release first so the widgets are back in the pool for the newly selected actors
+	for (const TWeakObjectPtr<ARTS_Actor>& Previous : PreviousSelection)
+	{
+		ARTS_Actor* Actor = Previous.Get();
+		if (Actor && !SelectedSet.Contains(Actor))
+		{
+			Actor->SetSelected(false);
+		}
+		if (Actor && !WantsWidget(Actor))
+		{
+			ReleaseWidget(Actor);
+		}
+	}
+
+	if (SelectedActors.Num() <= MaxSelectionWidgets)
+	{
+		for (const TWeakObjectPtr<ARTS_Actor>& Selected : SelectedActors)
+		{
+			AcquireWidget(Selected.Get());
+		}
+	}
+
+	RefreshSelectionList();
+}
+
+void URTS_SelectionWidgetPool::SetHoveredActor(ARTS_Actor* Actor)
+{
+	ARTS_Actor* PreviousHovered = HoveredActor.Get();
+	if (PreviousHovered == Actor)
+	{
+		return;
+	}
+
+	HoveredActor = Actor;
+	if (PreviousHovered && !WantsWidget(PreviousHovered))
+	{
+		ReleaseWidget(PreviousHovered);
+	}
+	if (Actor)
+	{
+		AcquireWidget(Actor);
+	}
+}
+
+URTS_Widget* URTS_SelectionWidgetPool::AcquireWidget(ARTS_Actor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return nullptr;
+	}
+
+	if (URTS_Widget* const* Bound = BoundWidgets.Find(Actor))
+	{
+		return *Bound;
+	}
+
+	// Parked actors get nothing, actors holding a widget already (their UWidgetsComponent's, bound in
+	// ARTS_Actor::InitializeSelectedWidget, or one set from Blueprint) keep it instead of getting a second one
+	if (Actor->IsInPool() || Actor->SelectedWidget || Actor->FindComponentByClass<UWidgetsComponent>())
+	{
+		return nullptr;
+	}
+
+	const TSubclassOf<URTS_Widget> WidgetClass = GetWidgetClassFor(Actor);
+	if (!WidgetClass)
+	{
+		return nullptr;
+	}
+
+	URTS_Widget* Widget = nullptr;
+	if (FRTSSelectionWidgetBucket* Bucket = PooledWidgets.Find(WidgetClass))
+	{
+		while (!Widget && Bucket->Widgets.Num() > 0)
+		{
+			Widget = Bucket->Widgets.Pop(EAllowShrinking::No);
+		}
+	}
+
+	if (Widget)
+	{
+		Stats.Reused++;
+	}
+	else
+	{
+		UWorld* World = GetWorld();
+		Widget = World ? CreateWidget<URTS_Widget>(World, WidgetClass) : nullptr;
+		if (!Widget)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("URTS_SelectionWidgetPool::AcquireWidget() - Could not create %s for %s"), *GetNameSafe(WidgetClass), *Actor->GetName());
+			return nullptr;
+		}
+		Stats.Created++;
+	}
+
+	Widget->InitializeWidget(Actor);
+	if (!Widget->IsInViewport())
+	{
+		Widget->AddToViewport();
+	}
+	// Centered above the actor, placed by UpdateWidgetPositions from this frame on
+	Widget->SetAlignmentInViewport(FVector2D(0.5f, 1.f));
+	ActiveWidgets.Add(Widget);
+	BoundWidgets.Add(Actor, Widget);
+	Actor->SelectedWidget = Widget;
+	UpdateWidgetPositions();
+	return Widget;
+}
+
+void URTS_SelectionWidgetPool::ReleaseWidget(ARTS_Actor* Actor)
+{
+	URTS_Widget* Widget = nullptr;
+	if (!BoundWidgets.RemoveAndCopyValue(Actor, Widget) || !Widget)
+	{
+		return;
+	}
+
+	if (Actor && Actor->SelectedWidget == Widget)
+	{
+		Actor->SelectedWidget = nullptr;
+	}
+	ParkWidget(Widget);
+}
+
+void URTS_SelectionWidgetPool::ParkWidget(URTS_Widget* Widget)
+{
+	ActiveWidgets.RemoveSingleSwap(Widget, EAllowShrinking::No);
+	Widget->RemoveFromParent();
+	Widget->InitializeWidget(nullptr);
+
+	FRTSSelectionWidgetBucket& Bucket = PooledWidgets.FindOrAdd(Widget->GetClass());
+	if (Bucket.Widgets.Num() < MaxPooledPerClass)
+	{
+		Bucket.Widgets.Add(Widget);
+	}
+}
+
+URTS_Widget* URTS_SelectionWidgetPool::FindWidget(const ARTS_Actor* Actor) const
+{
+	URTS_Widget* const* Bound = BoundWidgets.Find(Actor);
+	return Bound ? *Bound : nullptr;
+}
+
+void URTS_SelectionWidgetPool::RegisterSelectionList(URTS_SelectionListWidget* List)
+{
+	SelectionList = List;
+	RefreshSelectionList();
+}
+
+void URTS_SelectionWidgetPool::UnregisterSelectionList(URTS_SelectionListWidget* List)
+{
+	if (SelectionList.Get() == List)
+	{
+		SelectionList.Reset();
+	}
+}
+
+TSubclassOf<URTS_Widget> URTS_SelectionWidgetPool::GetWidgetClassFor(const ARTS_Actor* Actor) const
+{
+	const URTS_DataAsset* DataAsset = Actor ? Actor->ActorDataAsset.Get() : nullptr;
+	return DataAsset && DataAsset->SelectedWidgetClass ? DataAsset->SelectedWidgetClass : DefaultWidgetClass;
+}
+
+bool URTS_SelectionWidgetPool::WantsWidget(const ARTS_Actor* Actor) const
+{
+	if (!Actor || Actor->IsInPool())
+	{
+		return false;
+	}
+	if (HoveredActor.Get() == Actor)
+	{
+		return true;
+	}
+	return SelectedActors.Num() <= MaxSelectionWidgets && SelectedSet.Contains(Actor);
+}
+
+void URTS_SelectionWidgetPool::RefreshSelectionList()
+{
+	const bool bUseList = SelectedActors.Num() > MaxSelectionWidgets;
+	Stats.ListedActors = bUseList ? SelectedActors.Num() : 0;
+
+	URTS_SelectionListWidget* List = SelectionList.Get();
+	if (!List)
+	{
+		return;
+	}
+
+	TArray<ARTS_Actor*> ListedActors;
+	if (bUseList)
+	{
+		ListedActors.Reserve(SelectedActors.Num());
+		for (const TWeakObjectPtr<ARTS_Actor>& Selected : SelectedActors)
+		{
+			if (ARTS_Actor* Actor = Selected.Get())
+			{
+				ListedActors.Add(Actor);
+			}
+		}
+	}
+	List->SetSelectedActors(ListedActors);
+}
+
+FRTSSelectionWidgetPoolStats URTS_SelectionWidgetPool::GetStats() const
+{
+	FRTSSelectionWidgetPoolStats Result = Stats;
+	Result.Active = ActiveWidgets.Num();
+	for (const TPair<TSubclassOf<URTS_Widget>, FRTSSelectionWidgetBucket>& Pair : PooledWidgets)
+	{
+		Result.Pooled += Pair.Value.Widgets.Num();
+	}
+	return Result;
+}
+
+void URTS_SelectionWidgetPool::DumpStats() const
+{
+	const FRTSSelectionWidgetPoolStats Current = GetStats();
+	UE_LOG(LogTemp, Log, TEXT("URTS_SelectionWidgetPool - created %d, reused %d, active %d, pooled %d, listed %d"),
+		Current.Created, Current.Reused, Current.Active, Current.Pooled, Current.ListedActors);
+	for (const TPair<TSubclassOf<URTS_Widget>, FRTSSelectionWidgetBucket>& Pair : PooledWidgets)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  %s: %d pooled"), *GetNameSafe(Pair.Key), Pair.Value.Widgets.Num());
+	}
+}
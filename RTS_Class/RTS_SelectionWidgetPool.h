@@ -0,0 +1,145 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RTS_SelectionWidgetPool.generated.h"
+
+class ARTS_Actor;
+class URTS_Widget;
+class URTS_SelectionListWidget;
+
+USTRUCT(BlueprintType)
+struct FRTSSelectionWidgetPoolStats
+{
+	GENERATED_BODY()
+
+	/** Widgets created because the pool had none of the class */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Selection Widgets")
+	int32 Created = 0;
+
+	/** Binds served from the pool */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Selection Widgets")
+	int32 Reused = 0;
+
+	/** Widgets currently bound to an actor */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Selection Widgets")
+	int32 Active = 0;
+
+	/** Widgets parked for reuse */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Selection Widgets")
+	int32 Pooled = 0;
+
+	/** Actors of the current selection shown through the list instead of a widget each */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS Selection Widgets")
+	int32 ListedActors = 0;
+};
+
+USTRUCT()
+struct FRTSSelectionWidgetBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<URTS_Widget>> Widgets;
+};
+
+/**
+ * Selection and hover widgets, bound to actors only while they are selected or hovered.
+ * The selection code drives it through SetSelection and SetHoveredActor. Widgets are created per class on demand,
+ * shown in the viewport above their actor while bound and parked on deselect, so actors no longer carry one each.
+ * Actors that still have a UWidgetsComponent or otherwise hold a widget keep it and are skipped.
+ * Selections larger than MaxSelectionWidgets go to the registered URTS_SelectionListWidget instead,
+ * whose list view only builds entries for the rows on screen.
+ */
+UCLASS()
+class FINALRTS_API URTS_SelectionWidgetPool : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URTS_SelectionWidgetPool* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return BoundWidgets.Num() > 0; }
+
+	/** Replaces the current selection, binding and releasing widgets for the difference only */
+	UFUNCTION(BlueprintCallable, Category = "RTS Selection Widgets")
+	void SetSelection(const TArray<ARTS_Actor*>& Actors);
+
+	UFUNCTION(BlueprintCallable, Category = "RTS Selection Widgets")
+	void ClearSelection() { SetSelection({}); }
+
+	/** Null clears the hover */
+	UFUNCTION(BlueprintCallable, Category = "RTS Selection Widgets")
+	void SetHoveredActor(ARTS_Actor* Actor);
+
+	/**
+	 * Binds a widget to Actor and adds it to the viewport, reusing a parked one of the actor's widget class if there is one.
+	 * Returns null for pooled actors and actors that already hold a widget of their own.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "RTS Selection Widgets")
+	URTS_Widget* AcquireWidget(ARTS_Actor* Actor);
+
+	/** Unbinds the actor's widget, removes it from its parent and parks it */
+	UFUNCTION(BlueprintCallable, Category = "RTS Selection Widgets")
+	void ReleaseWidget(ARTS_Actor* Actor);
+
+	UFUNCTION(BlueprintPure, Category = "RTS Selection Widgets")
+	URTS_Widget* FindWidget(const ARTS_Actor* Actor) const;
+
+	UFUNCTION(BlueprintPure, Category = "RTS Selection Widgets")
+	bool IsSelected(const ARTS_Actor* Actor) const { return SelectedSet.Contains(Actor); }
+
+	/** The list view shown for large selections, registered by the widget itself */
+	void RegisterSelectionList(URTS_SelectionListWidget* List);
+	void UnregisterSelectionList(URTS_SelectionListWidget* List);
+
+	UFUNCTION(BlueprintPure, Category = "RTS Selection Widgets")
+	FRTSSelectionWidgetPoolStats GetStats() const;
+
+	void DumpStats() const;
+
+	/** Used for actors whose data asset has no SelectedWidgetClass */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTS Selection Widgets")
+	TSubclassOf<URTS_Widget> DefaultWidgetClass;
+
+	/** Selections up to this size get a widget per actor, larger ones are shown through the selection list */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTS Selection Widgets", meta = (ClampMin = "0"))
+	int32 MaxSelectionWidgets = 12;
+
+	/** Upper bound of parked widgets per class */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTS Selection Widgets", meta = (ClampMin = "0"))
+	int32 MaxPooledPerClass = 32;
+
+	/** World space offset from the top of the actor's bounds to the widget's anchor point */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTS Selection Widgets")
+	FVector WidgetWorldOffset = FVector(0.f, 0.f, 50.f);
+
+private:
+	TSubclassOf<URTS_Widget> GetWidgetClassFor(const ARTS_Actor* Actor) const;
+	bool WantsWidget(const ARTS_Actor* Actor) const;
+	void ParkWidget(URTS_Widget* Widget);
+
+	/** Moves every bound widget over its actor on screen, hiding the ones whose actor is off screen */
+	void UpdateWidgetPositions();
+	void RefreshSelectionList();
+
+	UPROPERTY()
+	TMap<TSubclassOf<URTS_Widget>, FRTSSelectionWidgetBucket> PooledWidgets;
+
+	/** Keeps bound widgets alive, BoundWidgets only indexes them */
+	UPROPERTY()
+	TArray<TObjectPtr<URTS_Widget>> ActiveWidgets;
+
+	TMap<TObjectKey<ARTS_Actor>, URTS_Widget*> BoundWidgets;
+
+	TArray<TWeakObjectPtr<ARTS_Actor>> SelectedActors;
+	TSet<TObjectKey<ARTS_Actor>> SelectedSet;
+	TWeakObjectPtr<ARTS_Actor> HoveredActor;
+	TWeakObjectPtr<URTS_SelectionListWidget> SelectionList;
+
+	FRTSSelectionWidgetPoolStats Stats;
+};
@@ -0,0 +1,117 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "RTS_StaticBuilding.h"
+#include "RTS_DataAsset.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectGlobals.h"
+
+ARTS_StaticBuilding::ARTS_StaticBuilding(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.DoNotCreateDefaultSubobject(ACharacter::MeshComponentName))
+{
+	// The movement component is a required subobject of ACharacter and cannot be skipped,
+	// keep it out of registration and ticking so it costs no more than the object itself
+	if (UCharacterMovementComponent* Movement = GetCharacterMovement())
+	{
+		Movement->bAutoRegister = false;
+		Movement->bAutoActivate = false;
+		Movement->PrimaryComponentTick.bCanEverTick = false;
+	}
+}
+
+namespace RTSStaticBuildingBenchmark
+{
+	struct FSpawnResult
+	{
+		double SpawnSeconds = 0.0;
+		double DestroySeconds = 0.0;
+		int32 Components = 0;
+		int32 Spawned = 0;
+	};
+
+	// Spawns Count actors of ActorClass on a grid, runs Initialize like a placed building would, then destroys them and collects garbage
+	static FSpawnResult Run(UWorld* World, TSubclassOf<ARTS_Actor> ActorClass, URTS_DataAsset* DataAsset, int32 Count)
+	{
+		FSpawnResult Result;
+		TArray<ARTS_Actor*> Actors;
+		Actors.Reserve(Count);
+
+		const int32 RowLength = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count))));
+		const double SpawnStart = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const FTransform Transform(FVector((Index % RowLength) * 1000.f, (Index / RowLength) * 1000.f, -100000.f));
+			ARTS_Actor* Actor = World->SpawnActorDeferred<ARTS_Actor>(ActorClass, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+			if (!Actor)
+			{
+				continue;
+			}
+
+			Actor->ActorDataAsset = DataAsset;
+			Actor->FinishSpawning(Transform);
+			Actor->Initialize();
+			Actors.Add(Actor);
+		}
+		Result.SpawnSeconds = FPlatformTime::Seconds() - SpawnStart;
+		Result.Spawned = Actors.Num();
+
+		for (const ARTS_Actor* Actor : Actors)
+		{
+			Result.Components += Actor->GetComponents().Num();
+		}
+
+		const double DestroyStart = FPlatformTime::Seconds();
+		for (ARTS_Actor* Actor : Actors)
+		{
+			Actor->Destroy();
+		}
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		Result.DestroySeconds = FPlatformTime::Seconds() - DestroyStart;
+
+		return Result;
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GBenchmarkRTSStaticBuildingCommand(
+	TEXT("RTS.Benchmark.SpawnBuildings"),
+	TEXT("Spawns buildings as ARTS_Actor and as ARTS_StaticBuilding and logs spawn, destroy+GC time and component counts. Usage: RTS.Benchmark.SpawnBuildings <DataAssetPath> [Count=1000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || Args.Num() < 1)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RTS.Benchmark.SpawnBuildings - Usage: RTS.Benchmark.SpawnBuildings <DataAssetPath> [Count=1000]"));
+			return;
+		}
+
+		URTS_DataAsset* DataAsset = LoadObject<URTS_DataAsset>(nullptr, *Args[0]);
+		if (!DataAsset)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RTS.Benchmark.SpawnBuildings - Could not load data asset %s"), *Args[0]);
+			return;
+		}
+		if (DataAsset->HasMovementModule())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RTS.Benchmark.SpawnBuildings - %s has a movement module, it is not a building"), *DataAsset->GetName());
+			return;
+		}
+
+		const int32 Count = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1000;
+
+		const TPair<const TCHAR*, TSubclassOf<ARTS_Actor>> Cases[] = {
+			{ TEXT("ARTS_Actor"), ARTS_Actor::StaticClass() },
+			{ TEXT("ARTS_StaticBuilding"), ARTS_StaticBuilding::StaticClass() }
+		};
+
+		UE_LOG(LogTemp, Log, TEXT("RTS.Benchmark.SpawnBuildings - %d x %s"), Count, *DataAsset->GetName());
+		for (const TPair<const TCHAR*, TSubclassOf<ARTS_Actor>>& Case : Cases)
+		{
+			const RTSStaticBuildingBenchmark::FSpawnResult Result = RTSStaticBuildingBenchmark::Run(World, Case.Value, DataAsset, Count);
+			UE_LOG(LogTemp, Log, TEXT("  %-20s: spawn+init %.2f ms (%.1f us each), destroy+GC %.2f ms, %.1f components each"),
+				Case.Key,
+				Result.SpawnSeconds * 1e3,
+				Result.Spawned > 0 ? Result.SpawnSeconds * 1e6 / Result.Spawned : 0.0,
+				Result.DestroySeconds * 1e3,
+				Result.Spawned > 0 ? static_cast<double>(Result.Components) / Result.Spawned : 0.0);
+		}
+	}));
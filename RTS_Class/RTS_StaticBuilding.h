@@ -0,0 +1,19 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "RTS_Actor.h"
+#include "RTS_StaticBuilding.generated.h"
+
+/**
+ * ARTS_Actor variant for data assets without a movement module.
+ * Skips the character skeletal mesh at construction and never registers the character movement component,
+ * so buildings no longer pay for components SetupAsStaticBuilding would destroy right after spawning.
+ */
+UCLASS()
+class DRAKTHYSPROJECT_API ARTS_StaticBuilding : public ARTS_Actor
+{
+	GENERATED_BODY()
+
+public:
+	ARTS_StaticBuilding(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+};
@@ -0,0 +1,50 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "RTS_Stats.h"
+
+DEFINE_STAT(STAT_RTS_ActorInitialize);
+DEFINE_STAT(STAT_RTS_InitializeModules);
+DEFINE_STAT(STAT_RTS_SchedulerTick);
+DEFINE_STAT(STAT_RTS_GathererExecute);
+DEFINE_STAT(STAT_RTS_GathererMoveTo);
+DEFINE_STAT(STAT_RTS_GathererMovementCompleted);
+DEFINE_STAT(STAT_RTS_GatherMethodGather);
+DEFINE_STAT(STAT_RTS_GatherStart);
+DEFINE_STAT(STAT_RTS_GatherComplete);
+DEFINE_STAT(STAT_RTS_MovementQueueTick);
+DEFINE_STAT(STAT_RTS_LedgerCommit);
+DEFINE_STAT(STAT_RTS_HarvestResolve);
+DEFINE_STAT(STAT_RTS_EconomyLOD);
+DEFINE_STAT(STAT_RTS_GathererMassProcessor);
+DEFINE_STAT(STAT_RTS_EconomySnapshotCapture);
+DEFINE_STAT(STAT_RTS_EconomySnapshotBranch);
+DEFINE_STAT(STAT_RTS_RetaskScheduler);
+DEFINE_STAT(STAT_RTS_Deposit);
+DEFINE_STAT(STAT_RTS_DepositComplete);
+DEFINE_STAT(STAT_RTS_RecruitmentEnable);
+DEFINE_STAT(STAT_RTS_RecruitmentProcess);
+DEFINE_STAT(STAT_RTS_RecruitmentSpawn);
+DEFINE_STAT(STAT_RTS_ExperienceAdd);
+
+DEFINE_STAT(STAT_RTS_ModulesInitialized);
+DEFINE_STAT(STAT_RTS_SchedulerCallbacks);
+DEFINE_STAT(STAT_RTS_GatherStarts);
+DEFINE_STAT(STAT_RTS_GatherCompletions);
+DEFINE_STAT(STAT_RTS_Deposits);
+DEFINE_STAT(STAT_RTS_MoveRequests);
+DEFINE_STAT(STAT_RTS_UnitsSpawned);
+DEFINE_STAT(STAT_RTS_PathsComputed);
+DEFINE_STAT(STAT_RTS_PathCacheHits);
+DEFINE_STAT(STAT_RTS_PathCacheMisses);
+DEFINE_STAT(STAT_RTS_UIEventsDelivered);
+DEFINE_STAT(STAT_RTS_UIEventsSkipped);
+DEFINE_STAT(STAT_RTS_LedgerPlayerCommits);
+
+DEFINE_STAT(STAT_RTS_MovementQueueDepth);
+DEFINE_STAT(STAT_RTS_PathQueriesInFlight);
+DEFINE_STAT(STAT_RTS_FastForwardedGatherers);
+DEFINE_STAT(STAT_RTS_IdleGatherers);
+DEFINE_STAT(STAT_RTS_PathLatencyMs);
+
+#if RTS_MODULES_TRACE_ENABLED
+UE_TRACE_CHANNEL_DEFINE(RTSModulesChannel);
+#endif
@@ -0,0 +1,76 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+/**
+ * Stats and Insights instrumentation of the RTS module framework.
+ * `stat RTSModules` shows per-function cycle counts and per-frame call counters,
+ * `-trace=cpu,RTSModules` records the module lifecycle scopes on their own channel.
+ * Both compile out in Shipping: STATS is off there and RTS_MODULES_TRACE_ENABLED is 0.
+ */
+DECLARE_STATS_GROUP(TEXT("RTSModules"), STATGROUP_RTSModules, STATCAT_Advanced);
+
+// Cycle stats
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Actor Initialize"), STAT_RTS_ActorInitialize, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Actor InitializeModules"), STAT_RTS_InitializeModules, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Scheduler Tick"), STAT_RTS_SchedulerTick, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gatherer Execute"), STAT_RTS_GathererExecute, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gatherer MoveToLocation"), STAT_RTS_GathererMoveTo, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gatherer MovementCompleted"), STAT_RTS_GathererMovementCompleted, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GatherMethod Gather"), STAT_RTS_GatherMethodGather, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GatherMethod StartGathering"), STAT_RTS_GatherStart, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GatherMethod CompleteGathering"), STAT_RTS_GatherComplete, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gatherer Movement Queue Tick"), STAT_RTS_MovementQueueTick, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Resource Ledger Commit"), STAT_RTS_LedgerCommit, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Harvest Resolve"), STAT_RTS_HarvestResolve, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gatherer Economy LOD"), STAT_RTS_EconomyLOD, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gatherer Mass Processor"), STAT_RTS_GathererMassProcessor, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Economy Snapshot Capture"), STAT_RTS_EconomySnapshotCapture, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Economy Snapshot Branch"), STAT_RTS_EconomySnapshotBranch, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gatherer Retask Scheduler"), STAT_RTS_RetaskScheduler, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DepositMethod Deposit"), STAT_RTS_Deposit, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DepositMethod CompleteDepositing"), STAT_RTS_DepositComplete, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Recruitment EnableProduction"), STAT_RTS_RecruitmentEnable, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Recruitment ProcessQueue"), STAT_RTS_RecruitmentProcess, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Recruitment SpawnUnit"), STAT_RTS_RecruitmentSpawn, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Experience AddExperience"), STAT_RTS_ExperienceAdd, STATGROUP_RTSModules, FINALRTS_API);
+
+// Per-frame call counters
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Modules Initialized"), STAT_RTS_ModulesInitialized, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scheduler Callbacks"), STAT_RTS_SchedulerCallbacks, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Gather Starts"), STAT_RTS_GatherStarts, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Gather Completions"), STAT_RTS_GatherCompletions, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deposits"), STAT_RTS_Deposits, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Move Requests"), STAT_RTS_MoveRequests, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Units Spawned"), STAT_RTS_UnitsSpawned, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Paths Computed"), STAT_RTS_PathsComputed, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Cache Hits"), STAT_RTS_PathCacheHits, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Cache Misses"), STAT_RTS_PathCacheMisses, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("UI Events Delivered"), STAT_RTS_UIEventsDelivered, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("UI Events Skipped"), STAT_RTS_UIEventsSkipped, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ledger Player Commits"), STAT_RTS_LedgerPlayerCommits, STATGROUP_RTSModules, FINALRTS_API);
+
+// Gauges, set once per frame by their owner
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Movement Queue Depth"), STAT_RTS_MovementQueueDepth, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Path Queries In Flight"), STAT_RTS_PathQueriesInFlight, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Fast-Forwarded Gatherers"), STAT_RTS_FastForwardedGatherers, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Idle Gatherers"), STAT_RTS_IdleGatherers, STATGROUP_RTSModules, FINALRTS_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Path Latency (ms)"), STAT_RTS_PathLatencyMs, STATGROUP_RTSModules, FINALRTS_API);
+
+#define RTS_MODULES_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+#if RTS_MODULES_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(RTSModulesChannel, FINALRTS_API);
+#define RTS_MODULES_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, RTSModulesChannel)
+#else
+#define RTS_MODULES_TRACE_SCOPE(Name)
+#endif
+
+/** Cycle stat plus an Insights scope of the same name on the RTSModules channel */
+#define RTS_MODULE_SCOPE(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	RTS_MODULES_TRACE_SCOPE(#Stat)
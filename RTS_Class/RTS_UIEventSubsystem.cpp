@@ -0,0 +1,255 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "RTS_UIEventSubsystem.h"
+#include "RTS_Actor.h"
+#include "RTS_Module.h"
+#include "RTS_Widget.h"
+#include "RTS_Stats.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld GDumpRTSUIEventsCommand(
+	TEXT("RTS.UI.DumpEvents"),
+	TEXT("Logs delivered and skipped UI event counters."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const URTS_UIEventSubsystem* UIEvents = URTS_UIEventSubsystem::Get(World))
+		{
+			UIEvents->DumpStats();
+		}
+	}));
+
+URTS_UIEventSubsystem* URTS_UIEventSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<URTS_UIEventSubsystem>() : nullptr;
+}
+
+void URTS_UIEventSubsystem::PostEvent(const ARTS_Actor* Actor, ERTSUIEvent Event)
+{
+	if (URTS_UIEventSubsystem* UIEvents = Actor ? Get(Actor) : nullptr)
+	{
+		UIEvents->Post(Actor, Event);
+	}
+}
+
+void URTS_UIEventSubsystem::Deinitialize()
+{
+	Subscriptions.Empty();
+	DirtyActors.Empty();
+	HiddenWidgetEvents.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId URTS_UIEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URTS_UIEventSubsystem, STATGROUP_Tickables);
+}
+
+void URTS_UIEventSubsystem::Subscribe(URTS_Widget* Widget, ARTS_Actor* Actor)
+{
+	if (!Widget || !Actor)
+	{
+		return;
+	}
+
+	FSubscription& Subscription = Subscriptions.FindOrAdd(Actor);
+	Subscription.Actor = Actor;
+	Subscription.Widgets.AddUnique(Widget);
+}
+
+void URTS_UIEventSubsystem::Unsubscribe(URTS_Widget* Widget, ARTS_Actor* Actor)
+{
+	FSubscription* Subscription = Subscriptions.Find(Actor);
+	if (!Subscription)
+	{
+		return;
+	}
+
+	Subscription->Widgets.RemoveSingleSwap(Widget, EAllowShrinking::No);
+	if (Subscription->Widgets.Num() == 0)
+	{
+		Subscriptions.Remove(Actor);
+	}
+}
+
+void URTS_UIEventSubsystem::UnsubscribeAll(URTS_Widget* Widget)
+{
+	HiddenWidgetEvents.Remove(Widget);
+
+	for (auto It = Subscriptions.CreateIterator(); It; ++It)
+	{
+		It->Value.Widgets.RemoveSingleSwap(Widget, EAllowShrinking::No);
+		if (It->Value.Widgets.Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void URTS_UIEventSubsystem::Post(const ARTS_Actor* Actor, ERTSUIEvent Event)
+{
+	FSubscription* Subscription = Subscriptions.Find(Actor);
+	if (!Subscription)
+	{
+		Stats.SkippedNoSubscriber++;
+		INC_DWORD_STAT(STAT_RTS_UIEventsSkipped);
+		return;
+	}
+
+	const uint32 EventBit = 1u << static_cast<uint32>(Event);
+	if (Subscription->PendingEvents & EventBit)
+	{
+		Stats.Coalesced++;
+		return;
+	}
+
+	if (Subscription->PendingEvents == 0)
+	{
+		DirtyActors.Add(Actor);
+	}
+	Subscription->PendingEvents |= EventBit;
+}
+
+void URTS_UIEventSubsystem::Tick(float DeltaTime)
+{
+	FlushShownWidgets();
+	PostProgressEvents();
+	Flush();
+}
+
+void URTS_UIEventSubsystem::PostProgressEvents()
+{
+	// Only watched actors are polled, an unwatched worker never costs anything here
+	for (const TPair<TObjectKey<ARTS_Actor>, FSubscription>& Pair : Subscriptions)
+	{
+		const ARTS_Actor* Actor = Pair.Value.Actor.Get();
+		if (!Actor)
+		{
+			continue;
+		}
+
+		for (const TPair<FGameplayTag, TObjectPtr<URTS_Module>>& ModulePair : Actor->Modules)
+		{
+			if (ModulePair.Value && ModulePair.Value->HasActiveProgress())
+			{
+				Post(Actor, ERTSUIEvent::ProgressChanged);
+				break;
+			}
+		}
+	}
+}
+
+void URTS_UIEventSubsystem::Flush()
+{
+	if (DirtyActors.Num() == 0)
+	{
+		return;
+	}
+
+	// Widgets may subscribe or post from their handlers, those land in the next frame
+	TArray<TObjectKey<ARTS_Actor>> ActorsToFlush = MoveTemp(DirtyActors);
+	DirtyActors.Reset();
+
+	for (const TObjectKey<ARTS_Actor>& ActorKey : ActorsToFlush)
+	{
+		FSubscription* Subscription = Subscriptions.Find(ActorKey);
+		if (!Subscription)
+		{
+			continue;
+		}
+
+		const uint32 PendingEvents = Subscription->PendingEvents;
+		Subscription->PendingEvents = 0;
+
+		TArray<URTS_Widget*, TInlineAllocator<2>> Widgets;
+		for (const TWeakObjectPtr<URTS_Widget>& Widget : Subscription->Widgets)
+		{
+			if (Widget.IsValid())
+			{
+				Widgets.Add(Widget.Get());
+			}
+		}
+		if (Widgets.Num() == 0)
+		{
+			Subscriptions.Remove(ActorKey);
+			continue;
+		}
+
+		for (uint32 EventIndex = 0; EventIndex < static_cast<uint32>(ERTSUIEvent::Count); ++EventIndex)
+		{
+			if (!(PendingEvents & (1u << EventIndex)))
+			{
+				continue;
+			}
+
+			for (URTS_Widget* Widget : Widgets)
+			{
+				if (!Widget->IsVisible())
+				{
+					HiddenWidgetEvents.FindOrAdd(Widget) |= 1u << EventIndex;
+					Stats.SkippedHidden++;
+					INC_DWORD_STAT(STAT_RTS_UIEventsSkipped);
+					continue;
+				}
+
+				Stats.Delivered++;
+				INC_DWORD_STAT(STAT_RTS_UIEventsDelivered);
+				Widget->HandleUIEvent(static_cast<ERTSUIEvent>(EventIndex));
+			}
+		}
+	}
+}
+
+void URTS_UIEventSubsystem::FlushShownWidgets()
+{
+	if (HiddenWidgetEvents.Num() == 0)
+	{
+		return;
+	}
+
+	// Handlers may hide widgets again or unsubscribe, collect first
+	TArray<TPair<URTS_Widget*, uint32>, TInlineAllocator<8>> Shown;
+	for (auto It = HiddenWidgetEvents.CreateIterator(); It; ++It)
+	{
+		URTS_Widget* Widget = It->Key.Get();
+		if (!Widget)
+		{
+			It.RemoveCurrent();
+		}
+		else if (Widget->IsVisible())
+		{
+			Shown.Emplace(Widget, It->Value);
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const TPair<URTS_Widget*, uint32>& Pair : Shown)
+	{
+		for (uint32 EventIndex = 0; EventIndex < static_cast<uint32>(ERTSUIEvent::Count); ++EventIndex)
+		{
+			if (Pair.Value & (1u << EventIndex))
+			{
+				Stats.Delivered++;
+				INC_DWORD_STAT(STAT_RTS_UIEventsDelivered);
+				Pair.Key->HandleUIEvent(static_cast<ERTSUIEvent>(EventIndex));
+			}
+		}
+	}
+}
+
+FRTSUIEventStats URTS_UIEventSubsystem::GetStats() const
+{
+	FRTSUIEventStats Result = Stats;
+	Result.SubscribedActors = Subscriptions.Num();
+	return Result;
+}
+
+void URTS_UIEventSubsystem::DumpStats() const
+{
+	const FRTSUIEventStats Current = GetStats();
+	const int64 Skipped = Current.SkippedNoSubscriber + Current.SkippedHidden;
+	UE_LOG(LogTemp, Log, TEXT("URTS_UIEventSubsystem - %d subscribed actors, delivered %lld, skipped %lld (no subscriber %lld, hidden %lld), coalesced %lld"),
+		Current.SubscribedActors, Current.Delivered, Skipped, Current.SkippedNoSubscriber, Current.SkippedHidden, Current.Coalesced);
+}
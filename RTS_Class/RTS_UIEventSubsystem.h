@@ -0,0 +1,115 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RTS_UIEventSubsystem.generated.h"
+
+class ARTS_Actor;
+class URTS_Widget;
+
+/** What changed on an actor, widgets read the new values from the actor's modules themselves */
+UENUM(BlueprintType)
+enum class ERTSUIEvent : uint8
+{
+	/** Sent every frame while one of the actor's modules reports HasActiveProgress() */
+	ProgressChanged,
+	GatheringStateChanged,
+	CarriedResourcesChanged,
+	ProductionQueueChanged,
+	ExperienceChanged,
+	Count UMETA(Hidden)
+};
+
+USTRUCT(BlueprintType)
+struct FRTSUIEventStats
+{
+	GENERATED_BODY()
+
+	/** Events handed to a visible widget */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS UI Events")
+	int64 Delivered = 0;
+
+	/** Events posted for actors nobody watches, dropped before any work */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS UI Events")
+	int64 SkippedNoSubscriber = 0;
+
+	/** Events only hidden widgets would have received, held back until they are shown */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS UI Events")
+	int64 SkippedHidden = 0;
+
+	/** Events merged into one already pending for the same actor this frame */
+	UPROPERTY(BlueprintReadOnly, Category = "RTS UI Events")
+	int64 Coalesced = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "RTS UI Events")
+	int32 SubscribedActors = 0;
+};
+
+/**
+ * Per-frame UI event layer between modules and URTS_Widgets.
+ * Widgets subscribe to the actors they display. Modules post events, which cost one map lookup for actors
+ * without subscribers; for the rest every event kind is delivered at most once per frame per actor, and only to
+ * visible widgets. Hidden widgets keep the kinds they missed and get them once on the frame they are shown again.
+ * Progress bars are fed by ProgressChanged while any module of the actor reports progress,
+ * so modules no longer need their own progress tickers for UI.
+ */
+UCLASS()
+class FINALRTS_API URTS_UIEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URTS_UIEventSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Shorthand for modules, does nothing when the actor has no subscribers */
+	static void PostEvent(const ARTS_Actor* Actor, ERTSUIEvent Event);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	UFUNCTION(BlueprintCallable, Category = "RTS UI Events")
+	void Subscribe(URTS_Widget* Widget, ARTS_Actor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category = "RTS UI Events")
+	void Unsubscribe(URTS_Widget* Widget, ARTS_Actor* Actor);
+
+	/** Removes the widget from every actor it watches */
+	UFUNCTION(BlueprintCallable, Category = "RTS UI Events")
+	void UnsubscribeAll(URTS_Widget* Widget);
+
+	UFUNCTION(BlueprintPure, Category = "RTS UI Events")
+	bool HasSubscribers(const ARTS_Actor* Actor) const { return Subscriptions.Contains(Actor); }
+
+	void Post(const ARTS_Actor* Actor, ERTSUIEvent Event);
+
+	UFUNCTION(BlueprintPure, Category = "RTS UI Events")
+	FRTSUIEventStats GetStats() const;
+
+	void DumpStats() const;
+
+private:
+	struct FSubscription
+	{
+		TWeakObjectPtr<ARTS_Actor> Actor;
+		TArray<TWeakObjectPtr<URTS_Widget>, TInlineAllocator<2>> Widgets;
+		uint32 PendingEvents = 0;
+	};
+
+	void PostProgressEvents();
+	void Flush();
+
+	/** Delivers what hidden widgets missed to those visible again */
+	void FlushShownWidgets();
+
+	TMap<TObjectKey<ARTS_Actor>, FSubscription> Subscriptions;
+
+	/** Actors with pending events this frame, each listed once */
+	TArray<TObjectKey<ARTS_Actor>> DirtyActors;
+
+	/** Event kinds held back per hidden widget, coalesced like pending events */
+	TMap<TWeakObjectPtr<URTS_Widget>, uint32> HiddenWidgetEvents;
+
+	FRTSUIEventStats Stats;
+};
@@ -0,0 +1,9 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "RTS_UnitActor.h"
+
+ARTS_UnitActor::ARTS_UnitActor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer
+		.DoNotCreateDefaultSubobject(ARTS_Actor::NavigationBoxName)
+		.DoNotCreateDefaultSubobject(ARTS_Actor::PlacementBoxName))
+{
+}
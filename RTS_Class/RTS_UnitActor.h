@@ -0,0 +1,18 @@
+// Copyright AmberleafCotton 2025. All Rights Reserved.
+#pragma once
+
+#include "RTS_Actor.h"
+#include "RTS_UnitActor.generated.h"
+
+/**
+ * ARTS_Actor variant for data assets with a movement module.
+ * Skips the navigation and placement boxes at construction instead of destroying them in SetupAsCharacter.
+ */
+UCLASS()
+class DRAKTHYSPROJECT_API ARTS_UnitActor : public ARTS_Actor
+{
+	GENERATED_BODY()
+
+public:
+	ARTS_UnitActor(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+};
@@ -1,12 +1,32 @@
-﻿#include "RTS_Widget.h"
-
-void URTS_Widget::InitializeWidget_Implementation(ARTS_Actor* InOwner)
-{
-	Owner = InOwner;
-}
-
-ARTS_Actor* URTS_Widget::GetModuleOwner() const
-{
-	return Owner;
-}
-
+﻿#include "RTS_Widget.h"
+
+void URTS_Widget::InitializeWidget_Implementation(ARTS_Actor* InOwner)
+{
+	if (URTS_UIEventSubsystem* UIEvents = URTS_UIEventSubsystem::Get(this))
+	{
+		// Re-initialized widgets follow their new owner
+		UIEvents->UnsubscribeAll(this);
+		if (bSubscribeToOwnerEvents && InOwner)
+		{
+			UIEvents->Subscribe(this, InOwner);
+		}
+	}
+
+	Owner = InOwner;
+}
+
+void URTS_Widget::NativeDestruct()
+{
+	if (URTS_UIEventSubsystem* UIEvents = URTS_UIEventSubsystem::Get(this))
+	{
+		UIEvents->UnsubscribeAll(this);
+	}
+
+	Super::NativeDestruct();
+}
+
+ARTS_Actor* URTS_Widget::GetModuleOwner() const
+{
+	return Owner;
+}
+
@@ -1,111 +1,220 @@
-﻿// Copyright AmberleafCotton 2025. All Rights Reserved.
-#include "RecruitmentModule.h"
-#include "RTS_Actor.h"
-#include "Kismet/GameplayStatics.h"
-
-URecruitmentModule::URecruitmentModule()
-{
-}
-
-void URecruitmentModule::InitializeModule_Implementation(ARTS_Actor* InOwner)
-{
-	Super::InitializeModule_Implementation(InOwner);
-}
-
-void URecruitmentModule::AddUnitToProduction(UUnitDataAsset* UnitData)
-{
-	if (!UnitData) return;
-
-	UnitProductionQueue.Add(UnitData);
-
-	if (GetWorld()->GetTimerManager().IsTimerActive(ProductionTimerHandle))
-	{
-		OnProductionQueueUpdated.Broadcast(UnitProductionQueue);
-	}
-	else
-	{
-		EnableProduction();
-	}
-}
-
-void URecruitmentModule::EnableProduction()
-{
-	if (!GetWorld()) return;
-
-	GetWorld()->GetTimerManager().SetTimer(
-		ProductionTimerHandle,
-		this,
-		&URecruitmentModule::ProcessProductionQueue,
-		ProductionTimerGranularity,
-		true
-	);
-}
-
-void URecruitmentModule::ProcessProductionQueue()
-{
-	if (!bIsProducingUnit)
-	{
-		if (UnitProductionQueue.Num() > 0 && UnitProductionQueue.IsValidIndex(0))
-		{
-			UnitBeingProduced = UnitProductionQueue[0];
-			ProductionTimeNeeded = UnitBeingProduced->ProductionData.ProductionTime;
-			ProductionTimeSpent = 0.0f;
-			ProductionProgress = 0.0f;
-			bIsProducingUnit = true;
-		}
-		return;
-	}
-
-	ProductionTimeSpent += ProductionTimerGranularity;
-	ProductionProgress = ProductionTimeSpent / ProductionTimeNeeded;
-
-	OnProductionProgressUpdated.Broadcast(ProductionProgress);
-
-	if (ProductionProgress >= 1.0f)
-	{
-		SpawnUnit();
-
-		ProductionTimeSpent = 0.0f;
-		ProductionProgress = 0.0f;
-
-		UnitProductionQueue.RemoveAt(0);
-		OnProductionQueueUpdated.Broadcast(UnitProductionQueue);
-
-		bIsProducingUnit = false;
-		UnitBeingProduced = nullptr;
-
-		if (UnitProductionQueue.Num() <= 0)
-		{
-			GetWorld()->GetTimerManager().ClearTimer(ProductionTimerHandle);
-			OnProductionProgressUpdated.Broadcast(ProductionProgress);
-			OnProductionQueueUpdated.Broadcast(UnitProductionQueue);
-		}
-	}
-}
-
-void URecruitmentModule::SpawnUnit_Implementation()
-{
-	if (!UnitBeingProduced || !Owner || !UnitBeingProduced->UnitClass) return;
-
-	FVector SpawnLocation = Owner->GetActorLocation();
-	FRotator SpawnRotation = FRotator::ZeroRotator;
-
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.Owner = Owner;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	AActor* DeferredUnit = GetWorld()->SpawnActorDeferred<AActor>(
-		UnitBeingProduced->UnitClass,
-		FTransform(SpawnRotation, SpawnLocation),
-		Owner,
-		nullptr,
-		ESpawnActorCollisionHandlingMethod::AlwaysSpawn
-	);
-
-	if (!DeferredUnit) return;
-
-	// Placeholder for unit/team initialization before finishing spawn
-	// e.g., IInitializableUnitInterface::Execute_Initialize(DeferredUnit, TeamID);
-
-	DeferredUnit->FinishSpawning(FTransform(SpawnRotation, SpawnLocation));
-}
+﻿// Copyright AmberleafCotton 2025. All Rights Reserved.
+#include "RecruitmentModule.h"
+#include "RTS_Stats.h"
+#include "RTS_Actor.h"
+#include "Kismet/GameplayStatics.h"
+#include "RTS_ModuleScheduler.h"
+#include "RTS_ActorPool.h"
+#include "RTS_UIEventSubsystem.h"
+#include "EconomyCore/Production.h"
+
+URecruitmentModule::URecruitmentModule()
+{
+}
+
+void URecruitmentModule::InitializeModule_Implementation(ARTS_Actor* InOwner)
+{
+	Super::InitializeModule_Implementation(InOwner);
+}
+
+void URecruitmentModule::ResetModule_Implementation()
+{
+	Super::ResetModule_Implementation();
+
+	if (URTS_ModuleScheduler* Scheduler = URTS_ModuleScheduler::Get(this))
+	{
+		Scheduler->Cancel(ProductionTimerHandle);
+		Scheduler->Cancel(ProductionProgressTimerHandle);
+	}
+
+	UnitProductionQueue.Reset();
+	UnitBeingProduced = nullptr;
+	bIsProducingUnit = false;
+	ProductionStartTime = -1.0;
+	ProductionTimeNeeded = 0.0f;
+}
+
+void URecruitmentModule::GetSharedArchetypeProperties(TArray<FName>& OutPropertyNames) const
+{
+	// Read through GetUnitsForProduction
+	OutPropertyNames.Add(GET_MEMBER_NAME_CHECKED(URecruitmentModule, UnitsForProduction));
+}
+
+TArray<UUnitDataAsset*> URecruitmentModule::GetUnitsForProduction() const
+{
+	const URecruitmentModule* Config = GetArchetype<URecruitmentModule>();
+	return Config ? Config->UnitsForProduction : UnitsForProduction;
+}
+
+void URecruitmentModule::AddUnitToProduction(UUnitDataAsset* UnitData)
+{
+	if (!UnitData) return;
+
+	UnitProductionQueue.Add(UnitData);
+	NotifyProductionQueueChanged();
+
+	if (!bIsProducingUnit)
+	{
+		EnableProduction();
+	}
+}
+
+void URecruitmentModule::EnableProduction()
+{
+	RTS_MODULE_SCOPE(STAT_RTS_RecruitmentEnable);
+
+	URTS_ModuleScheduler* Scheduler = URTS_ModuleScheduler::Get(this);
+	if (!Scheduler || bIsProducingUnit || !UnitProductionQueue.IsValidIndex(0)) return;
+
+	UnitBeingProduced = UnitProductionQueue[0];
+	ProductionTimeNeeded = UnitBeingProduced->ProductionData.ProductionTime;
+	ProductionStartTime = GetWorld()->GetTimeSeconds();
+	bIsProducingUnit = true;
+
+	// One completion event per unit, progress is derived from the start timestamp
+	Scheduler->ScheduleUObject(
+		ProductionTimerHandle,
+		this,
+		&URecruitmentModule::ProcessProductionQueue,
+		ProductionTimeNeeded
+	);
+
+	if (bBroadcastProductionProgress)
+	{
+		Scheduler->ScheduleUObject(
+			ProductionProgressTimerHandle,
+			this,
+			&URecruitmentModule::BroadcastProductionProgress,
+			ProductionTimerGranularity,
+			true
+		);
+	}
+}
+
+void URecruitmentModule::ProcessProductionQueue()
+{
+	RTS_MODULE_SCOPE(STAT_RTS_RecruitmentProcess);
+
+	if (!bIsProducingUnit) return;
+
+	if (URTS_ModuleScheduler* Scheduler = URTS_ModuleScheduler::Get(this))
+	{
+		Scheduler->Cancel(ProductionProgressTimerHandle);
+	}
+
+	SpawnUnit();
+
+	UnitProductionQueue.RemoveAt(0);
+	NotifyProductionQueueChanged();
+
+	bIsProducingUnit = false;
+	UnitBeingProduced = nullptr;
+	ProductionStartTime = -1.0;
+
+	if (UnitProductionQueue.Num() <= 0)
+	{
+		OnProductionProgressUpdated.Broadcast(0.0f);
+		return;
+	}
+
+	EnableProduction();
+}
+
+void URecruitmentModule::NotifyProductionQueueChanged()
+{
+	// The dynamic delegate copies the whole queue into a TArray<UUnitDataAsset*>, skip that when nobody listens
+	if (OnProductionQueueUpdated.IsBound())
+	{
+		OnProductionQueueUpdated.Broadcast(UnitProductionQueue);
+	}
+	URTS_UIEventSubsystem::PostEvent(Owner, ERTSUIEvent::ProductionQueueChanged);
+}
+
+void URecruitmentModule::BroadcastProductionProgress()
+{
+	OnProductionProgressUpdated.Broadcast(GetProductionProgress());
+}
+
+void URecruitmentModule::SetBroadcastProductionProgress(bool bEnabled)
+{
+	bBroadcastProductionProgress = bEnabled;
+
+	URTS_ModuleScheduler* Scheduler = URTS_ModuleScheduler::Get(this);
+	if (!Scheduler) return;
+
+	if (bEnabled && bIsProducingUnit && !Scheduler->IsScheduled(ProductionProgressTimerHandle))
+	{
+		Scheduler->ScheduleUObject(ProductionProgressTimerHandle, this, &URecruitmentModule::BroadcastProductionProgress, ProductionTimerGranularity, true);
+	}
+	else if (!bEnabled)
+	{
+		Scheduler->Cancel(ProductionProgressTimerHandle);
+	}
+}
+
+float URecruitmentModule::GetProductionTimeSpent() const
+{
+	if (!bIsProducingUnit || !GetWorld()) return 0.0f;
+
+	return RTSEconomy::GetProductionTimeSpent(GetProductionState(), GetWorld()->GetTimeSeconds());
+}
+
+float URecruitmentModule::GetProductionProgress() const
+{
+	if (!bIsProducingUnit || !GetWorld()) return 0.0f;
+
+	return RTSEconomy::GetProductionProgress(GetProductionState(), GetWorld()->GetTimeSeconds());
+}
+
+RTSEconomy::FProductionState URecruitmentModule::GetProductionState() const
+{
+	RTSEconomy::FProductionState State;
+	State.StartTime = ProductionStartTime;
+	State.TimeNeeded = ProductionTimeNeeded;
+	State.bProducing = bIsProducingUnit;
+	return State;
+}
+
+void URecruitmentModule::SpawnUnit_Implementation()
+{
+	RTS_MODULE_SCOPE(STAT_RTS_RecruitmentSpawn);
+
+	if (!UnitBeingProduced || !Owner || !UnitBeingProduced->UnitClass) return;
+
+	INC_DWORD_STAT(STAT_RTS_UnitsSpawned);
+
+	FVector SpawnLocation = Owner->GetActorLocation();
+	FRotator SpawnRotation = FRotator::ZeroRotator;
+
+	// RTS units are served by the actor pool, keyed by the data asset on the unit class defaults
+	UClass* UnitClass = UnitBeingProduced->UnitClass;
+	if (UnitClass->IsChildOf(ARTS_Actor::StaticClass()))
+	{
+		const ARTS_Actor* UnitDefaults = GetDefault<ARTS_Actor>(UnitClass);
+		URTS_ActorPool* Pool = URTS_ActorPool::Get(this);
+		if (Pool && UnitDefaults->ActorDataAsset)
+		{
+			Pool->AcquireActor(UnitClass, UnitDefaults->ActorDataAsset, FTransform(SpawnRotation, SpawnLocation), Owner);
+			return;
+		}
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = Owner;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* DeferredUnit = GetWorld()->SpawnActorDeferred<AActor>(
+		UnitBeingProduced->UnitClass,
+		FTransform(SpawnRotation, SpawnLocation),
+		Owner,
+		nullptr,
+		ESpawnActorCollisionHandlingMethod::AlwaysSpawn
+	);
+
+	if (!DeferredUnit) return;
+
+	// Placeholder for unit/team initialization before finishing spawn
+	// e.g., IInitializableUnitInterface::Execute_Initialize(DeferredUnit, TeamID);
+
+	DeferredUnit->FinishSpawning(FTransform(SpawnRotation, SpawnLocation));
+}
@@ -1,29 +1,45 @@
-﻿// Copyright 2025 AmberleafCotton. All rights reserved.
-#include "TeamComponent.h"
-
-UTeamComponent::UTeamComponent()
-{
-	PrimaryComponentTick.bCanEverTick = false;
-}
-
-bool UTeamComponent::IsOwned(const UTeamComponent* OtherTeamComponent) const
-{
-	return OtherTeamComponent && OwningPlayerState == OtherTeamComponent->OwningPlayerState;
-}
-
-bool UTeamComponent::IsEnemy(const UTeamComponent* OtherTeamComponent) const
-{
-	return OtherTeamComponent &&
-		TeamSettings.TeamIndex != 0 && TeamSettings.TeamIndex != OtherTeamComponent->TeamSettings.TeamIndex;
-}
-
-bool UTeamComponent::IsAlly(const UTeamComponent* OtherTeamComponent) const
-{
-	return OtherTeamComponent &&
-		TeamSettings.TeamIndex == OtherTeamComponent->TeamSettings.TeamIndex;
-}
-
-bool UTeamComponent::IsNeutral() const
-{
-	return TeamSettings.TeamIndex == 0;
-}
+﻿// Copyright 2025 AmberleafCotton. All rights reserved.
+#include "TeamComponent.h"
+#include "RTS_Actor.h"
+#include "DepositModule/DepositModule.h"
+
+UTeamComponent::UTeamComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UTeamComponent::SetTeamSettings(const FTeamSettings& NewTeamSettings)
+{
+	TeamSettings = NewTeamSettings;
+
+	// Drop-off buildings live in per-team deposit fields, move them to the new team's field
+	if (const ARTS_Actor* RTSOwner = Cast<ARTS_Actor>(GetOwner()))
+	{
+		if (UDepositModule* DepositModule = RTSOwner->GetModule<UDepositModule>())
+		{
+			DepositModule->RefreshRegistration();
+		}
+	}
+}
+
+bool UTeamComponent::IsOwned(const UTeamComponent* OtherTeamComponent) const
+{
+	return OtherTeamComponent && OwningPlayerState == OtherTeamComponent->OwningPlayerState;
+}
+
+bool UTeamComponent::IsEnemy(const UTeamComponent* OtherTeamComponent) const
+{
+	return OtherTeamComponent &&
+		TeamSettings.TeamIndex != 0 && TeamSettings.TeamIndex != OtherTeamComponent->TeamSettings.TeamIndex;
+}
+
+bool UTeamComponent::IsAlly(const UTeamComponent* OtherTeamComponent) const
+{
+	return OtherTeamComponent &&
+		TeamSettings.TeamIndex == OtherTeamComponent->TeamSettings.TeamIndex;
+}
+
+bool UTeamComponent::IsNeutral() const
+{
+	return TeamSettings.TeamIndex == 0;
+}